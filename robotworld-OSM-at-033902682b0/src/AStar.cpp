@@ -60,15 +60,25 @@ namespace PathAlgorithm
 		static const int xOffset[] = { 0, 1, 1, 1, 0, -1, -1, -1 };
 		static const int yOffset[] = { 1, 1, 0, -1, -1, -1, 0, 1 };
 
-		const std::vector< Model::WallPtr >& walls = Model::RobotWorld::getRobotWorld().getWalls();
+		Model::WorldSnapshotPtr world = Model::RobotWorld::getRobotWorld().getSnapshot();
+		const std::vector< Model::WallPtr >& walls = *world->walls;
 		std::vector< Vertex > neighbours;
 
+		// The other robot is the same for all neighbours
+		Model::Robot* andereRobot = nullptr;
+		if (world->getRobot( "Peer") && !ignoreRobot)
+		{
+			andereRobot = isLocal ? world->getRobot( "Peer").get() : Model::RobotWorld::getRobotWorld().getLocalRobot().get();
+		}
+		// The other robot may be stepped at the same time, only its published state is consistent
+		wxPoint anderePosition = andereRobot ? andereRobot->getState().position : wxPoint();
+
 		for (int i = 0; i < 8; ++i)
 		{
 			bool addToNeigbours = true;
 
 			Vertex vertex( aVertex.x + xOffset[i], aVertex.y + yOffset[i]);
-			for (Model::WallPtr wall : walls)
+			for (const Model::WallPtr& wall : walls)
 			{
 				if (Utils::Shape2DUtils::isOnLine( wall->getPoint1(), wall->getPoint2(), vertex.asPoint(), static_cast<int>(aFreeRadius * 1.25)))
 				{
@@ -76,19 +86,11 @@ namespace PathAlgorithm
 					break;
 				}
 			}
-			std::shared_ptr<Model::Robot> andereRobot = Model::RobotWorld::getRobotWorld().getRobot("Peer");
-			if (andereRobot && !ignoreRobot)
+			if (andereRobot)
 			{
-				if (isLocal)
-				{
-					andereRobot = Model::RobotWorld::getRobotWorld().getRobot("Peer");
-				} else
-				{
-					andereRobot = Model::RobotWorld::getRobotWorld().getLocalRobot();
-				}
 				if (Utils::Shape2DUtils::isOnLine(
-						andereRobot->getPosition(),
-						andereRobot->getPosition() + wxPoint(1, 1),
+						anderePosition,
+						anderePosition + wxPoint(1, 1),
 					vertex.asPoint(), aFreeRadius + static_cast<unsigned int>(std::max(aRobotSize.GetWidth(), aRobotSize.GetHeight()) * 1.33)
 				))
 				{
@@ -164,6 +166,7 @@ namespace PathAlgorithm
 			{
 //				clock_t end = std::clock();
 //				std::cout << "Duration: " << static_cast<double>(end - start)/CLOCKS_PER_SEC <<	", openSet: " << openSet.size() <<  ", closedSet: " << closedSet.size() << ", predecessorMap: " << predecessorMap.size() << std::endl;
+				std::atomic_store( &openSetSnapshot, std::make_shared< const OpenSet >( openSet));
 				return ConstructPath( predecessorMap, current);
 			} else
 			{
@@ -275,6 +278,7 @@ namespace PathAlgorithm
 		}
 
 		std::cerr << "**** No route from " << aStart << " to " << aGoal << std::endl;
+		std::atomic_store( &openSetSnapshot, std::make_shared< const OpenSet >( openSet));
 		return Path();
 	}
 	/**
@@ -283,7 +287,7 @@ namespace PathAlgorithm
 	void AStar::addToOpenSet( const Vertex& aVertex)
 	{
 		openSet.push_back( aVertex);
-		notifyObservers();
+		notifyObservers( Base::Notification::PathChanged);
 	}
 	/**
 	 *
@@ -299,7 +303,7 @@ namespace PathAlgorithm
 	void AStar::removeFromOpenSet( OpenSet::iterator& i)
 	{
 		openSet.erase( i);
-		notifyObservers();
+		notifyObservers( Base::Notification::PathChanged);
 	}
 	/**
 	 *
@@ -340,7 +344,7 @@ namespace PathAlgorithm
 	void AStar::addToClosedSet( const Vertex& aVertex)
 	{
 		closedSet.insert( aVertex);
-		notifyObservers();
+		notifyObservers( Base::Notification::PathChanged);
 	}
 	/**
 	 *
@@ -356,7 +360,7 @@ namespace PathAlgorithm
 	void AStar::removeFromClosedSet( ClosedSet::iterator& i)
 	{
 		closedSet.erase( i);
-		notifyObservers();
+		notifyObservers( Base::Notification::PathChanged);
 	}
 	/**
 	 *
@@ -392,6 +396,13 @@ namespace PathAlgorithm
 	{
 		return openSet;
 	}
+	/**
+	 *
+	 */
+	OpenSetPtr AStar::getOpenSetSnapshot() const
+	{
+		return std::atomic_load( &openSetSnapshot);
+	}
 	/**
 	 *
 	 */
@@ -8,6 +8,7 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
@@ -200,6 +201,11 @@ namespace PathAlgorithm
 	typedef std::vector< Vertex > OpenSet;
 	typedef std::set< Vertex, VertexLessIdCompare > ClosedSet;
 	typedef std::map< Vertex, Vertex, VertexLessIdCompare > VertexMap;
+	/**
+	 * Immutable snapshots that are shared with readers in other threads
+	 */
+	typedef std::shared_ptr< const Path > PathPtr;
+	typedef std::shared_ptr< const OpenSet > OpenSetPtr;
 	/**
 	 *
 	 */
@@ -272,6 +278,13 @@ namespace PathAlgorithm
 			 *
 			 */
 			OpenSet getOpenSet() const;
+			/**
+			 * The open set is published at the end of each search, the snapshot can be read by other threads while
+			 * the next search is running.
+			 *
+			 * @return the open set at the end of the last search, never nullptr
+			 */
+			OpenSetPtr getOpenSetSnapshot() const;
 			/**
 			 *
 			 */
@@ -316,6 +329,10 @@ namespace PathAlgorithm
 			 *
 			 */
 			VertexMap predecessorMap;
+			/**
+			 *
+			 */
+			OpenSetPtr openSetSnapshot = std::make_shared< const OpenSet >();
 	}; // class AStar
 } // namespace PathAlgorithm
 #endif // ASTAR_HPP_
@@ -0,0 +1,355 @@
+#include "Benchmark.hpp"
+
+#include "MainApplication.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Simulation.hpp"
+#include "TaskScheduler.hpp"
+#include "Wall.hpp"
+#include "WorldBuilder.hpp"
+#include "WorldFile.hpp"
+#include "WorldTextFile.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace Application
+{
+	namespace
+	{
+		/**
+		 *
+		 */
+		unsigned long getNumberArgument(	const std::string& anArgument,
+											unsigned long aDefault)
+		{
+			if (MainApplication::isArgGiven( anArgument))
+			{
+				return std::stoul( MainApplication::getArg( anArgument).value);
+			}
+			return aDefault;
+		}
+	} // namespace
+
+	/**
+	 *
+	 */
+	/* static */int Benchmark::run( const std::string& aName)
+	{
+		if (aName == "scheduler")
+		{
+			runScheduler();
+			return 0;
+		}
+		if (aName == "lookup")
+		{
+			runLookup();
+			return 0;
+		}
+		if (aName == "build")
+		{
+			runBuild();
+			return 0;
+		}
+		if (aName == "worldfile")
+		{
+			runWorldFile();
+			return 0;
+		}
+		std::cerr << "Unknown benchmark: " << aName << std::endl;
+		return 1;
+	}
+	/**
+	 *
+	 */
+	/* static */void Benchmark::runScheduler()
+	{
+		unsigned long numberOfRobots = std::max( getNumberArgument( "-robots", 16), 2UL);
+		unsigned long numberOfTicks = getNumberArgument( "-ticks", 50);
+		unsigned int maxThreads = Model::Simulation::getThreadsArgument();
+
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		robotWorld.populate( 4, false);
+		robotWorld.newRobot( "Peer", wxPoint( 90, 60), false);
+		robotWorld.newGoal( "PeerGoal", wxPoint( 450, 440), false);
+		for (unsigned long i = 2; i < numberOfRobots; ++i)
+		{
+			robotWorld.newRobot( "Robot " + std::to_string( i), wxPoint(), false);
+		}
+
+		std::vector< wxPoint > startPositions;
+		for (unsigned long i = 0; i < numberOfRobots; ++i)
+		{
+			startPositions.push_back( wxPoint( 50 + 40 * static_cast< int >( i % 8), 60 + 40 * static_cast< int >( i / 8)));
+		}
+
+		std::cout << "Stepping " << numberOfRobots << " robots for " << numberOfTicks << " ticks" << std::endl;
+		std::cout << std::setw( 8) << "threads" << std::setw( 12) << "ms" << std::setw( 10) << "speedup" << std::setw( 15) << "deterministic" << std::endl;
+
+		std::vector< unsigned int > threadCounts;
+		for (unsigned int threads = 1; threads < maxThreads; threads *= 2)
+		{
+			threadCounts.push_back( threads);
+		}
+		threadCounts.push_back( std::max( maxThreads, 1U));
+
+		double singleThreadDuration = 0.0;
+		std::vector< wxPoint > singleThreadPositions;
+		for (unsigned int threads : threadCounts)
+		{
+			Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
+			const std::vector< Model::RobotPtr >& robots = *world->robots;
+			for (std::size_t i = 0; i < robots.size(); ++i)
+			{
+				robots[i]->stopActing();
+				robots[i]->setPosition( startPositions[i], false);
+				robots[i]->startActing();
+			}
+
+			Base::TaskScheduler scheduler( threads);
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			Model::Simulation::startRobots( scheduler);
+			for (unsigned long tick = 0; tick < numberOfTicks; ++tick)
+			{
+				Model::Simulation::stepRobots( scheduler);
+			}
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			double duration = std::chrono::duration< double, std::milli >( end - start).count();
+
+			std::vector< wxPoint > positions;
+			for (const Model::RobotPtr& robot : robots)
+			{
+				positions.push_back( robot->getPosition());
+			}
+			if (threads == 1)
+			{
+				singleThreadDuration = duration;
+				singleThreadPositions = positions;
+			}
+
+			std::cout << std::setw( 8) << threads << std::setw( 12) << std::fixed << std::setprecision( 1) << duration << std::setw( 10)
+			        << std::setprecision( 2) << singleThreadDuration / duration << std::setw( 15) << (positions == singleThreadPositions ? "yes" : "no") << std::endl;
+		}
+
+		Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
+		for (const Model::RobotPtr& robot : *world->robots)
+		{
+			robot->stopActing();
+		}
+	}
+	/**
+	 *
+	 */
+	/* static */void Benchmark::runLookup()
+	{
+		unsigned long numberOfEntities = std::max( getNumberArgument( "-entities", 10000), 1UL);
+		unsigned long numberOfLookups = std::max( getNumberArgument( "-lookups", 1000), 1UL);
+
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		{
+			Model::RobotWorld::Batch batch( robotWorld);
+			for (unsigned long i = 0; i < numberOfEntities; ++i)
+			{
+				robotWorld.newRobot( "Robot " + std::to_string( i), wxPoint(), false);
+			}
+		}
+		Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
+		const std::vector< Model::RobotPtr >& robots = *world->robots;
+
+		// The same random robots for every kind of lookup
+		std::mt19937 generator( 42);
+		std::uniform_int_distribution< std::size_t > distribution( 0, robots.size() - 1);
+		std::vector< std::string > names;
+		std::vector< Base::ObjectId > objectIds;
+		for (unsigned long i = 0; i < numberOfLookups; ++i)
+		{
+			const Model::RobotPtr& robot = robots[distribution( generator)];
+			names.push_back( robot->getName());
+			objectIds.push_back( robot->getObjectId());
+		}
+
+		std::cout << "Looking up " << numberOfLookups << " of " << robots.size() << " robots" << std::endl;
+		std::cout << std::setw( 20) << "lookup" << std::setw( 14) << "ns/lookup" << std::endl;
+
+		auto measure = [numberOfLookups](	const std::string& aLookup,
+											const std::function< bool( unsigned long) >& aFunction)
+		{
+			unsigned long found = 0;
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (unsigned long i = 0; i < numberOfLookups; ++i)
+			{
+				found += aFunction( i) ? 1 : 0;
+			}
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			double duration = std::chrono::duration< double, std::nano >( end - start).count();
+
+			std::cout << std::setw( 20) << aLookup << std::setw( 14) << std::fixed << std::setprecision( 1) << duration / numberOfLookups;
+			if (found != numberOfLookups)
+			{
+				std::cout << "  (" << numberOfLookups - found << " not found)";
+			}
+			std::cout << std::endl;
+		};
+
+		measure( "linear name", [&robots, &names](unsigned long i)
+		{
+			return std::find_if( robots.begin(), robots.end(), [&names, i](const Model::RobotPtr& robot)
+			{
+				return robot->getName() == names[i];
+			}) != robots.end();
+		});
+		measure( "hashed name", [&robotWorld, &names](unsigned long i)
+		{
+			return robotWorld.getRobot( names[i]) != nullptr;
+		});
+		measure( "linear ObjectId", [&robots, &objectIds](unsigned long i)
+		{
+			return std::find_if( robots.begin(), robots.end(), [&objectIds, i](const Model::RobotPtr& robot)
+			{
+				return robot->getObjectId() == objectIds[i];
+			}) != robots.end();
+		});
+		measure( "hashed ObjectId", [&robotWorld, &objectIds](unsigned long i)
+		{
+			return robotWorld.getRobot( objectIds[i]) != nullptr;
+		});
+	}
+	/**
+	 *
+	 */
+	/* static */void Benchmark::runBuild()
+	{
+		unsigned long numberOfWalls = std::max( getNumberArgument( "-walls", 20000), 1UL);
+
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		robotWorld.getLocalRobot();
+
+		// A grid of short walls
+		auto wallPoints = [](unsigned long i)
+		{
+			int x = static_cast< int >( i % 200) * 10;
+			int y = static_cast< int >( i / 200) * 10;
+			return std::make_pair( wxPoint( x, y), wxPoint( x + 5, y + 5));
+		};
+
+		std::cout << "Adding " << numberOfWalls << " walls" << std::endl;
+		std::cout << std::setw( 12) << "method" << std::setw( 12) << "ms" << std::endl;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		{
+			// Without the batch every wall would publish a copy of all walls
+			Model::RobotWorld::Batch batch( robotWorld);
+			for (unsigned long i = 0; i < numberOfWalls; ++i)
+			{
+				std::pair< wxPoint, wxPoint > points = wallPoints( i);
+				robotWorld.newWall( points.first, points.second, false);
+			}
+		}
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		std::cout << std::setw( 12) << "newWall" << std::setw( 12) << std::fixed << std::setprecision( 1) << std::chrono::duration< double, std::milli >( end - start).count() << std::endl;
+
+		robotWorld.unpopulate( false);
+
+		start = std::chrono::steady_clock::now();
+		Model::WorldBuilder worldBuilder;
+		worldBuilder.reserve( 0, 0, 0, numberOfWalls);
+		for (unsigned long i = 0; i < numberOfWalls; ++i)
+		{
+			std::pair< wxPoint, wxPoint > points = wallPoints( i);
+			worldBuilder.addWall( points.first, points.second);
+		}
+		worldBuilder.commit( false);
+		end = std::chrono::steady_clock::now();
+		std::cout << std::setw( 12) << "WorldBuilder" << std::setw( 12) << std::fixed << std::setprecision( 1) << std::chrono::duration< double, std::milli >( end - start).count() << std::endl;
+
+		// Dragging a wall publishes a snapshot per move, which only copies the blocks of the wall index it changes
+		const unsigned long numberOfMoves = 1000;
+		Model::WallPtr wall = robotWorld.getSnapshot()->walls->front();
+		start = std::chrono::steady_clock::now();
+		for (unsigned long i = 0; i < numberOfMoves; ++i)
+		{
+			wall->setPoint2( wxPoint( 5 + static_cast< int >( i % 50), 5 + static_cast< int >( i % 50)), false);
+		}
+		end = std::chrono::steady_clock::now();
+		std::cout << std::setw( 12) << "move/1000" << std::setw( 12) << std::fixed << std::setprecision( 1) << std::chrono::duration< double, std::milli >( end - start).count() << std::endl;
+
+		robotWorld.unpopulate( false);
+	}
+	/**
+	 *
+	 */
+	/* static */void Benchmark::runWorldFile()
+	{
+		unsigned long numberOfWalls = getNumberArgument( "-walls", 100000);
+		std::string fileName = (std::filesystem::temp_directory_path() / "robotworld-benchmark.rww").string();
+		std::string textFileName = (std::filesystem::temp_directory_path() / "robotworld-benchmark.txt").string();
+
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		robotWorld.getLocalRobot();
+
+		Model::WorldBuilder worldBuilder;
+		worldBuilder.reserve( 0, 0, 0, numberOfWalls);
+		for (unsigned long i = 0; i < numberOfWalls; ++i)
+		{
+			int x = static_cast< int >( i % 500) * 10;
+			int y = static_cast< int >( i / 500) * 10;
+			worldBuilder.addWall( wxPoint( x, y), wxPoint( x + 5, y + 5));
+		}
+		worldBuilder.commit( false);
+
+		std::cout << "World file with " << numberOfWalls << " walls" << std::endl;
+		std::cout << std::setw( 12) << "step" << std::setw( 12) << "ms" << std::endl;
+
+		auto measure = [](	const std::string& aStep,
+							const std::function< void() >& aFunction)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			aFunction();
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			std::cout << std::setw( 12) << aStep << std::setw( 12) << std::fixed << std::setprecision( 1) << std::chrono::duration< double, std::milli >( end - start).count() << std::endl;
+		};
+
+		measure( "save", [&fileName]
+		{
+			Model::WorldFile::save( fileName);
+		});
+		robotWorld.unpopulate( false);
+		measure( "map", [&fileName]
+		{
+			Model::WorldFile worldFile( fileName);
+		});
+		measure( "load", [&fileName]
+		{
+			Model::WorldFile::load( fileName, false);
+		});
+		if (robotWorld.getWalls()->size() != numberOfWalls)
+		{
+			std::cout << "Loaded " << robotWorld.getWalls()->size() << " walls instead of " << numberOfWalls << std::endl;
+		}
+
+		measure( "text save", [&textFileName]
+		{
+			Model::WorldTextFile::save( textFileName);
+		});
+		measure( "text load", [&textFileName]
+		{
+			Model::WorldTextFile::load( textFileName, false);
+		});
+		if (robotWorld.getWalls()->size() != numberOfWalls)
+		{
+			std::cout << "Loaded " << robotWorld.getWalls()->size() << " walls instead of " << numberOfWalls << " from text" << std::endl;
+		}
+
+		robotWorld.unpopulate( false);
+		std::remove( fileName.c_str());
+		std::remove( textFileName.c_str());
+	}
+} // namespace Application
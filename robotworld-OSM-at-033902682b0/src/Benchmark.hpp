@@ -0,0 +1,47 @@
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+#include "Config.hpp"
+
+#include <string>
+
+namespace Application
+{
+	/**
+	 * Benchmarks that run instead of the GUI if the command line argument -benchmark=name is given.
+	 * The results are written to std::cout.
+	 */
+	class Benchmark
+	{
+		public:
+			/**
+			 *
+			 * @param aName The name of the benchmark as given with -benchmark
+			 * @return 0 on success, 1 if there is no benchmark with aName
+			 */
+			static int run( const std::string& aName);
+			/**
+			 * Steps a world with -robots=number robots (default 16) for -ticks=number ticks (default 50) with
+			 * 1, 2, 4, ... up to -threads=number threads (default the number of cores) and reports the speedup.
+			 */
+			static void runScheduler();
+			/**
+			 * Fills the world with -entities=number robots (default 10000) and compares -lookups=number (default 1000)
+			 * lookups by name and by ObjectId through a linear search with the hash indexes of the world.
+			 */
+			static void runLookup();
+			/**
+			 * Adds -walls=number walls (default 20000) to an empty world one by one with RobotWorld::newWall and
+			 * with a WorldBuilder and compares the durations, then measures 1000 moves of a wall.
+			 */
+			static void runBuild();
+			/**
+			 * Saves a world with -walls=number walls (default 100000) to a binary and a text world file in the
+			 * temporary directory and measures how long saving and loading them takes.
+			 */
+			static void runWorldFile();
+	};
+	//	class Benchmark
+} // namespace Application
+
+#endif // BENCHMARK_HPP_
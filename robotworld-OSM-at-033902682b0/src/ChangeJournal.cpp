@@ -0,0 +1,86 @@
+#include "ChangeJournal.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace Model
+{
+	/**
+	 *
+	 */
+	ChangeJournal::ChangeJournal( std::size_t aCapacity /*= 4096*/) :
+								capacity( std::max( aCapacity, static_cast< std::size_t >( 1))),
+								lastSequence( 0),
+								lastDroppedSequence( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	std::uint64_t ChangeJournal::record(	Change::Type aType,
+											Change::Entity anEntity,
+											const Base::ObjectId& anObjectId)
+	{
+		std::unique_lock< std::mutex > lock( journalMutex);
+
+		++lastSequence;
+		auto lastMove = lastMoves.find( anObjectId);
+		if (lastMove != lastMoves.end())
+		{
+			if (aType == Change::EntityMoved)
+			{
+				// An observer that saw the previous move sees the merged move as a new change
+				changes.splice( changes.end(), changes, lastMove->second);
+				lastMove->second->sequence = lastSequence;
+				return lastSequence;
+			}
+			lastMoves.erase( lastMove);
+		}
+
+		if (changes.size() == capacity)
+		{
+			lastDroppedSequence = changes.front().sequence;
+			auto oldestMove = lastMoves.find( changes.front().objectId);
+			if (oldestMove != lastMoves.end() && oldestMove->second == changes.begin())
+			{
+				lastMoves.erase( oldestMove);
+			}
+			changes.pop_front();
+		}
+		changes.push_back( Change{ lastSequence, aType, anEntity, anObjectId});
+		if (aType == Change::EntityMoved)
+		{
+			lastMoves.emplace( anObjectId, std::prev( changes.end()));
+		}
+		return lastSequence;
+	}
+	/**
+	 *
+	 */
+	std::uint64_t ChangeJournal::getLastSequence() const
+	{
+		std::unique_lock< std::mutex > lock( journalMutex);
+		return lastSequence;
+	}
+	/**
+	 *
+	 */
+	bool ChangeJournal::getChangesSince(	std::uint64_t aSequence,
+											std::vector< Change >& aChanges) const
+	{
+		std::unique_lock< std::mutex > lock( journalMutex);
+
+		if (aSequence < lastDroppedSequence)
+		{
+			return false;
+		}
+		// The sequence numbers are increasing so the new changes are at the back, only those are visited
+		auto first = changes.end();
+		while (first != changes.begin() && std::prev( first)->sequence > aSequence)
+		{
+			--first;
+		}
+		aChanges.insert( aChanges.end(), first, changes.end());
+		return true;
+	}
+} // namespace Model
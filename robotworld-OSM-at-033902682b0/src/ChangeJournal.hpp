@@ -0,0 +1,104 @@
+#ifndef CHANGEJOURNAL_HPP_
+#define CHANGEJOURNAL_HPP_
+
+#include "Config.hpp"
+
+#include "ObjectId.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Model
+{
+	/**
+	 * A change of the world as recorded in the ChangeJournal
+	 */
+	struct Change
+	{
+			enum Type
+			{
+				EntityAdded,
+				EntityRemoved,
+				EntityMoved
+			};
+			enum Entity
+			{
+				RobotEntity,
+				WayPointEntity,
+				GoalEntity,
+				WallEntity
+			};
+
+			std::uint64_t sequence;
+			Type type;
+			Entity entity;
+			Base::ObjectId objectId;
+	};
+
+	/**
+	 * The journal of the changes of the world. Every change gets the next sequence number. An observer remembers the
+	 * sequence number of the last change it handled and asks for the changes since that number, so the cost of
+	 * catching up is proportional to what changed instead of to the size of the world.
+	 *
+	 * The journal keeps the last aCapacity changes. An observer that falls further behind is told so and should
+	 * synchronise with the whole world, e.g. through RobotWorld::getSnapshot.
+	 *
+	 * The moves of an object are merged into one change with the sequence number of the last move, so an object that
+	 * moves every tick takes one change instead of filling the journal. A move is only merged with a move after the
+	 * last addition or removal of the object.
+	 */
+	class ChangeJournal
+	{
+		public:
+			/**
+			 *
+			 * @param aCapacity The maximum number of changes that are kept
+			 */
+			explicit ChangeJournal( std::size_t aCapacity = 4096);
+			/**
+			 * Appends a change
+			 *
+			 * @return the sequence number of the change
+			 */
+			std::uint64_t record(	Change::Type aType,
+									Change::Entity anEntity,
+									const Base::ObjectId& anObjectId);
+			/**
+			 *
+			 * @return the sequence number of the last change, 0 if there were no changes
+			 */
+			std::uint64_t getLastSequence() const;
+			/**
+			 * Appends the changes with a sequence number greater than aSequence to aChanges, oldest first
+			 *
+			 * @return false if some of these changes are no longer in the journal, aChanges is not changed in that case
+			 */
+			bool getChangesSince(	std::uint64_t aSequence,
+									std::vector< Change >& aChanges) const;
+
+		private:
+			std::size_t capacity;
+			std::uint64_t lastSequence;
+			/**
+			 * The sequence number of the oldest change that was dropped, 0 if no change was dropped
+			 */
+			std::uint64_t lastDroppedSequence;
+			/**
+			 * Ordered by sequence number, a merged move is moved to the back
+			 */
+			std::list< Change > changes;
+			/**
+			 * The last move of each object that is still in changes and may be merged with the next move
+			 */
+			std::unordered_map< Base::ObjectId, std::list< Change >::iterator > lastMoves;
+
+			mutable std::mutex journalMutex;
+	};
+	//	class ChangeJournal
+} // namespace Model
+
+#endif // CHANGEJOURNAL_HPP_
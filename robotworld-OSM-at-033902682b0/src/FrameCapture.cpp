@@ -0,0 +1,202 @@
+#include "FrameCapture.hpp"
+
+#include "Goal.hpp"
+#include "GoalShape.hpp"
+#include "MainApplication.hpp"
+#include "RectangleShape.hpp"
+#include "Replay.hpp"
+#include "Robot.hpp"
+#include "RobotShape.hpp"
+#include "RobotWorld.hpp"
+#include "Simulation.hpp"
+#include "SoftwareRenderer.hpp"
+#include "TaskScheduler.hpp"
+#include "Wall.hpp"
+#include "WallShape.hpp"
+#include "WayPoint.hpp"
+#include "WayPointShape.hpp"
+#include "WorldFile.hpp"
+#include "WorldTextFile.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace Application
+{
+	namespace
+	{
+		/**
+		 *
+		 */
+		unsigned long getNumberArgument(	const std::string& anArgument,
+											unsigned long aDefault)
+		{
+			if (MainApplication::isArgGiven( anArgument))
+			{
+				return std::stoul( MainApplication::getArg( anArgument).value);
+			}
+			return aDefault;
+		}
+		/**
+		 * The shapes of the walls, goals and waypoints in the order of the RobotWorldCanvas
+		 */
+		std::vector< View::ShapePtr > createStaticShapes()
+		{
+			std::vector< View::ShapePtr > shapes;
+
+			Model::WorldSnapshotPtr world = Model::RobotWorld::getRobotWorld().getSnapshot();
+			for (const Model::WayPointPtr& wayPoint : *world->wayPoints)
+			{
+				shapes.push_back( std::make_shared< View::WayPointShape >( wayPoint));
+			}
+			for (const Model::GoalPtr& goal : *world->goals)
+			{
+				shapes.push_back( std::make_shared< View::GoalShape >( goal));
+			}
+			for (const Model::WallPtr& wall : *world->walls)
+			{
+				std::shared_ptr< View::WallShape > wallShape = std::make_shared< View::WallShape >( wall);
+				View::RectangleShapePtr start = std::make_shared< View::RectangleShape >( wall->getPoint1());
+				View::RectangleShapePtr end = std::make_shared< View::RectangleShape >( wall->getPoint2());
+				wallShape->setNode1( start);
+				wallShape->setNode2( end);
+
+				shapes.push_back( start);
+				shapes.push_back( end);
+				shapes.push_back( wallShape);
+			}
+			return shapes;
+		}
+		/**
+		 *
+		 */
+		void writeFrame(	const View::SoftwareRenderer& aFrame,
+							const std::string& aDirectory,
+							unsigned long aFrameNumber)
+		{
+			std::ostringstream fileName;
+			fileName << "frame" << std::setw( 6) << std::setfill( '0') << aFrameNumber << ".ppm";
+
+			std::filesystem::path path = std::filesystem::path( aDirectory) / fileName.str();
+			std::ofstream file( path, std::ios::binary);
+			file << aFrame.asPpm();
+			if (!file)
+			{
+				throw std::runtime_error( "Cannot write " + path.string());
+			}
+		}
+	} // namespace
+
+	/**
+	 *
+	 */
+	/* static */int FrameCapture::run( const std::string& aDirectory)
+	{
+		std::filesystem::create_directories( aDirectory);
+
+		if (MainApplication::isArgGiven( "-world"))
+		{
+			const std::string& fileName = MainApplication::getArg( "-world").value;
+			if (Model::WorldFile::isWorldFile( fileName))
+			{
+				Model::WorldFile::load( fileName);
+			} else
+			{
+				Model::WorldTextFile::load( fileName);
+			}
+		}
+
+		int width = static_cast< int >( getNumberArgument( "-capture_width", 1024));
+		int height = static_cast< int >( getNumberArgument( "-capture_height", 768));
+		unsigned long numberOfFrames = getNumberArgument( "-frames", 100);
+
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		Model::Replay& replay = Model::Replay::getReplay();
+		bool replaying = MainApplication::isArgGiven( "-replay");
+		if (replaying)
+		{
+			replay.open( MainApplication::getArg( "-replay").value);
+			replay.seek( getNumberArgument( "-replaystart", 0));
+			replay.apply();
+		} else
+		{
+			Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
+			for (const Model::RobotPtr& robot : *world->robots)
+			{
+				robot->startActing();
+			}
+		}
+
+		// The walls, goals and waypoints do not move, they are drawn once
+		std::vector< View::ShapePtr > staticShapes = createStaticShapes();
+		View::SoftwareRenderer background( width, height);
+		background.clear( View::Colour( "WHITE"));
+		for (const View::ShapePtr& shape : staticShapes)
+		{
+			shape->draw( background);
+		}
+
+		// The robot shapes are kept because they cache their path
+		std::unordered_map< Base::ObjectId, View::ShapePtr > robotShapes;
+		Base::TaskScheduler scheduler( Model::Simulation::getThreadsArgument());
+
+		unsigned long frameNumber = 0;
+		for (; frameNumber < numberOfFrames; ++frameNumber)
+		{
+			if (frameNumber > 0)
+			{
+				if (replaying)
+				{
+					if (!replay.next())
+					{
+						break;
+					}
+					replay.apply();
+				} else
+				{
+					Model::Simulation::startRobots( scheduler);
+					Model::Simulation::stepRobots( scheduler);
+				}
+			}
+
+			View::SoftwareRenderer frame = background;
+			Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
+			for (const Model::RobotPtr& robot : *world->robots)
+			{
+				View::ShapePtr& shape = robotShapes[robot->getObjectId()];
+				if (!shape)
+				{
+					shape = std::make_shared< View::RobotShape >( robot);
+				}
+				shape->draw( frame);
+			}
+			writeFrame( frame, aDirectory, frameNumber);
+		}
+
+		if (!replaying)
+		{
+			Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
+			for (const Model::RobotPtr& robot : *world->robots)
+			{
+				robot->stopActing();
+			}
+		}
+		for (const View::ShapePtr& shape : staticShapes)
+		{
+			shape->stopObserving();
+		}
+		for (const std::unordered_map< Base::ObjectId, View::ShapePtr >::value_type& robotShape : robotShapes)
+		{
+			robotShape.second->stopObserving();
+		}
+
+		std::cout << "Captured " << frameNumber << " frames of " << width << "x" << height << " in " << aDirectory << std::endl;
+		return 0;
+	}
+} // namespace Application
@@ -0,0 +1,35 @@
+#ifndef FRAMECAPTURE_HPP_
+#define FRAMECAPTURE_HPP_
+
+#include "Config.hpp"
+
+#include <string>
+
+namespace Application
+{
+	/**
+	 * Draws the world in PPM images without the GUI if the command line argument -capture=directory is given,
+	 * e.g. on a machine without a display.
+	 *
+	 * The world is loaded with -world=file. Without -replay the robots are started and the simulation is stepped
+	 * in lockstep, one frame per tick. With -replay=file the frames are the ticks of the recording from
+	 * -replaystart=tick on. -frames=number (default 100) limits the number of frames, -capture_width=pixels and
+	 * -capture_height=pixels (default 1024 by 768) give the size of the frames.
+	 *
+	 * The frames are written as directory/frame000000.ppm, directory/frame000001.ppm etc. and can be turned
+	 * into a video with e.g. ffmpeg -i frame%06d.ppm video.mp4
+	 */
+	class FrameCapture
+	{
+		public:
+			/**
+			 *
+			 * @param aDirectory The directory the frames are written to, it is created if it does not exist
+			 * @return 0 on success
+			 */
+			static int run( const std::string& aDirectory);
+	};
+	//	class FrameCapture
+} // namespace Application
+
+#endif // FRAMECAPTURE_HPP_
@@ -37,6 +37,13 @@ namespace Model
 			 *
 			 */
 			virtual ~Goal() = default;
+			/**
+			 *
+			 */
+			virtual Change::Entity getEntity() const override
+			{
+				return Change::GoalEntity;
+			}
 			/**
 			 * @name Debug functions
 			 */
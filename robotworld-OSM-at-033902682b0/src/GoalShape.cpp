@@ -31,7 +31,7 @@ namespace View
 	/**
 	 *
 	 */
-	void GoalShape::handleNotification()
+	void GoalShape::handleNotification( const Base::Notification& UNUSEDPARAM(aNotification))
 	{
 	}
 	/**
@@ -36,21 +36,21 @@ namespace View
 			/**
 			 *
 			 */
-			virtual wxColour getNormalColour() const override
+			virtual Colour getNormalColour() const override
 			{
 				return "GREEN";
 			}
 			/**
 			 *
 			 */
-			virtual wxColour getSelectionColour() const override
+			virtual Colour getSelectionColour() const override
 			{
 				return "BLUE";
 			}
 			/**
 			 *
 			 */
-			virtual wxColour getActivationColour() const override
+			virtual Colour getActivationColour() const override
 			{
 				return "BLACK";
 			}
@@ -63,7 +63,7 @@ namespace View
 			 * A Notifier will call this function if this Observer will handle the notifications of that
 			 * Notifier. It is the responsibility of the Observer to filter any events it is interested in.
 			 */
-			virtual void handleNotification() override;
+			virtual void handleNotification( const Base::Notification& aNotification) override;
 			//@}
 			/**
 			 * @name Debug functions
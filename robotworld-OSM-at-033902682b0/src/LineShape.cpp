@@ -20,6 +20,7 @@ namespace View
 					node1( aNode1),
 					node2( aNode2),
 					title( aTitle),
+					titleSize( 0, 0),
 					lineWidth( aLineWidth),
 					arrowHeadSize( anArrowHeadSize),
 					top(),
@@ -40,6 +41,7 @@ namespace View
 					node1( aNode1),
 					node2( aNode2),
 					title( aTitle),
+					titleSize( 0, 0),
 					lineWidth( aLineWidth),
 					arrowHeadSize( anArrowHeadSize),
 					top(),
@@ -50,24 +52,21 @@ namespace View
 	/**
 	 *
 	 */
-	void LineShape::draw( wxDC& dc)
+	void LineShape::draw( Renderer& renderer)
 	{
 		if (isSelected())
 		{
-			dc.SetPen( wxPen(  "RED", lineWidth, wxPENSTYLE_SOLID));
+			renderer.setPen( "RED", lineWidth);
 		} else
 		{
-			dc.SetPen( wxPen(  "BLACK", lineWidth, wxPENSTYLE_SOLID));
+			renderer.setPen( "BLACK", lineWidth);
 		}
 
-		dc.DrawLine( node1->getCentre().x,
-					 node1->getCentre().y,
-					 node2->getCentre().x,
-					 node2->getCentre().y);
+		renderer.drawLine( node1->getCentre(), node2->getCentre());
 
 		if (arrowHeadSize > 0)
 		{
-			drawHead( dc);
+			drawHead( renderer);
 		}
 
 		if (title == "" && node1->getTitle() != "" && node2->getTitle() != "")
@@ -75,12 +74,12 @@ namespace View
 			title = node1->getTitle() + " to " + node2->getTitle();
 		}
 
-		wxSize textSize = dc.GetTextExtent( title);
+		titleSize = renderer.getTextExtent( title);
 
 		wxPoint textPoint = getBegin();
 		double angle = Utils::Shape2DUtils::getAngle( node1->getCentre(), node2->getCentre());
-		double dX = (getLength() / 2 - textSize.x / 2) * sin( angle);
-		double dY = (getLength() / 2 - textSize.x / 2) * cos( angle);
+		double dX = (getLength() / 2 - titleSize.x / 2) * sin( angle);
+		double dY = (getLength() / 2 - titleSize.x / 2) * cos( angle);
 
 		textPoint.x += static_cast<int>(dX);
 		textPoint.y -= static_cast<int>(dY);
@@ -88,12 +87,12 @@ namespace View
 		double degreeAngle = angle * (180.0 / Utils::PI);
 		double rotationAngle = 90 - degreeAngle;
 
-		dc.DrawRotatedText( title, textPoint, rotationAngle);
+		renderer.drawRotatedText( title, textPoint, rotationAngle);
 	}
 	/**
 	 *
 	 */
-	void LineShape::drawHead( wxDC& dc)
+	void LineShape::drawHead( Renderer& renderer)
 	{
 		using Utils::PI;
 
@@ -180,25 +179,25 @@ namespace View
 
 		if (isSelected())
 		{
-			dc.SetPen( wxPen(  "RED", lineWidth, wxPENSTYLE_SOLID));
-			dc.SetBrush( wxBrush( wxColour(  "RED")));
+			renderer.setPen( "RED", lineWidth);
+			renderer.setBrush( Colour( "RED"));
 		} else
 		{
-			dc.SetPen( wxPen(  "BLACK", lineWidth, wxPENSTYLE_SOLID));
-			dc.SetBrush( wxBrush( wxColour(  "BLACK")));
+			renderer.setPen( "BLACK", lineWidth);
+			renderer.setBrush( Colour( "BLACK"));
 		}
-		dc.DrawPolygon( 3, triangle);
+		renderer.drawPolygon( 3, triangle);
 
 		// For debugging purposes
-		dc.SetPen( wxPen(  "ORANGE", 2, wxPENSTYLE_SOLID));
-		dc.SetBrush( wxBrush( wxColour(  "ORANGE")));
-		dc.DrawCircle( top, 2);
-		dc.SetPen( wxPen(  "GREEN", 2, wxPENSTYLE_SOLID)); 	// stuuRRRRRRboord RRRRRRechts gRRRRRRoen
-		dc.SetBrush( wxBrush( wxColour(  "GREEN")));
-		dc.DrawCircle( right, 2);
-		dc.SetPen( wxPen(  "RED", 2, wxPENSTYLE_SOLID));
-		dc.SetBrush( wxBrush( wxColour(  "RED")));
-		dc.DrawCircle( left, 2);
+		renderer.setPen( "ORANGE", 2);
+		renderer.setBrush( Colour( "ORANGE"));
+		renderer.drawCircle( top, 2);
+		renderer.setPen( "GREEN", 2); 	// stuuRRRRRRboord RRRRRRechts gRRRRRRoen
+		renderer.setBrush( Colour( "GREEN"));
+		renderer.drawCircle( right, 2);
+		renderer.setPen( "RED", 2);
+		renderer.setBrush( Colour( "RED"));
+		renderer.drawCircle( left, 2);
 	}
 	/**
 	 *
@@ -219,6 +218,19 @@ namespace View
 		}
 		return result;
 	}
+	/**
+	 *
+	 */
+	wxRect LineShape::getBoundingBox() const
+	{
+		// The title is drawn along the line, the arrow head at the end of it
+		int margin = std::max( lineWidth, arrowHeadSize) + titleSize.y;
+		int left = std::min( node1->getCentre().x, node2->getCentre().x) - margin;
+		int top = std::min( node1->getCentre().y, node2->getCentre().y) - margin;
+		int right = std::max( node1->getCentre().x, node2->getCentre().x) + margin;
+		int bottom = std::max( node1->getCentre().y, node2->getCentre().y) + margin;
+		return wxRect( left, top, right - left + 1, bottom - top + 1);
+	}
 	/**
 	 *
 	 */
@@ -43,7 +43,7 @@ namespace View
 			 * A Notifier will call this function if this Observer will handle the notifications of that
 			 * Notifier. It is the responsibility of the Observer to filter any events it is interested in.
 			 */
-			virtual void handleNotification() override {}
+			virtual void handleNotification( const Base::Notification& UNUSEDPARAM(aNotification)) override {}
 			//@}
 			/**
 			 * @name Pure virtual abstract Shape functions
@@ -52,7 +52,7 @@ namespace View
 			/**
 			 *
 			 */
-			virtual void draw( wxDC& dc) override;
+			virtual void draw( Renderer& renderer) override;
 			/**
 			 *
 			 * @param aPoint
@@ -67,11 +67,15 @@ namespace View
 			 *
 			 */
 			virtual void setCentre( const wxPoint& aPoint) override;
+			/**
+			 *
+			 */
+			virtual wxRect getBoundingBox() const override;
 			//@}
 			/**
 			 *
 			 */
-			void drawHead( wxDC& dc);
+			void drawHead( Renderer& renderer);
 			/**
 			 *
 			 */
@@ -167,6 +171,7 @@ namespace View
 			RectangleShapePtr node1;
 			RectangleShapePtr node2;
 			std::string title;
+			wxSize titleSize;
 			int lineWidth;
 			int arrowHeadSize;
 			wxPoint top;
@@ -3,6 +3,7 @@
 
 #include "Config.hpp"
 
+#include <atomic>
 #include <string>
 
 namespace Application
@@ -41,7 +42,7 @@ namespace Application
 			 *
 			 */
 		private:
-			static bool disable;
+			static std::atomic< bool > disable;
 	};
 } // namespace Application
 #endif /* LOGGER_HPP_ */
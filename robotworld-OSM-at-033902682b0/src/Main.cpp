@@ -2,10 +2,14 @@
 
 #include "MainApplication.hpp"
 
+#include "Benchmark.hpp"
+#include "FrameCapture.hpp"
+
 #include "Logger.hpp"
 #include "Trace.hpp"
 #include "FileTraceFunction.hpp"
 
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <stdexcept>
@@ -27,6 +31,21 @@ int main( 	int argc,
 
 	try
 	{
+		// The benchmarks and the frame capture run without the GUI
+		for (int i = 1; i < argc; ++i)
+		{
+			if (std::strncmp( argv[i], "-benchmark=", std::strlen( "-benchmark=")) == 0)
+			{
+				Application::MainApplication::setCommandlineArguments( argc, argv);
+				return Application::Benchmark::run( Application::MainApplication::getArg( "-benchmark").value);
+			}
+			if (std::strncmp( argv[i], "-capture=", std::strlen( "-capture=")) == 0)
+			{
+				Application::MainApplication::setCommandlineArguments( argc, argv);
+				return Application::FrameCapture::run( Application::MainApplication::getArg( "-capture").value);
+			}
+		}
+
 		// Call the wxWidgets main variant
 		// This will actually call Application
 		int result = runGUI( argc, argv);
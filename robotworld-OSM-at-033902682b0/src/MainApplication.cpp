@@ -1,7 +1,14 @@
 #include "MainApplication.hpp"
 
+#include "Logger.hpp"
 #include "MainFrameWindow.hpp"
+#include "NotificationDispatcher.hpp"
 #include "ObjectId.hpp"
+#include "Recorder.hpp"
+#include "Replay.hpp"
+#include "Shard.hpp"
+#include "WorldFile.hpp"
+#include "WorldTextFile.hpp"
 
 #include <stdexcept>
 #include <algorithm>
@@ -38,10 +45,18 @@ namespace Application
 
 		MainApplication::setCommandlineArguments( argc, argv);
 
+		// The model notifies from the robot threads, the views are updated at most -notification_rate times per second
+		unsigned long notificationRate = 60;
+		if (MainApplication::isArgGiven( "-notification_rate"))
+		{
+			notificationRate = std::stoul( MainApplication::getArg( "-notification_rate").value);
+		}
+		Base::NotificationDispatcher::getNotificationDispatcher().start( notificationRate);
+
 		MainFrameWindow* frame = nullptr;
 		if(MainApplication::isArgGiven("-worldname"))
 		{
-			Base::ObjectId::objectIdNamespace = MainApplication::getArg("-worldname").value + "-";
+			Base::ObjectId::setObjectIdNamespace( MainApplication::getArg("-worldname").value);
 
 			frame = new MainFrameWindow( "RobotWorld : " + MainApplication::getArg("-worldname").value);
 
@@ -56,11 +71,92 @@ namespace Application
 		// created initially)
 		frame->Show( true);
 
+		// Before anything asks for the Shard, which is then not sharded if -shard is invalid
+		try
+		{
+			Model::Shard::checkArguments();
+		}
+		catch (std::exception& e)
+		{
+			Application::Logger::log( "Not sharding: " + std::string( e.what()));
+		}
+
+		// A file that cannot be used is reported in the log, the application continues without it
+		if (MainApplication::isArgGiven( "-world"))
+		{
+			const std::string& fileName = MainApplication::getArg( "-world").value;
+			try
+			{
+				if (Model::WorldFile::isWorldFile( fileName))
+				{
+					Model::WorldFile::load( fileName);
+				} else
+				{
+					Model::WorldTextFile::load( fileName);
+				}
+			}
+			catch (std::exception& e)
+			{
+				// The world is only replaced by a file that loaded completely, so it is still empty
+				Application::Logger::log( "Could not load world " + fileName + ": " + e.what());
+			}
+		}
+		if (MainApplication::isArgGiven( "-shard"))
+		{
+			Model::Shard::getShard().start();
+		}
+		if (MainApplication::isArgGiven( "-record"))
+		{
+			try
+			{
+				Model::Recorder::getRecorder().open( MainApplication::getArg( "-record").value);
+			}
+			catch (std::exception& e)
+			{
+				Application::Logger::log( "Could not record: " + std::string( e.what()));
+			}
+		}
+		if (MainApplication::isArgGiven( "-replay"))
+		{
+			try
+			{
+				unsigned long startTick = 0;
+				if (MainApplication::isArgGiven( "-replaystart"))
+				{
+					startTick = std::stoul( MainApplication::getArg( "-replaystart").value);
+				}
+				double speed = 1.0;
+				if (MainApplication::isArgGiven( "-replayspeed"))
+				{
+					speed = std::stod( MainApplication::getArg( "-replayspeed").value);
+				}
+				Model::Replay::getReplay().open( MainApplication::getArg( "-replay").value);
+				Model::Replay::getReplay().play( startTick, speed);
+			}
+			catch (std::exception& e)
+			{
+				Model::Replay::getReplay().close();
+				Application::Logger::log( "Could not replay " + MainApplication::getArg( "-replay").value + ": " + e.what());
+			}
+		}
+
 		// success: wxApp::OnRun() will be called which will enter the main message
 		// loop and the application will run. If we returned false here, the
 		// application would exit immediately.
 		return true;
 	}
+	/**
+	 *
+	 */
+	int MainApplication::OnExit()
+	{
+		// Writes the keyframe index
+		Model::Recorder::getRecorder().close();
+		Model::Replay::getReplay().stop();
+		Model::Shard::getShard().stop();
+		Base::NotificationDispatcher::getNotificationDispatcher().stop();
+		return wxApp::OnExit();
+	}
 	/**
 	 *
 	 */
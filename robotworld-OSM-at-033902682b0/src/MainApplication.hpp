@@ -37,6 +37,12 @@ namespace Application
 			 * @return If OnInit() returns false, the application terminates
 			 */
 			virtual bool OnInit();
+			/**
+			 * This one is called on application exit, after the windows are destroyed
+			 *
+			 * @return The exit code of the application
+			 */
+			virtual int OnExit();
 			/**
 			 * @name Command line handling functions
 			 */
@@ -16,6 +16,7 @@
 #include "RobotWorld.hpp"
 #include "RobotWorldCanvas.hpp"
 #include "Shape2DUtils.hpp"
+#include "Simulation.hpp"
 #include "StdOutTraceFunction.hpp"
 #include "Trace.hpp"
 #include "WidgetTraceFunction.hpp"
@@ -682,7 +683,8 @@ namespace Application
 	 */
 	void MainFrameWindow::OnStartRobot( wxCommandEvent& UNUSEDPARAM(anEvent))
 	{
-		for (Model::RobotPtr robot : Model::RobotWorld::getRobotWorld().getRobots())
+		Model::WorldSnapshotPtr world = Model::RobotWorld::getRobotWorld().getSnapshot();
+		for (const Model::RobotPtr& robot : *world->robots)
 		{
 			if (!robot->isActing())
 			{
@@ -691,6 +693,14 @@ namespace Application
 		}
 		TRACE_DEVELOP("Started Robots");
 		Model::RobotPtr localRobot = Model::RobotWorld::getRobotWorld().getLocalRobot();
+		if (Model::Simulation::getSimulation().isLockstep())
+		{
+			// Both nodes start the tick loop with the same seed
+			std::uint64_t seed = Model::Simulation::getSeedArgument();
+			Model::Simulation::getSimulation().start( seed);
+			localRobot->sendMessage( Messaging::Message( Messaging::StartRequest, std::to_string( seed)));
+			return;
+		}
 		localRobot->sendMessage( Messaging::Message( Messaging::StartRequest ));
 	}
 	/**
@@ -698,6 +708,13 @@ namespace Application
 	 */
 	void MainFrameWindow::OnStopRobot( wxCommandEvent& UNUSEDPARAM(anEvent))
 	{
+		if (Model::Simulation::getSimulation().isLockstep())
+		{
+			// The stop is part of the input of the next tick so both nodes stop the robot at the same tick
+			Model::Simulation::getSimulation().requestStop();
+			TRACE_DEVELOP("Requested stop of Local Robot");
+			return;
+		}
 		Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getLocalRobot();
 		if (robot && robot->isActing())
 		{
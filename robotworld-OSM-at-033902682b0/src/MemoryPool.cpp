@@ -0,0 +1,91 @@
+#include "MemoryPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace Base
+{
+	/**
+	 *
+	 */
+	MemoryPool::MemoryPool(	std::size_t aBlockSize,
+							std::size_t anAlignment) :
+								blockSize( 0),
+								nextSlab( 0),
+								nextBlock( 0),
+								freeList( nullptr),
+								numberOfBlocks( 0)
+	{
+		if (anAlignment > alignof(std::max_align_t))
+		{
+			throw std::invalid_argument( "MemoryPool: over-aligned blocks are not supported");
+		}
+		// Every block must be able to hold the free list header and keep the next block aligned
+		std::size_t alignment = std::max( anAlignment, alignof(FreeBlock));
+		blockSize = std::max( aBlockSize, sizeof(FreeBlock));
+		blockSize = (blockSize + alignment - 1) / alignment * alignment;
+	}
+	/**
+	 *
+	 */
+	void* MemoryPool::allocate()
+	{
+		std::unique_lock< std::mutex > lock( poolMutex);
+
+		++numberOfBlocks;
+		if (freeList)
+		{
+			FreeBlock* block = freeList;
+			freeList = block->next;
+			return block;
+		}
+		if (nextBlock == blocksPerSlab)
+		{
+			++nextSlab;
+			nextBlock = 0;
+		}
+		if (nextSlab == slabs.size())
+		{
+			// new[] returns memory that is aligned for any fundamental type
+			slabs.push_back( std::unique_ptr< unsigned char[] >( new unsigned char[blockSize * blocksPerSlab]));
+		}
+		return slabs[nextSlab].get() + blockSize * nextBlock++;
+	}
+	/**
+	 *
+	 */
+	void MemoryPool::deallocate( void* aBlock)
+	{
+		std::unique_lock< std::mutex > lock( poolMutex);
+
+		assert( numberOfBlocks > 0);
+		if (--numberOfBlocks == 0)
+		{
+			// Everything is freed, start again at the start of the first slab
+			freeList = nullptr;
+			nextSlab = 0;
+			nextBlock = 0;
+			return;
+		}
+		FreeBlock* block = static_cast< FreeBlock* >( aBlock);
+		block->next = freeList;
+		freeList = block;
+	}
+	/**
+	 *
+	 */
+	std::size_t MemoryPool::getNumberOfBlocks() const
+	{
+		std::unique_lock< std::mutex > lock( poolMutex);
+		return numberOfBlocks;
+	}
+	/**
+	 *
+	 */
+	std::size_t MemoryPool::getNumberOfSlabs() const
+	{
+		std::unique_lock< std::mutex > lock( poolMutex);
+		return slabs.size();
+	}
+} // namespace Base
@@ -0,0 +1,169 @@
+#ifndef MEMORYPOOL_HPP_
+#define MEMORYPOOL_HPP_
+
+#include "Config.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Base
+{
+	/**
+	 * A slab arena for blocks of one size. Blocks are carved from slabs of blocksPerSlab blocks, so objects that are
+	 * allocated after each other are next to each other in memory. A freed block is put on a free list and reused by
+	 * the next allocation.
+	 *
+	 * If the last allocated block is freed the pool is reset in O(1): the free list is dropped and allocation starts
+	 * again at the start of the first slab. The slabs themselves are kept for the next population.
+	 */
+	class MemoryPool
+	{
+		public:
+			/**
+			 * The number of blocks in a slab
+			 */
+			static const std::size_t blocksPerSlab = 256;
+			/**
+			 *
+			 * @param aBlockSize The size of the blocks
+			 * @param anAlignment The alignment of the blocks, at most alignof(std::max_align_t)
+			 */
+			MemoryPool(	std::size_t aBlockSize,
+						std::size_t anAlignment);
+			/**
+			 *
+			 */
+			MemoryPool( const MemoryPool&) = delete;
+			/**
+			 *
+			 */
+			MemoryPool& operator=( const MemoryPool&) = delete;
+			/**
+			 *
+			 */
+			~MemoryPool() = default;
+			/**
+			 *
+			 * @return an uninitialised block
+			 */
+			void* allocate();
+			/**
+			 * Returns aBlock, which must be allocated by this pool, to the pool
+			 */
+			void deallocate( void* aBlock);
+			/**
+			 *
+			 * @return the number of allocated blocks that are not deallocated yet
+			 */
+			std::size_t getNumberOfBlocks() const;
+			/**
+			 *
+			 * @return the number of slabs
+			 */
+			std::size_t getNumberOfSlabs() const;
+
+		private:
+			/**
+			 * The header of a free block
+			 */
+			struct FreeBlock
+			{
+					FreeBlock* next;
+			};
+
+			std::size_t blockSize;
+
+			std::vector< std::unique_ptr< unsigned char[] > > slabs;
+			/**
+			 * The next block that was never allocated is block nextBlock of slab nextSlab
+			 */
+			std::size_t nextSlab;
+			std::size_t nextBlock;
+			FreeBlock* freeList;
+			std::size_t numberOfBlocks;
+
+			mutable std::mutex poolMutex;
+	};
+	//	class MemoryPool
+
+	/**
+	 * A standard allocator that allocates single objects from a MemoryPool per type. Arrays are allocated with
+	 * operator new.
+	 *
+	 * Use it with std::allocate_shared so the object and its shared_ptr control block are one pooled block:
+	 *
+	 * 		RobotPtr robot = std::allocate_shared< Robot >( Base::PoolAllocator< Robot >(), aName, aPosition);
+	 */
+	template< typename T >
+	class PoolAllocator
+	{
+		public:
+			typedef T value_type;
+
+			PoolAllocator() noexcept = default;
+
+			template< typename U >
+			PoolAllocator( const PoolAllocator< U >&) noexcept
+			{
+			}
+			/**
+			 *
+			 */
+			T* allocate( std::size_t aNumber)
+			{
+				if (aNumber != 1)
+				{
+					return static_cast< T* >( ::operator new( aNumber * sizeof(T)));
+				}
+				return static_cast< T* >( getPool().allocate());
+			}
+			/**
+			 *
+			 */
+			void deallocate(	T* aPointer,
+								std::size_t aNumber) noexcept
+			{
+				if (aNumber != 1)
+				{
+					::operator delete( aPointer);
+					return;
+				}
+				getPool().deallocate( aPointer);
+			}
+			/**
+			 *
+			 * @return the pool of the blocks of T
+			 */
+			static MemoryPool& getPool()
+			{
+				// Never destroyed, objects that are owned by other statics may be freed during static destruction
+				static MemoryPool* pool = new MemoryPool( sizeof(T), alignof(T));
+				return *pool;
+			}
+	};
+	//	class PoolAllocator
+
+	/**
+	 * All PoolAllocators are interchangeable: they use the pool of their type
+	 */
+	template< typename T, typename U >
+	bool operator==(	const PoolAllocator< T >&,
+						const PoolAllocator< U >&) noexcept
+	{
+		return true;
+	}
+	/**
+	 *
+	 */
+	template< typename T, typename U >
+	bool operator!=(	const PoolAllocator< T >&,
+						const PoolAllocator< U >&) noexcept
+	{
+		return false;
+	}
+} // namespace Base
+
+#endif // MEMORYPOOL_HPP_
@@ -24,7 +24,13 @@ namespace Messaging
 		StartRequest,
 		StartResponse,
 		StopRequest,
-		StopResponse
+		StopResponse,
+		TickRequest,
+		TickResponse,
+		HandoffRequest,
+		HandoffResponse,
+		GhostRequest,
+		GhostResponse
 	};
 	//@}
 } /* namespace Messaging */
@@ -0,0 +1,81 @@
+#ifndef NOTIFICATION_HPP_
+#define NOTIFICATION_HPP_
+
+#include "Config.hpp"
+
+namespace Base
+{
+	class Notifier;
+
+	/**
+	 * What an Observer receives: the Notifier that changed and what changed as a mask of topics.
+	 *
+	 * An Observer subscribes to a mask of topics and only receives the notifications that share a topic with it.
+	 * The NotificationDispatcher merges the topics of the notifications it coalesces.
+	 */
+	class Notification
+	{
+		public:
+			/**
+			 *
+			 */
+			enum Topic : unsigned int
+			{
+				NoTopics = 0,
+				PositionChanged = 1U << 0,   //!< The position or the heading of the object
+				PathChanged = 1U << 1,       //!< The path of the object or the search for it
+				ObjectsCreated = 1U << 2,    //!< Objects were added to the world
+				ObjectsDeleted = 1U << 3,    //!< Objects were removed from the world
+				AttributesChanged = 1U << 4, //!< Anything else, e.g. the name, the size or the speed
+				AllTopics = ~0U
+			};
+			typedef unsigned int TopicMask;
+			/**
+			 *
+			 */
+			Notification(	Notifier& aNotifier,
+							TopicMask aTopics) :
+								notifier( &aNotifier),
+								topics( aTopics)
+			{
+			}
+			/**
+			 *
+			 */
+			Notifier& getNotifier() const
+			{
+				return *notifier;
+			}
+			/**
+			 *
+			 * @throw std::bad_cast if the Notifier is not a T
+			 */
+			template< typename T >
+			T& getNotifierAs() const
+			{
+				return dynamic_cast< T& >( *notifier);
+			}
+			/**
+			 *
+			 */
+			TopicMask getTopics() const
+			{
+				return topics;
+			}
+			/**
+			 *
+			 * @return true if the notification has at least one of aTopics
+			 */
+			bool hasTopic( TopicMask aTopics) const
+			{
+				return (topics & aTopics) != 0;
+			}
+
+		private:
+			Notifier* notifier;
+			TopicMask topics;
+	};
+	// class Notification
+} // namespace Base
+
+#endif // NOTIFICATION_HPP_
@@ -0,0 +1,273 @@
+#include "NotificationDispatcher.hpp"
+
+#include "Logger.hpp"
+#include "Observer.hpp"
+
+#include <exception>
+#include <string>
+
+namespace Base
+{
+	/**
+	 *
+	 */
+	/* static */NotificationDispatcher& NotificationDispatcher::getNotificationDispatcher()
+	{
+		static NotificationDispatcher notificationDispatcher;
+		return notificationDispatcher;
+	}
+	/**
+	 *
+	 */
+	NotificationDispatcher::NotificationDispatcher() :
+								running( false),
+								minimumInterval( std::chrono::steady_clock::duration::zero()),
+								queue( nullptr),
+								deliveringFirst( nullptr),
+								deliveringLast( nullptr)
+	{
+	}
+	/**
+	 *
+	 */
+	NotificationDispatcher::~NotificationDispatcher()
+	{
+		// The observers may be gone already, so the pending notifications are not delivered
+		{
+			std::unique_lock< std::mutex > lock( wakeUpMutex);
+			running = false;
+		}
+		notificationPosted.notify_all();
+		if (dispatcherThread.joinable())
+		{
+			dispatcherThread.join();
+		}
+
+		std::unique_lock< std::recursive_mutex > deliveryLock( deliveryMutex);
+		takeQueue();
+		while (deliveringFirst)
+		{
+			Mailbox* mailbox = deliveringFirst;
+			deliveringFirst = mailbox->next;
+			mailbox->self.reset();
+		}
+		deliveringLast = nullptr;
+	}
+	/**
+	 *
+	 */
+	void NotificationDispatcher::start( unsigned long aMaximumRate /*= 0*/)
+	{
+		if (running)
+		{
+			return;
+		}
+		minimumInterval = std::chrono::steady_clock::duration::zero();
+		if (aMaximumRate > 0)
+		{
+			minimumInterval = std::chrono::steady_clock::duration( std::chrono::seconds( 1)) / static_cast< std::chrono::steady_clock::rep >( aMaximumRate);
+		}
+
+		running = true;
+		std::thread newDispatcherThread( [this]
+		{
+			run();
+		});
+		dispatcherThread.swap( newDispatcherThread);
+	}
+	/**
+	 *
+	 */
+	void NotificationDispatcher::stop()
+	{
+		{
+			std::unique_lock< std::mutex > lock( wakeUpMutex);
+			running = false;
+		}
+		notificationPosted.notify_all();
+		if (dispatcherThread.joinable() && dispatcherThread.get_id() != std::this_thread::get_id())
+		{
+			dispatcherThread.join();
+		}
+		flush();
+	}
+	/**
+	 *
+	 */
+	void NotificationDispatcher::post(	const MailboxPtr& aMailbox,
+										Notification::TopicMask aTopics)
+	{
+		aMailbox->topics.fetch_or( aTopics);
+		// Only the post that queues the Mailbox touches next and self, until the delivery clears queued
+		if (!aMailbox->queued.exchange( true))
+		{
+			aMailbox->self = aMailbox;
+			Mailbox* first = queue.load();
+			do
+			{
+				aMailbox->next = first;
+			} while (!queue.compare_exchange_weak( first, aMailbox.get()));
+
+			if (first == nullptr)
+			{
+				// Locking before the notify makes sure the dispatcher thread is either waiting or sees the Mailbox
+				{
+					std::unique_lock< std::mutex > lock( wakeUpMutex);
+				}
+				notificationPosted.notify_one();
+			}
+		}
+		if (!running)
+		{
+			// The caller saw the dispatcher running but stop() may have done its last flush already
+			flush();
+		}
+	}
+	/**
+	 *
+	 */
+	void NotificationDispatcher::flush()
+	{
+		std::unique_lock< std::recursive_mutex > deliveryLock( deliveryMutex);
+		takeQueue();
+		// An observer may cancel notifications that are still to be delivered
+		while (deliveringFirst)
+		{
+			Mailbox* mailbox = deliveringFirst;
+			deliveringFirst = mailbox->next;
+			if (deliveringFirst == nullptr)
+			{
+				deliveringLast = nullptr;
+			}
+			MailboxPtr keepAlive = std::move( mailbox->self);
+			// A post after this point queues the Mailbox again, a post before it is part of this delivery
+			mailbox->queued = false;
+			Notification::TopicMask topics = mailbox->topics.exchange( Notification::NoTopics);
+			// Not subscribed if posted by a notification that started before the Observer was removed
+			if (topics != Notification::NoTopics && mailbox->subscribed)
+			{
+				mailbox->observer->handleNotification( Notification( *mailbox->notifier, topics));
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void NotificationDispatcher::cancel(	const Notifier& aNotifier,
+											const Observer& anObserver)
+	{
+		cancelIf( [&aNotifier, &anObserver](const Mailbox& aMailbox)
+		{
+			return aMailbox.notifier == &aNotifier && aMailbox.observer == &anObserver;
+		});
+	}
+	/**
+	 *
+	 */
+	void NotificationDispatcher::cancel( const Notifier& aNotifier)
+	{
+		cancelIf( [&aNotifier](const Mailbox& aMailbox)
+		{
+			return aMailbox.notifier == &aNotifier;
+		});
+	}
+	/**
+	 *
+	 */
+	void NotificationDispatcher::cancel( const Observer& anObserver)
+	{
+		cancelIf( [&anObserver](const Mailbox& aMailbox)
+		{
+			return aMailbox.observer == &anObserver;
+		});
+	}
+	/**
+	 *
+	 */
+	void NotificationDispatcher::run()
+	{
+		std::chrono::steady_clock::time_point lastDelivery = std::chrono::steady_clock::now() - minimumInterval;
+		while (running)
+		{
+			{
+				std::unique_lock< std::mutex > lock( wakeUpMutex);
+				notificationPosted.wait( lock, [this]
+				{
+					return !running || queue.load() != nullptr;
+				});
+			}
+			// Everything that is posted until the next delivery is coalesced
+			std::this_thread::sleep_until( lastDelivery + minimumInterval);
+			lastDelivery = std::chrono::steady_clock::now();
+
+			try
+			{
+				flush();
+			}
+			catch (std::exception& e)
+			{
+				Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": ") + e.what());
+			}
+			catch (...)
+			{
+				Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": unknown exception"));
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void NotificationDispatcher::takeQueue()
+	{
+		// The queue is last in first out, reversing it gives the order of the posts
+		Mailbox* first = nullptr;
+		Mailbox* last = nullptr;
+		for (Mailbox* mailbox = queue.exchange( nullptr); mailbox;)
+		{
+			Mailbox* next = mailbox->next;
+			mailbox->next = first;
+			first = mailbox;
+			if (last == nullptr)
+			{
+				last = mailbox;
+			}
+			mailbox = next;
+		}
+		if (first == nullptr)
+		{
+			return;
+		}
+		if (deliveringLast)
+		{
+			deliveringLast->next = first;
+		} else
+		{
+			deliveringFirst = first;
+		}
+		deliveringLast = last;
+	}
+	/**
+	 *
+	 */
+	template< typename Predicate >
+	void NotificationDispatcher::cancelIf( const Predicate& aPredicate)
+	{
+		// Waits for a delivery in progress. With deliveryMutex locked nothing takes Mailboxes off the queue, so the
+		// queue can be walked while other threads post. A cancelled Mailbox is released without a delivery.
+		std::unique_lock< std::recursive_mutex > deliveryLock( deliveryMutex);
+		for (Mailbox* mailbox = queue.load(); mailbox; mailbox = mailbox->next)
+		{
+			if (aPredicate( *mailbox))
+			{
+				mailbox->subscribed = false;
+			}
+		}
+		for (Mailbox* mailbox = deliveringFirst; mailbox; mailbox = mailbox->next)
+		{
+			if (aPredicate( *mailbox))
+			{
+				mailbox->subscribed = false;
+			}
+		}
+	}
+} // namespace Base
@@ -0,0 +1,176 @@
+#ifndef NOTIFICATIONDISPATCHER_HPP_
+#define NOTIFICATIONDISPATCHER_HPP_
+
+#include "Config.hpp"
+
+#include "Notification.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <memory>
+#include <thread>
+
+namespace Base
+{
+	class Notifier;
+	class Observer;
+
+	/**
+	 * Delivers the notifications of all Notifiers on a thread of its own.
+	 *
+	 * Every subscription of an Observer to a Notifier has a Mailbox. While the dispatcher is running
+	 * Notifier::notifyObservers only ors the topics into the Mailbox and, if the Mailbox was not queued yet, pushes it
+	 * onto a lock-free intrusive queue. Posting neither allocates nor locks, except for waking the dispatcher thread
+	 * when the queue was empty, i.e. once per delivery. The dispatcher thread calls Observer::handleNotification once
+	 * per queued Mailbox with the topics of all notifications since the previous delivery, so any number of
+	 * notifications between two deliveries collapse into one callback. With a maximum rate the deliveries are at
+	 * least 1 / rate seconds apart.
+	 *
+	 * If the dispatcher is not running the notifications are delivered synchronously as before. That includes a
+	 * notification that is posted while stop() runs, so none is lost.
+	 *
+	 * A Notifier or Observer that is destroyed, or an Observer that is removed, cancels its pending notifications.
+	 * Cancelling waits for a delivery that is in progress, and a notification that is posted after its subscription
+	 * was removed is dropped, so an Observer is never called after it was removed. The destructor of Observer runs
+	 * after the destructors of the derived classes, so an Observer must be removed from its Notifiers before it is
+	 * destroyed, see View::ViewObject::stopObserving.
+	 */
+	class NotificationDispatcher
+	{
+		public:
+			/**
+			 * The notifications of one subscription of an Observer to a Notifier that were not delivered yet. The
+			 * Notifier creates the Mailbox when the Observer is added, posting only changes its atomic members.
+			 */
+			struct Mailbox
+			{
+					Mailbox(	Notifier& aNotifier,
+								Observer& anObserver) :
+									notifier( &aNotifier),
+									observer( &anObserver)
+					{
+					}
+					Notifier* notifier;
+					Observer* observer;
+					/**
+					 * Cleared when the Observer is removed, a queued notification is then dropped
+					 */
+					std::atomic< bool > subscribed{ true};
+					/**
+					 * The topics of all notifications since the last delivery
+					 */
+					std::atomic< Notification::TopicMask > topics{ Notification::NoTopics};
+					/**
+					 * Set by the post that queues the Mailbox, cleared just before the delivery
+					 */
+					std::atomic< bool > queued{ false};
+					/**
+					 * The next Mailbox in the queue, only valid while queued
+					 */
+					Mailbox* next = nullptr;
+					/**
+					 * Keeps a queued Mailbox alive if its subscription is removed before the delivery
+					 */
+					std::shared_ptr< Mailbox > self;
+			};
+			typedef std::shared_ptr< Mailbox > MailboxPtr;
+			/**
+			 *
+			 */
+			static NotificationDispatcher& getNotificationDispatcher();
+			/**
+			 * Starts the dispatcher thread
+			 *
+			 * @param aMaximumRate The maximum number of deliveries per second, 0 for no limit
+			 */
+			void start( unsigned long aMaximumRate = 0);
+			/**
+			 * Delivers the pending notifications and stops the dispatcher thread
+			 */
+			void stop();
+			/**
+			 *
+			 */
+			bool isRunning() const
+			{
+				return running;
+			}
+			/**
+			 * Adds aTopics to aMailbox and queues it if it was not queued yet, the Observer of aMailbox is notified
+			 * at the next delivery
+			 */
+			void post(	const MailboxPtr& aMailbox,
+						Notification::TopicMask aTopics);
+			/**
+			 * Delivers the pending notifications in the calling thread
+			 */
+			void flush();
+			/**
+			 * Cancels the pending notifications of aNotifier to anObserver
+			 */
+			void cancel(	const Notifier& aNotifier,
+							const Observer& anObserver);
+			/**
+			 * Cancels the pending notifications of aNotifier
+			 */
+			void cancel( const Notifier& aNotifier);
+			/**
+			 * Cancels the pending notifications to anObserver
+			 */
+			void cancel( const Observer& anObserver);
+
+		protected:
+			/**
+			 *
+			 */
+			NotificationDispatcher();
+			/**
+			 *
+			 */
+			virtual ~NotificationDispatcher();
+			/**
+			 * The loop of the dispatcher thread
+			 */
+			void run();
+
+		private:
+			/**
+			 * Moves the queued Mailboxes to the end of the delivering list in the order they were posted,
+			 * deliveryMutex must be locked
+			 */
+			void takeQueue();
+			/**
+			 * Drops the notifications for which aPredicate is true from the queued and the delivering Mailboxes
+			 */
+			template< typename Predicate >
+			void cancelIf( const Predicate& aPredicate);
+
+			std::atomic< bool > running;
+			std::thread dispatcherThread;
+			std::chrono::steady_clock::duration minimumInterval;
+			/**
+			 * The Mailboxes that are posted, the last posted first. Only flush takes Mailboxes off the queue, with
+			 * deliveryMutex locked.
+			 */
+			std::atomic< Mailbox* > queue;
+			/**
+			 * Only used to wake the dispatcher thread when the queue is no longer empty
+			 */
+			std::mutex wakeUpMutex;
+			std::condition_variable notificationPosted;
+			/**
+			 * Held during a delivery, recursive because observers may cancel from their handleNotification
+			 */
+			std::recursive_mutex deliveryMutex;
+			/**
+			 * The Mailboxes that are taken off the queue but not delivered yet, in the order they were posted
+			 */
+			Mailbox* deliveringFirst;
+			Mailbox* deliveringLast;
+	};
+	//	class NotificationDispatcher
+} // namespace Base
+
+#endif // NOTIFICATIONDISPATCHER_HPP_
@@ -2,6 +2,7 @@
 
 #include "Observer.hpp"
 #include "Logger.hpp"
+#include "NotificationDispatcher.hpp"
 
 #include <algorithm>
 #include <sstream>
@@ -13,8 +14,42 @@ namespace Base
 	 *
 	 */
 	Notifier::Notifier( bool enable /*= true*/) :
-								notify( enable)
+								notify( enable),
+								observers( nullptr),
+								readers( 0)
 	{
+		// The dispatcher must outlive every Notifier, including the static ones
+		NotificationDispatcher::getNotificationDispatcher();
+	}
+	/**
+	 *
+	 */
+	Notifier::~Notifier()
+	{
+		NotificationDispatcher::getNotificationDispatcher().cancel( *this);
+
+		delete observers.load();
+		for (const ObserverList* retired : retiredObservers)
+		{
+			delete retired;
+		}
+	}
+	/**
+	 *
+	 */
+	Notifier::Notifier( const Notifier& aNotifier) :
+								notify( aNotifier.notify.load()),
+								observers( nullptr),
+								readers( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	Notifier& Notifier::operator=( const Notifier& aNotifier)
+	{
+		notify = aNotifier.notify.load();
+		return *this;
 	}
 	/**
 	 *
@@ -40,49 +75,112 @@ namespace Base
 	/**
 	 *	The implementation of operator== uses pointer comparison!
 	 */
-	void Notifier::addObserver( Observer& anObserver)
+	void Notifier::addObserver(	Observer& anObserver,
+								Notification::TopicMask aTopics /*= Notification::AllTopics*/)
 	{
-		if (std::find_if(	observers.begin(),
-							observers.end(),
-							[&anObserver](const Observer* observer){ return *observer == anObserver;}) != observers.end())
+		std::unique_lock< std::mutex > lock( observersMutex);
+		const ObserverList* currentObservers = observers.load();
+		ObserverList* newObservers = currentObservers ? new ObserverList( *currentObservers) : new ObserverList;
+		ObserverList::iterator i = std::find_if(	newObservers->begin(),
+													newObservers->end(),
+													[&anObserver](const Subscription& subscription){ return *subscription.observer == anObserver;});
+		if (i != newObservers->end())
+		{
+			if (i->topics == aTopics)
+			{
+				delete newObservers;
+				return ;
+			}
+			i->topics = aTopics;
+		} else
 		{
-			return ;
+			newObservers->push_back( Subscription{ &anObserver, aTopics, std::make_shared< NotificationDispatcher::Mailbox >( *this, anObserver)});
 		}
-
-		observers.push_back( &anObserver);
+		publishObservers( newObservers);
 	}
 	/**
 	 *	The implementation of operator== uses pointer comparison!
 	 */
 	void Notifier::removeObserver( Observer& anObserver)
 	{
-		for (std::vector< Observer* >::iterator i = observers.begin(); i != observers.end(); ++i)
 		{
-			if (*(*i) == anObserver)
+			std::unique_lock< std::mutex > lock( observersMutex);
+			const ObserverList* currentObservers = observers.load();
+			if (currentObservers)
 			{
-				observers.erase( i);
-				break;
+				ObserverList::const_iterator i = std::find_if(	currentObservers->begin(),
+																currentObservers->end(),
+																[&anObserver](const Subscription& subscription){ return *subscription.observer == anObserver;});
+				if (i != currentObservers->end())
+				{
+					// A notifyObservers that still reads the old list may post after the cancel below
+					i->mailbox->subscribed = false;
+
+					ObserverList* newObservers = nullptr;
+					if (currentObservers->size() > 1)
+					{
+						newObservers = new ObserverList( currentObservers->begin(), i);
+						newObservers->insert( newObservers->end(), i + 1, currentObservers->end());
+					}
+					publishObservers( newObservers);
+				}
 			}
 		}
+		NotificationDispatcher::getNotificationDispatcher().cancel( *this, anObserver);
 	}
 	/**
 	 *
 	 */
 	void Notifier::removeAllObservers()
 	{
-		observers.erase( observers.begin(), observers.end());
+		{
+			std::unique_lock< std::mutex > lock( observersMutex);
+			const ObserverList* currentObservers = observers.load();
+			if (currentObservers)
+			{
+				for (const Subscription& subscription : *currentObservers)
+				{
+					subscription.mailbox->subscribed = false;
+				}
+			}
+			publishObservers( nullptr);
+		}
+		NotificationDispatcher::getNotificationDispatcher().cancel( *this);
 	}
 	/**
 	 *
 	 */
-	void Notifier::notifyObservers()
+	void Notifier::notifyObservers( Notification::TopicMask aTopics /*= Notification::AllTopics*/)
 	{
 		if (notify)
 		{
-			for (Observer* observer : observers)
+			// Registering as a reader before loading the list keeps the list alive until the reader leaves
+			readers.fetch_add( 1);
+			const ObserverList* currentObservers = observers.load();
+			if (currentObservers)
 			{
-				observer->handleNotification();
+				NotificationDispatcher& notificationDispatcher = NotificationDispatcher::getNotificationDispatcher();
+				if (notificationDispatcher.isRunning())
+				{
+					for (const Subscription& subscription : *currentObservers)
+					{
+						if (subscription.topics & aTopics)
+						{
+							notificationDispatcher.post( subscription.mailbox, subscription.topics & aTopics);
+						}
+					}
+				} else
+				{
+					for (const Subscription& subscription : *currentObservers)
+					{
+						if ((subscription.topics & aTopics) && subscription.mailbox->subscribed)
+						{
+							subscription.observer->handleNotification( Notification( *this, subscription.topics & aTopics));
+						}
+					}
+				}
 			}
+			readers.fetch_sub( 1);
 		}
 	}
 	/**
@@ -94,6 +192,27 @@ namespace Base
 		os << typeid(*this).name();
 		return os.str();
 	}
+	/**
+	 *
+	 */
+	void Notifier::publishObservers( const ObserverList* aNewObservers)
+	{
+		const ObserverList* oldObservers = observers.exchange( aNewObservers);
+		if (oldObservers)
+		{
+			retiredObservers.push_back( oldObservers);
+		}
+		// A reader that arrives after the exchange reads the new list, so without readers now nobody can hold a
+		// retired list. A busy Notifier keeps them until a later change or its destruction.
+		if (readers.load() == 0)
+		{
+			for (const ObserverList* retired : retiredObservers)
+			{
+				delete retired;
+			}
+			retiredObservers.clear();
+		}
+	}
 	/**
 	 *
 	 */
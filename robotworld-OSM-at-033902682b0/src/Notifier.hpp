@@ -3,8 +3,13 @@
 
 #include "Config.hpp"
 
+#include "Notification.hpp"
+#include "NotificationDispatcher.hpp"
 #include "Observer.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -15,6 +20,14 @@ namespace Base
 	/**
 	 * The Notifier class is part of a straight forward implementation of the Observer/Notifier pattern
 	 *
+	 * The Observers may be added and removed while other threads notify. The list of Observers is immutable,
+	 * adding or removing an Observer publishes a copy. notifyObservers only counts itself as a reader of the list and
+	 * posts to the Mailboxes of the subscriptions, it does not allocate and only locks to wake an idle
+	 * NotificationDispatcher. A replaced list is deleted when no notification is in progress.
+	 *
+	 * removeObserver clears the subscribed flag of the Mailbox. A notification that started before removeObserver
+	 * and reaches the NotificationDispatcher after it is dropped at the delivery, so a removed Observer is not called.
+	 *
 	 * @see Observer
 	 */
 	class Notifier
@@ -31,10 +44,18 @@ namespace Base
 			 */
 			explicit Notifier( bool enable = true);
 			/**
-			 *
+			 * Cancels the pending notifications, see NotificationDispatcher
 			 */
-			virtual ~Notifier() = default;
+			virtual ~Notifier();
 			//@}
+			/**
+			 * The list of Observers is not copied
+			 */
+			Notifier( const Notifier& aNotifier);
+			/**
+			 * The list of Observers is not copied
+			 */
+			Notifier& operator=( const Notifier& aNotifier);
 
 			/**
 			 * @name Notifier functions
@@ -56,11 +77,13 @@ namespace Base
 			 */
 			virtual bool isEnabledForNotification() const;
 			/**
-			 * Adds the Observer to the list of Observers if not in the list yet
+			 * Adds the Observer to the list of Observers if not in the list yet, otherwise replaces its topics
 			 *
 			 * @param anObserver The observer to add
+			 * @param aTopics The topics anObserver is notified of
 			 */
-			virtual void addObserver( Observer& anObserver);
+			virtual void addObserver(	Observer& anObserver,
+										Notification::TopicMask aTopics = Notification::AllTopics);
 			/**
 			 * Removes the Observer from the list of Observers if in the list
 			 *
@@ -72,9 +95,12 @@ namespace Base
 			 */
 			virtual void removeAllObservers();
 			/**
-			 * Notifies all observers
+			 * Notifies the observers that subscribed to one of aTopics, asynchronously if the NotificationDispatcher
+			 * is running
+			 *
+			 * @param aTopics What changed, all topics if the Notifier does not know
 			 */
-			virtual void notifyObservers();
+			virtual void notifyObservers( Notification::TopicMask aTopics = Notification::AllTopics);
 			//@}
 
 			/**
@@ -95,11 +121,42 @@ namespace Base
 			/**
 			 *
 			 */
-			bool notify;
+			struct Subscription
+			{
+					Observer* observer;
+					Notification::TopicMask topics;
+					/**
+					 * Shared with the NotificationDispatcher while a notification is pending
+					 */
+					NotificationDispatcher::MailboxPtr mailbox;
+			};
+			typedef std::vector< Subscription > ObserverList;
+			/**
+			 * Replaces the list of Observers, observersMutex must be locked
+			 *
+			 * @param aNewObservers The new list, nullptr if there are no Observers
+			 */
+			void publishObservers( const ObserverList* aNewObservers);
 			/**
 			 *
 			 */
-			std::vector< Observer* > observers;
+			std::atomic< bool > notify;
+			/**
+			 * nullptr if there are no Observers
+			 */
+			std::atomic< const ObserverList* > observers;
+			/**
+			 * The number of notifyObservers calls that may be reading a list
+			 */
+			mutable std::atomic< unsigned long > readers;
+			/**
+			 * Serialises the changes of the list
+			 */
+			std::mutex observersMutex;
+			/**
+			 * The replaced lists that were still being read
+			 */
+			std::vector< const ObserverList* > retiredObservers;
 
 	};
 	// class Notifier
@@ -1,153 +1,101 @@
 #include "ObjectId.hpp"
 
-#include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/date_time/c_local_time_adjustor.hpp>
-
-#include <ctime>
-#include <climits>
-#include <mutex>
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
 
 namespace Base
 {
-	/**
-	 * newObjectId() uses gmtime() as it is faster than localtime().
-	 * We just calculates our offset to GMT once and cache it
-	 */
-	struct GMTOffset
+	namespace
 	{
-			GMTOffset()
-			{
-				// Get the current time in UTC and local form.
-				auto utc_time = boost::posix_time::microsec_clock::universal_time();
-				auto local_time = boost::date_time::c_local_adjustor< boost::posix_time::ptime >::utc_to_local( utc_time);
-
-				// Calculate the difference in milliseconds between local time and the UTC time.
-				auto time_t_diff = boost::posix_time::to_time_t( local_time) - boost::posix_time::to_time_t( utc_time);
-
-				offset = time_t_diff / 3600; // @suppress("Avoid magic numbers")
-			}
-			std::size_t offset;
-
-	};
-	static GMTOffset gmtOffset;
+		/**
+		 * The namespace bits, already shifted into place
+		 */
+		std::atomic< std::uint64_t > namespaceBits( 0);
+		/**
+		 * The counter starts at 1 because 0 is the null ObjectId
+		 */
+		std::atomic< std::uint64_t > counter( 1);
+
+		const std::uint64_t counterMask = (std::uint64_t( 1) << ObjectId::counterBits) - 1;
+	} // namespace
 
 	/**
 	 *
 	 */
 	/* static */ std::string ObjectId::objectIdNamespace = "";
-
-	static std::mutex newObjectIdMutex;
-
-	/* static */ObjectId ObjectId::newObjectId()
+	/**
+	 *
+	 */
+	/* static */void ObjectId::setObjectIdNamespace( const std::string& aNamespace)
 	{
-		std::lock_guard< std::mutex > lock( newObjectIdMutex);
-
-		static time_t currentSecond = 0;
-		static unsigned long fraction = 0;
+		objectIdNamespace = aNamespace;
 
-		time_t newSecond = 0;
-
-		struct timespec now;
-
-		clock_gettime(CLOCK_REALTIME, &now);
-		newSecond = now.tv_sec;
-
-		// Reset seconds and fraction if in a new second
-		if (currentSecond < newSecond)
+		// FNV-1a folded to 16 bits, the empty namespace maps to 0
+		std::uint64_t hash = 0;
+		if (!aNamespace.empty())
 		{
-			currentSecond = newSecond;
-			fraction = 0;
-		}
-
-		// Prevent overflow to 0 within the second. This should only happen on fast machines
-		// as the creation of the fraction part is processor speed dependent
-		if (fraction == ULONG_MAX)
-		{
-			// Wait for the next second
-			do
+			hash = 14695981039346656037ULL;
+			for (unsigned char c : aNamespace)
 			{
-				clock_gettime(CLOCK_REALTIME, &now);
-				newSecond = now.tv_sec;
-			}while(currentSecond >= newSecond);
-			currentSecond = newSecond;
-			fraction = 0;
+				hash ^= c;
+				hash *= 1099511628211ULL;
+			}
+			hash = (hash ^ (hash >> 16) ^ (hash >> 32) ^ (hash >> 48)) & 0xFFFF;
 		}
-
-		// See https://stackoverflow.com/questions/41544774/localtime-takes-24-times-more-than-gmtime-performance-issue-on-linux
-		// for using gmtime + offset
-		//struct tm* timeStruct = localtime( &currentSecond); //
-		struct tm tm = *gmtime( &currentSecond);
-
-		// We actually only use 27 chars but it could be 93, based on the maximum int values....
-		char timestampBuffer[93] = {'\0'};
-		sprintf( timestampBuffer,
-				 "%04d-%02d-%02d-%02zu-%02d-%02d-%06lu",
-				 tm.tm_year + 1900, // @suppress("Avoid magic numbers")
-				 tm.tm_mon + 1,
-				 tm.tm_mday,
-				 tm.tm_hour + gmtOffset.offset,
-				 tm.tm_min,
-				 tm.tm_sec,
-				 fraction++);
-
-		return ObjectId(timestampBuffer);
+		namespaceBits.store( hash << counterBits, std::memory_order_relaxed);
 	}
 	/**
 	 *
 	 */
-	bool ObjectId::operator==( const ObjectId& anObjectId) const
+	/* static */ObjectId ObjectId::newObjectId()
 	{
-		return (static_cast<base>(*this) == static_cast<base>(anObjectId));
+		return ObjectId( namespaceBits.load( std::memory_order_relaxed) | (counter.fetch_add( 1, std::memory_order_relaxed) & counterMask));
 	}
 	/**
 	 *
 	 */
-	bool ObjectId::operator<( const ObjectId& anObjectId) const
+	std::string ObjectId::toString() const
 	{
-		return (static_cast<base>(*this) < static_cast<base>(anObjectId));
+		char buffer[32];
+		std::snprintf( buffer, sizeof(buffer), "%04x-%012llx", static_cast< unsigned int >( getNamespace()), static_cast< unsigned long long >( value & counterMask));
+		return buffer;
 	}
 	/**
 	 *
 	 */
-	bool ObjectId::isNull() const
+	void ObjectId::fromString( const std::string& anObjectIdString)
 	{
-		if (base::empty())
+		unsigned int namespacePart = 0;
+		unsigned long long counterPart = 0;
+		int length = 0;
+		if (std::sscanf( anObjectIdString.c_str(), "%4x-%12llx%n", &namespacePart, &counterPart, &length) != 2 || static_cast< std::size_t >( length) != anObjectIdString.size())
 		{
-			return true;
+			throw std::invalid_argument( "Not an ObjectId: " + anObjectIdString);
 		}
-		return false;
+		value = (static_cast< std::uint64_t >( namespacePart) << counterBits) | counterPart;
 	}
 	/**
 	 *
 	 */
-	bool ObjectId::isValid() const
+	std::string ObjectId::asString() const
 	{
 		if (isNull())
 		{
-			return false;
+			return "";
 		}
-		return true;
+		return toString();
 	}
 	/**
 	 *
 	 */
-	/*virtual*/std::string ObjectId::asString() const
+	std::string ObjectId::asDebugString() const
 	{
-		if (isNull())
-		{
-			return "";
-		}
-		return std::string( base::begin(), base::end());
+		return asString();
 	}
-
 	/**
 	 *
 	 */
-	/*virtual*/std::string ObjectId::asDebugString() const
-	{
-		return asString();
-	}
-
 	std::ostream& operator<<( 	std::ostream& os,
 								const ObjectId& anObjectId)
 	{
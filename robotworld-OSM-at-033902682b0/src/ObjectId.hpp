@@ -3,282 +3,130 @@
 
 #include "Config.hpp"
 
-#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <iostream>
-#include <iterator>
 #include <string>
-#include <vector>
-
+#include <type_traits>
 
 namespace Base
 {
 	/**
-	 * The ObjectId class is also used in Dagda. Therefore it has the required
-	 * PortableServer::ObjectId / unbounded sequence interface.
+	 * An ObjectId is a 64-bit value: the upper 16 bits identify the namespace (the application or node) that
+	 * generated the ObjectId and the lower 48 bits are a counter. It is trivially copyable, so copying, comparing
+	 * and hashing an ObjectId are single integer operations.
 	 *
-	 * The OID class is 16 bytes, this class is 24 bytes. If one is memory constraint
-	 * the OID class may be of some help. Be warned: the OID class is not actively
-	 * maintained anymore (but than, who reeds this besides me, the maintainer).
+	 * The string form, see toString and fromString, is only meant for display and for sending an ObjectId to
+	 * another application.
 	 */
-	class ObjectId : public std::vector< unsigned char >
+	class ObjectId
 	{
 		public:
-			typedef unsigned char value_type;
-			typedef unsigned char* pointer;
-			typedef const unsigned char* const_pointer;
-			typedef unsigned char& reference;
-			typedef const unsigned char& const_reference;
-			typedef std::vector< unsigned char > base;
-			/**
-			 * If an ObjectId should be *really* universal unique every application should have its own namespace
-			 */
-			static std::string objectIdNamespace;
-			/**
-			 * This function returns an ObjectId that is guaranteed to be unique in the application it
-			 * is generated in. If multiple application use the same library it is the responsibility of
-			 * the applications to ensure uniqueness between applications.
-			 */
-			static ObjectId newObjectId();
-			/**
-			 * @name CORBA required interface for PortableServer::ObjectId and sequence< T >
-			 */
-			//@{
-			/**
-			 * Default ctor.
-			 *
-			 * Also specified by
-			 */
-			ObjectId() :
-				base()
-			{
-			}
 			/**
-			 * Maximum ctor.
-			 *
-			 * @param max Initial elements reservation
-			 */
-			explicit ObjectId( unsigned long max) :
-				base( max)
-			{
-			}
-			/**
-			 * Data ctor.
-			 *
-			 * @param max 		Initial elements reservation. Is actually ignored
-			 * @param length 	Length of the data
-			 * @param data 		Start of the data
-			 * @param release 	If true the sequences owns and manages any containing pointers
-			 * 				  	Is actually ignored and always true.
+			 * The number of bits of the counter part of the ObjectId
 			 */
-			ObjectId( 	unsigned long /*max*/,
-						unsigned long len,
-						unsigned char* aDataPointer,
-						bool /*rel = true-*/) :
-							base( aDataPointer, aDataPointer + len)
-			{
-			}
-			/**
-			 *	Makes a deep copy.
-			 */
-			ObjectId( const ObjectId& anObjectId) :
-				base( anObjectId)
-			{
-			}
-			/**
-			 * @return The virtual maximum of bytes for this ObjectId. This maximum can safely be ignored.
-			 *
-			 */
-			std::size_t maximum() const
-			{
-				return base::capacity();
-			}
-
-			/**
-			 * If the current length of the sequence is less than the new length we append new elements
-			 * which are created by calling the default constructor.  If the current length is more
-			 * than the new length we just cut of the tail of the sequence.
-			 *
-			 * @param length The new length of the sequence
-			 */
-			void length( unsigned long len)
-			{
-				if (base::size() < len)
-				{
-					base::insert( base::end(), len - base::size(), value_type());
-				} else
-				{
-					base::erase( base::begin() + len, base::end());
-				}
-			}
-
-			/**
-			 *
-			 * @return The current length of the ObjectId
-			 */
-			std::size_t length() const
-			{
-				return base::size();
-			}
-
+			static const unsigned int counterBits = 48;
 			/**
-			 *
-			 * @param index
-			 * @return The mutable character at index.
+			 * If an ObjectId should be *really* universal unique every application should have its own namespace
 			 */
-			reference operator[]( unsigned long index)
-			{
-				return base::operator[]( index);
-			}
-
+			static std::string objectIdNamespace;
 			/**
-			 *
-			 * @param index
-			 * @return The non-mutable character at index.
+			 * Sets objectIdNamespace and derives the namespace bits of the ObjectIds that are generated after
+			 * this call from it. Should be called before any ObjectId is generated.
 			 */
-			const_reference operator[]( unsigned long index) const
-			{
-				return base::operator[]( index);
-			}
-
+			static void setObjectIdNamespace( const std::string& aNamespace);
 			/**
-			 * This returns always true for a value container
+			 * This function returns an ObjectId that is guaranteed to be unique in the application it
+			 * is generated in. If multiple application use the same library it is the responsibility of
+			 * the applications to ensure uniqueness between applications, see setObjectIdNamespace.
 			 *
-			 * @return true if this container owns the data.
+			 * It is lock-free and may be called from any thread.
 			 */
-			bool release() const
-			{
-				return true;
-			}
-
+			static ObjectId newObjectId();
 			/**
-			 * @param max Is ignored
-			 * @param rel Is ignored and is treated as true
+			 * Default ctor, the result is a null ObjectId
 			 */
-			void replace( 	unsigned long /*max*/,
-							unsigned long len,
-							pointer newData,
-							bool /*rel = true*/)
+			constexpr ObjectId() :
+				value( 0)
 			{
-				base::erase( base::begin(), base::end());
-				base::insert( base::begin(), newData, newData + len);
 			}
-
 			/**
 			 *
-			 * @param 	orphan
-			 * @return 	The ObjectId as a modifyable continues buffer.
-			 * 			If the buffer is modified as that it expands the buffer this \will
-			 * 			lead to failure eventually
 			 */
-			pointer get_buffer( bool orphan = false)
+			constexpr explicit ObjectId( std::uint64_t aValue) :
+				value( aValue)
 			{
-				if (orphan)
-				{
-					pointer t = allocbuf( base::size());
-					std::copy( base::begin(), base::end(), t);
-					base::erase( base::begin(), base::end());
-					return t;
-				} else
-				{
-					return &base::operator[]( 0);
-				}
 			}
-
 			/**
-			 *
-			 * @return The ObjectId as a readonly continues buffer.
+			 * @param anObjectIdString The string form of an ObjectId as returned by toString
 			 */
-			const_pointer get_buffer() const
+			explicit ObjectId( const std::string& anObjectIdString) :
+				value( 0)
 			{
-				return &base::operator[]( 0);
+				fromString( anObjectIdString);
 			}
-
 			/**
-			 * Do not use. It always throws an Danu::InvalidRequest exception.
 			 *
-			 * @param nelems
-			 * @return a new-ed buffer
 			 */
-			static pointer allocbuf( std::size_t nelems)
+			bool operator==( const ObjectId& anObjectId) const
 			{
-				return new value_type[nelems];
+				return value == anObjectId.value;
 			}
 			/**
-			 * Do not use. It always throws an Danu::InvalidRequest exception.
 			 *
-			 * @param aT The buffer to free
 			 */
-			static void freebuf( pointer aT)
+			bool operator!=( const ObjectId& anObjectId) const
 			{
-				delete[] aT;
+				return value != anObjectId.value;
 			}
-			//@} // CORBA required interface
-
 			/**
 			 *
 			 */
-			template< typename InputIterator >
-			ObjectId( 	InputIterator first,
-						InputIterator last) :
-						base( first, last)
+			bool operator<( const ObjectId& anObjectId) const
 			{
+				return value < anObjectId.value;
 			}
 			/**
 			 *
 			 */
-			explicit ObjectId( const std::string& anObjectIdString) :
-				base( anObjectIdString.begin(), anObjectIdString.end())
+			std::uint64_t getValue() const
 			{
+				return value;
 			}
 			/**
 			 *
 			 */
-			ObjectId& operator=( const ObjectId& anObjectId)
+			std::uint16_t getNamespace() const
 			{
-				if (this != &anObjectId)
-				{
-					base::operator=( anObjectId);
-				}
-				return *this;
+				return static_cast< std::uint16_t >( value >> counterBits);
 			}
-
-			/**
-			 * @param anObjectId
-			 * @return True if the Danu::ObjectId part is the same
-			 */
-			bool operator==( const ObjectId& anObjectId) const;
-			/**
-			 * @param anObjectId
-			 * @return True if the Danu::ObjectId part is less
-			 */
-			bool operator<( const ObjectId& anObjectId) const;
 			/**
 			 * Calling obj1.fromString( obj2.toString()) has the same effect as assignment, obj1 = obj2.
 			 *
 			 * @return std::string
 			 */
-			std::string toString() const
-			{
-				return std::string( begin(), end());
-			}
+			std::string toString() const;
 			/**
 			 * Calling obj1.fromString( obj2.toString()) has the same effect as assignment, obj1 = obj2.
 			 *
 			 * @param anObjectIdString A string representation of an ObjectId.
+			 * @throw std::invalid_argument if anObjectIdString is not a string representation of an ObjectId
 			 */
-			void fromString( const std::string& anObjectIdString)
-			{
-				clear();
-				insert( begin(), anObjectIdString.begin(), anObjectIdString.end());
-			}
+			void fromString( const std::string& anObjectIdString);
 			/**
 			 *
 			 */
-			bool isNull() const;
+			bool isNull() const
+			{
+				return value == 0;
+			}
 			/**
 			 *
 			 */
-			bool isValid() const;
+			bool isValid() const
+			{
+				return value != 0;
+			}
 			/**
 			 * @name Debug functions
 			 */
@@ -286,20 +134,36 @@ namespace Base
 			/**
 			 * Returns a 1-line description of the object
 			 */
-			/*virtual*/
 			std::string asString() const;
 			/**
 			 * Returns a description of the object with all data of the object usable for debugging
 			 */
-			/*virtual*/
 			std::string asDebugString() const;
 			//@}
 
-
+		private:
+			std::uint64_t value;
 	};
 	//	class ObjectId
 
+	static_assert( std::is_trivially_copyable< ObjectId >::value && sizeof(ObjectId) == sizeof(std::uint64_t), "An ObjectId should be a plain 64-bit value");
+
 	std::ostream& operator<<( 	std::ostream& os,
 								const ObjectId& anObjectId);
 } // namespace Base
+
+namespace std
+{
+	/**
+	 * Allows an ObjectId to be used as the key of an unordered container
+	 */
+	template<>
+	struct hash< Base::ObjectId >
+	{
+			std::size_t operator()( const Base::ObjectId& anObjectId) const
+			{
+				return std::hash< std::uint64_t >()( anObjectId.getValue());
+			}
+	};
+} // namespace std
 #endif // OBJECTID_HPP_
@@ -1,9 +1,25 @@
 #include "Observer.hpp"
 
+#include "NotificationDispatcher.hpp"
 #include "Notifier.hpp"
 
 namespace Base
 {
+	/**
+	 *
+	 */
+	Observer::Observer()
+	{
+		// The dispatcher must outlive every Observer, including the static ones
+		NotificationDispatcher::getNotificationDispatcher();
+	}
+	/**
+	 *
+	 */
+	Observer::~Observer()
+	{
+		NotificationDispatcher::getNotificationDispatcher().cancel( *this);
+	}
 	/**
 	 *
 	 */
@@ -21,9 +37,10 @@ namespace Base
 	/**
 	 *
 	 */
-	void Observer::handleNotificationsFor( Notifier& aNotifier)
+	void Observer::handleNotificationsFor(	Notifier& aNotifier,
+											Notification::TopicMask aTopics /*= Notification::AllTopics*/)
 	{
-		aNotifier.addObserver( *this);
+		aNotifier.addObserver( *this, aTopics);
 	}
 	/**
 	 *
@@ -3,6 +3,8 @@
 
 #include "Config.hpp"
 
+#include "Notification.hpp"
+
 namespace Base
 {
 	class Notifier;
@@ -22,7 +24,11 @@ namespace Base
 			/**
 			 *
 			 */
-			virtual ~Observer() = default;
+			Observer();
+			/**
+			 * Cancels the pending notifications, see NotificationDispatcher
+			 */
+			virtual ~Observer();
 			//@}
 			/**
 			 * @name Operators
@@ -42,10 +48,13 @@ namespace Base
 			 */
 			//@{
 			/**
+			 * Calling it again for the same Notifier replaces the topics
 			 *
 			 * @param aNotifier The Notifier this Observer will observe
+			 * @param aTopics The topics of aNotifier this Observer will handle
 			 */
-			virtual void handleNotificationsFor( Notifier& aNotifier);
+			virtual void handleNotificationsFor(	Notifier& aNotifier,
+													Notification::TopicMask aTopics = Notification::AllTopics);
 			/**
 			 *
 			 * @param aNotifier The Notifier this Observer will not observe anymore
@@ -53,10 +62,11 @@ namespace Base
 			virtual void stopHandlingNotificationsFor( Notifier& aNotifier);
 			/**
 			 * A Notifier will call this function if this Observer will handle the notifications of that
-			 * Notifier. It is the responsibility of the Observer to filter any events it is interested in.
+			 * Notifier. Only the notifications with a topic the Observer subscribed to are delivered.
 			 *
+			 * @param aNotification The Notifier and the subscribed topics that changed
 			 */
-			virtual void handleNotification() = 0;
+			virtual void handleNotification( const Notification& aNotification) = 0;
 			//@}
 
 		private:
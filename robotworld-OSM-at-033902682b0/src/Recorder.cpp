@@ -0,0 +1,306 @@
+#include "Recorder.hpp"
+
+#include "Logger.hpp"
+#include "RecordingFormat.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Simulation.hpp"
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace Model
+{
+	/**
+	 *
+	 */
+	/* static */Recorder& Recorder::getRecorder()
+	{
+		static Recorder recorder;
+		return recorder;
+	}
+	/**
+	 *
+	 */
+	Recorder::Recorder() :
+							offset( 0),
+							recording( false),
+							keyFrameInterval( defaultKeyFrameInterval),
+							tick( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	Recorder::~Recorder()
+	{
+		close();
+	}
+	/**
+	 *
+	 */
+	void Recorder::open(	const std::string& aFileName,
+							unsigned long aKeyFrameInterval /*= defaultKeyFrameInterval*/)
+	{
+		close();
+
+		std::unique_lock< std::mutex > lock( recorderMutex);
+
+		file.open( aFileName, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			throw std::runtime_error( "Cannot create recording " + aFileName);
+		}
+
+		offset = 0;
+		tick = 0;
+		keyFrameInterval = std::max( aKeyFrameInterval, 1UL);
+		previousStates.clear();
+		keyFrameOffsets.clear();
+		pathOffsets.clear();
+
+		buffer = RecordingFormat::magic;
+		RecordingFormat::putVarint( buffer, RecordingFormat::version);
+		RecordingFormat::putVarint( buffer, keyFrameInterval);
+		write();
+		file.flush();
+
+		recording = true;
+
+		if (!Simulation::getSimulation().isLockstep())
+		{
+			std::thread newSamplingThread( [this]
+			{
+				sample();
+			});
+			samplingThread.swap( newSamplingThread);
+		}
+
+		TRACE_DEVELOP( "Recording to " + aFileName);
+	}
+	/**
+	 *
+	 */
+	void Recorder::close()
+	{
+		recording = false;
+		if (samplingThread.joinable())
+		{
+			samplingThread.join();
+		}
+
+		std::unique_lock< std::mutex > lock( recorderMutex);
+		if (!file.is_open())
+		{
+			return;
+		}
+
+		buffer.clear();
+		buffer.push_back( RecordingFormat::IndexRecord);
+		RecordingFormat::putVarint( buffer, keyFrameOffsets.size());
+		for (std::uint64_t keyFrameOffset : keyFrameOffsets)
+		{
+			RecordingFormat::putFixed64( buffer, keyFrameOffset);
+		}
+		RecordingFormat::putFixed64( buffer, offset);
+		buffer.append( RecordingFormat::indexMagic);
+		write();
+
+		file.close();
+	}
+	/**
+	 *
+	 */
+	void Recorder::recordTick()
+	{
+		if (!recording)
+		{
+			return;
+		}
+
+		std::vector< RobotState > states;
+		WorldSnapshotPtr world = RobotWorld::getRobotWorld().getSnapshot();
+		for (const RobotPtr& robot : *world->robots)
+		{
+			const Model::RobotState robotState = robot->getState();
+			states.push_back( RobotState{ robot->getName(),
+										  robotState.size,
+										  robotState.position,
+										  wxPoint( static_cast< int >( std::lround( robotState.frontX)), static_cast< int >( std::lround( robotState.frontY))),
+										  robotState.driving});
+		}
+
+		std::unique_lock< std::mutex > lock( recorderMutex);
+
+		// Delta frames refer to the robots of the previous frame by index so they can only be used if
+		// the same robots are in the same order
+		bool sameRobots = states.size() == previousStates.size();
+		for (std::size_t i = 0; sameRobots && i < states.size(); ++i)
+		{
+			sameRobots = states[i].name == previousStates[i].name && states[i].size == previousStates[i].size;
+		}
+
+		if (tick % keyFrameInterval == 0)
+		{
+			writeKeyFrame( states);
+			keyFrameOffsets.push_back( write());
+			// Without an index the recording is only lost up to the last keyframe
+			file.flush();
+		} else if (!sameRobots)
+		{
+			writeKeyFrame( states);
+			write();
+		} else
+		{
+			writeDeltaFrame( states);
+			write();
+		}
+
+		previousStates.swap( states);
+		++tick;
+	}
+	/**
+	 *
+	 */
+	void Recorder::recordPath(	const Robot& aRobot,
+								bool aReplan)
+	{
+		if (!recording)
+		{
+			return;
+		}
+
+		PathAlgorithm::PathPtr path = aRobot.getPathSnapshot();
+
+		std::unique_lock< std::mutex > lock( recorderMutex);
+
+		buffer.clear();
+		buffer.push_back( aReplan ? RecordingFormat::ReplanRecord : RecordingFormat::PathRecord);
+		RecordingFormat::putString( buffer, aRobot.getName());
+		RecordingFormat::putVarint( buffer, path->size());
+		// Consecutive vertices are neighbours so the deltas fit in a single byte
+		int x = 0;
+		int y = 0;
+		for (const PathAlgorithm::Vertex& vertex : *path)
+		{
+			RecordingFormat::putSigned( buffer, vertex.x - x);
+			RecordingFormat::putSigned( buffer, vertex.y - y);
+			x = vertex.x;
+			y = vertex.y;
+		}
+		pathOffsets[aRobot.getName()] = write();
+	}
+	/**
+	 *
+	 */
+	void Recorder::recordCollision( const Robot& aRobot)
+	{
+		if (!recording)
+		{
+			return;
+		}
+
+		std::unique_lock< std::mutex > lock( recorderMutex);
+
+		buffer.clear();
+		buffer.push_back( RecordingFormat::CollisionRecord);
+		RecordingFormat::putString( buffer, aRobot.getName());
+		write();
+	}
+	/**
+	 *
+	 */
+	void Recorder::sample()
+	{
+		try
+		{
+			while (recording)
+			{
+				bool acting = false;
+				WorldSnapshotPtr world = RobotWorld::getRobotWorld().getSnapshot();
+				for (const RobotPtr& robot : *world->robots)
+				{
+					acting = acting || robot->isActing();
+				}
+				if (acting)
+				{
+					recordTick();
+				}
+				std::this_thread::sleep_for( std::chrono::milliseconds( 100)); // @suppress("Avoid magic numbers")
+			}
+		}
+		catch (std::exception& e)
+		{
+			Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": ") + e.what());
+		}
+		catch (...)
+		{
+			Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": unknown exception"));
+		}
+	}
+	/**
+	 *
+	 */
+	void Recorder::writeKeyFrame( const std::vector< RobotState >& aStates)
+	{
+		buffer.clear();
+		buffer.push_back( RecordingFormat::KeyFrame);
+		RecordingFormat::putVarint( buffer, tick);
+		RecordingFormat::putVarint( buffer, aStates.size());
+		for (const RobotState& state : aStates)
+		{
+			RecordingFormat::putString( buffer, state.name);
+			RecordingFormat::putSigned( buffer, state.size.x);
+			RecordingFormat::putSigned( buffer, state.size.y);
+			RecordingFormat::putSigned( buffer, state.position.x);
+			RecordingFormat::putSigned( buffer, state.position.y);
+			RecordingFormat::putSigned( buffer, state.front.x);
+			RecordingFormat::putSigned( buffer, state.front.y);
+			buffer.push_back( state.driving ? 1 : 0);
+			auto pathOffset = pathOffsets.find( state.name);
+			RecordingFormat::putVarint( buffer, pathOffset != pathOffsets.end() ? pathOffset->second : 0);
+		}
+	}
+	/**
+	 *
+	 */
+	void Recorder::writeDeltaFrame( const std::vector< RobotState >& aStates)
+	{
+		std::string robots;
+		std::uint64_t changed = 0;
+		for (std::size_t i = 0; i < aStates.size(); ++i)
+		{
+			const RobotState& state = aStates[i];
+			const RobotState& previousState = previousStates[i];
+			if (state.position == previousState.position && state.front == previousState.front && state.driving == previousState.driving)
+			{
+				continue;
+			}
+			RecordingFormat::putVarint( robots, i);
+			RecordingFormat::putSigned( robots, state.position.x - previousState.position.x);
+			RecordingFormat::putSigned( robots, state.position.y - previousState.position.y);
+			RecordingFormat::putSigned( robots, state.front.x - previousState.front.x);
+			RecordingFormat::putSigned( robots, state.front.y - previousState.front.y);
+			robots.push_back( state.driving ? 1 : 0);
+			++changed;
+		}
+
+		buffer.clear();
+		buffer.push_back( RecordingFormat::DeltaFrame);
+		RecordingFormat::putVarint( buffer, changed);
+		buffer.append( robots);
+	}
+	/**
+	 *
+	 */
+	std::uint64_t Recorder::write()
+	{
+		std::uint64_t recordOffset = offset;
+		file.write( buffer.data(), static_cast< std::streamsize >( buffer.size()));
+		offset += buffer.size();
+		return recordOffset;
+	}
+} // namespace Model
@@ -0,0 +1,127 @@
+#ifndef RECORDER_HPP_
+#define RECORDER_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+#include "Size.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Model
+{
+	class Robot;
+
+	/**
+	 * Records the poses of the robots per tick together with their path changes, replans and collisions in a
+	 * compact binary file, see RecordingFormat. Recording is enabled with the command line argument -record=file.
+	 *
+	 * In lockstep mode the Simulation records each tick, otherwise the recorder samples the robots every 100 ms
+	 * while any robot is acting.
+	 */
+	class Recorder
+	{
+		public:
+			/**
+			 *
+			 */
+			static Recorder& getRecorder();
+			/**
+			 * Creates aFileName and writes the header
+			 *
+			 * @param aKeyFrameInterval The number of ticks between the indexed keyframes
+			 */
+			void open(	const std::string& aFileName,
+						unsigned long aKeyFrameInterval = defaultKeyFrameInterval);
+			/**
+			 * Writes the keyframe index and closes the file
+			 */
+			void close();
+			/**
+			 *
+			 */
+			bool isRecording() const
+			{
+				return recording;
+			}
+			/**
+			 * Records the poses of all robots as the next tick
+			 */
+			void recordTick();
+			/**
+			 *
+			 * @param aReplan true if the path is the result of a replan around another robot
+			 */
+			void recordPath(	const Robot& aRobot,
+								bool aReplan);
+			/**
+			 *
+			 */
+			void recordCollision( const Robot& aRobot);
+
+			static const unsigned long defaultKeyFrameInterval = 50;
+
+		protected:
+			/**
+			 *
+			 */
+			Recorder();
+			/**
+			 *
+			 */
+			virtual ~Recorder();
+			/**
+			 * The sampling loop that is used if the robots are not stepped by the lockstep simulation
+			 */
+			void sample();
+
+		private:
+			/**
+			 * The state of a robot as it is recorded in a frame
+			 */
+			struct RobotState
+			{
+					std::string name;
+					wxSize size;
+					wxPoint position;
+					wxPoint front;
+					bool driving;
+			};
+			/**
+			 *
+			 */
+			void writeKeyFrame( const std::vector< RobotState >& aStates);
+			/**
+			 *
+			 */
+			void writeDeltaFrame( const std::vector< RobotState >& aStates);
+			/**
+			 * Appends the buffer to the file and returns the offset at which it was written
+			 */
+			std::uint64_t write();
+
+			std::ofstream file;
+			std::string buffer;
+			std::uint64_t offset;
+
+			std::atomic< bool > recording;
+			std::thread samplingThread;
+			std::mutex recorderMutex;
+
+			unsigned long keyFrameInterval;
+			unsigned long tick;
+			std::vector< RobotState > previousStates;
+			std::vector< std::uint64_t > keyFrameOffsets;
+			std::map< std::string, std::uint64_t > pathOffsets;
+	};
+	//	class Recorder
+} // namespace Model
+
+#endif // RECORDER_HPP_
@@ -0,0 +1,219 @@
+#ifndef RECORDINGFORMAT_HPP_
+#define RECORDINGFORMAT_HPP_
+
+#include "Config.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace Model
+{
+	/**
+	 * The binary format of a recording, shared by the Recorder and the Replay.
+	 *
+	 * A recording is an append-only sequence of records, all integers are varints and signed integers are
+	 * zigzag encoded first so small negative deltas stay small:
+	 *
+	 *		header		: "RWRC" version keyFrameInterval
+	 *		keyframe	: 'K' tick robotCount { nameLength name width height x y frontX frontY driving pathOffset }
+	 *		delta		: 'D' robotCount { robotIndex dx dy dFrontX dFrontY driving }
+	 *		path		: 'P' nameLength name vertexCount { dx dy }
+	 *		replan		: 'R' nameLength name vertexCount { dx dy }
+	 *		collision	: 'C' nameLength name
+	 *		index		: 'I' keyFrameCount { 8 byte offset } 8 byte indexOffset "RWRI"
+	 *
+	 * A delta frame is the tick after the previous frame and only contains the robots whose pose changed, the
+	 * robot index refers to the robots of the previous frame. Keyframes contain the full state so decoding may
+	 * start at any keyframe; the pathOffset of a robot is the offset of its latest path or replan record, 0 if none.
+	 * Every keyFrameInterval ticks a keyframe is written for tick n * keyFrameInterval and its offset is stored in
+	 * the index. Keyframes are also written when the set of robots changes, those are not indexed.
+	 *
+	 * The index is written when the recording is closed. A recording without an index, e.g. because the
+	 * application crashed, is still readable: the Replay rebuilds the index by scanning the records.
+	 */
+	namespace RecordingFormat
+	{
+		const std::string magic = "RWRC";
+		const std::string indexMagic = "RWRI";
+		const std::uint64_t version = 1;
+		/**
+		 * The size of the fixed width tail of the index: the offset of the index and the index magic
+		 */
+		const std::size_t trailerSize = 8 + 4;
+
+		enum RecordType : unsigned char
+		{
+			KeyFrame = 'K',
+			DeltaFrame = 'D',
+			PathRecord = 'P',
+			ReplanRecord = 'R',
+			CollisionRecord = 'C',
+			IndexRecord = 'I'
+		};
+		/**
+		 *
+		 */
+		inline std::uint64_t toZigZag( std::int64_t aValue)
+		{
+			return (static_cast< std::uint64_t >( aValue) << 1) ^ static_cast< std::uint64_t >( aValue >> 63);
+		}
+		/**
+		 *
+		 */
+		inline std::int64_t fromZigZag( std::uint64_t aValue)
+		{
+			return static_cast< std::int64_t >( aValue >> 1) ^ -static_cast< std::int64_t >( aValue & 1);
+		}
+		/**
+		 *
+		 */
+		inline void putVarint(	std::string& aBuffer,
+								std::uint64_t aValue)
+		{
+			while (aValue >= 0x80)
+			{
+				aBuffer.push_back( static_cast< char >( (aValue & 0x7F) | 0x80));
+				aValue >>= 7;
+			}
+			aBuffer.push_back( static_cast< char >( aValue));
+		}
+		/**
+		 *
+		 */
+		inline void putSigned(	std::string& aBuffer,
+								std::int64_t aValue)
+		{
+			putVarint( aBuffer, toZigZag( aValue));
+		}
+		/**
+		 *
+		 */
+		inline void putString(	std::string& aBuffer,
+								const std::string& aString)
+		{
+			putVarint( aBuffer, aString.size());
+			aBuffer.append( aString);
+		}
+		/**
+		 * Little endian, fixed width so the index can be read without decoding
+		 */
+		inline void putFixed64(	std::string& aBuffer,
+								std::uint64_t aValue)
+		{
+			for (int i = 0; i < 8; ++i)
+			{
+				aBuffer.push_back( static_cast< char >( (aValue >> (8 * i)) & 0xFF));
+			}
+		}
+		/**
+		 *
+		 */
+		inline std::uint64_t getFixed64( const unsigned char* aBuffer)
+		{
+			std::uint64_t value = 0;
+			for (int i = 0; i < 8; ++i)
+			{
+				value |= static_cast< std::uint64_t >( aBuffer[i]) << (8 * i);
+			}
+			return value;
+		}
+		/**
+		 * Decodes the records of a recording that is in memory. All get functions throw a std::out_of_range
+		 * if the data ends before the value, which happens at the end of a recording that was not closed.
+		 */
+		class Reader
+		{
+			public:
+				/**
+				 *
+				 */
+				Reader(	const unsigned char* aData,
+						std::size_t aSize,
+						std::size_t anOffset = 0) :
+								data( aData),
+								size( aSize),
+								offset( anOffset)
+				{
+				}
+				/**
+				 *
+				 */
+				std::size_t getOffset() const
+				{
+					return offset;
+				}
+				/**
+				 *
+				 */
+				void setOffset( std::size_t anOffset)
+				{
+					offset = anOffset;
+				}
+				/**
+				 *
+				 */
+				bool atEnd() const
+				{
+					return offset >= size;
+				}
+				/**
+				 *
+				 */
+				unsigned char getByte()
+				{
+					if (offset >= size)
+					{
+						throw std::out_of_range( "Unexpected end of recording");
+					}
+					return data[offset++];
+				}
+				/**
+				 *
+				 */
+				std::uint64_t getVarint()
+				{
+					std::uint64_t value = 0;
+					for (unsigned shift = 0; shift < 64; shift += 7)
+					{
+						unsigned char byte = getByte();
+						value |= static_cast< std::uint64_t >( byte & 0x7F) << shift;
+						if ((byte & 0x80) == 0)
+						{
+							return value;
+						}
+					}
+					throw std::out_of_range( "Invalid varint in recording");
+				}
+				/**
+				 *
+				 */
+				std::int64_t getSigned()
+				{
+					return fromZigZag( getVarint());
+				}
+				/**
+				 *
+				 */
+				std::string getString()
+				{
+					std::uint64_t length = getVarint();
+					if (length > size - offset)
+					{
+						throw std::out_of_range( "Unexpected end of recording");
+					}
+					std::string result( reinterpret_cast< const char* >( data + offset), length);
+					offset += length;
+					return result;
+				}
+
+			private:
+				const unsigned char* data;
+				std::size_t size;
+				std::size_t offset;
+		};
+		//	class Reader
+	} // namespace RecordingFormat
+} // namespace Model
+
+#endif // RECORDINGFORMAT_HPP_
@@ -71,10 +71,10 @@ namespace View
 	/**
 	 *
 	 */
-	void RectangleShape::draw( wxDC& dc)
+	void RectangleShape::draw( Renderer& renderer)
 	{
 		// The minimum size of the RectangleShape is the size of the title
-		titleSize = dc.GetTextExtent( title);
+		titleSize = renderer.getTextExtent( title);
 		if (size.x < (titleSize.x + 2 * spacing + 2 * borderWidth))
 		{
 			size.x = titleSize.x + 2 * spacing + 2 * borderWidth;
@@ -84,21 +84,21 @@ namespace View
 			size.y = titleSize.y + 2 * spacing + 2 * borderWidth;
 		}
 		// Draws a rectangle with the given top left corner, and with the given size.
-		dc.SetBrush( *wxWHITE_BRUSH);
+		renderer.setBrush( Colour( "WHITE"));
 		if (isSelected())
 		{
-			dc.SetPen( wxPen(  getSelectionColour(), borderWidth, wxPENSTYLE_SOLID));
+			renderer.setPen( getSelectionColour(), borderWidth);
 		} else
 		{
-			dc.SetPen( wxPen(  getNormalColour(), borderWidth, wxPENSTYLE_SOLID));
+			renderer.setPen( getNormalColour(), borderWidth);
 		}
 
 		int x = centre.x - (size.x / 2);
 		int y = centre.y - (size.y / 2);
-		dc.DrawRectangle( x, y, size.x, size.y);
+		renderer.drawRectangle( wxRect( x, y, size.x, size.y));
 
-		dc.SetPen( wxPen(  "BLACK", borderWidth, wxPENSTYLE_SOLID));
-		dc.DrawText( title, centre.x - titleSize.x / 2, y + spacing + borderWidth);
+		renderer.setPen( "BLACK", borderWidth);
+		renderer.drawText( title, wxPoint( centre.x - titleSize.x / 2, y + spacing + borderWidth));
 	}
 	/**
 	 *
@@ -127,6 +127,14 @@ namespace View
 
 		return Utils::Shape2DUtils::isOnLine( rectanglePoints, 4, aPoint, aRadius + borderWidth);
 	}
+	/**
+	 *
+	 */
+	wxRect RectangleShape::getBoundingBox() const
+	{
+		// The border is drawn centred on the edge of the rectangle
+		return wxRect( centre.x - (size.x / 2) - borderWidth, centre.y - (size.y / 2) - borderWidth, size.x + 2 * borderWidth + 1, size.y + 2 * borderWidth + 1);
+	}
 	/**
 	 *
 	 */
@@ -52,7 +52,7 @@ namespace View
 			 * A Notifier will call this function if this Observer will handle the notifications of that
 			 * Notifier. It is the responsibility of the Observer to filter any events it is interested in.
 			 */
-			virtual void handleNotification() override {}
+			virtual void handleNotification( const Base::Notification& UNUSEDPARAM(aNotification)) override {}
 			//@}
 			/**
 			 * @name Pure virtual abstract Shape functions
@@ -61,7 +61,7 @@ namespace View
 			/**
 			 *
 			 */
-			virtual void draw( wxDC& dc) override;
+			virtual void draw( Renderer& renderer) override;
 			/**
 			 *
 			 * @param aPoint
@@ -83,6 +83,10 @@ namespace View
 			 *
 			 */
 			virtual void setCentre( const wxPoint& aPoint) override;
+			/**
+			 *
+			 */
+			virtual wxRect getBoundingBox() const override;
 			/**
 			 *
 			 */
@@ -90,21 +94,21 @@ namespace View
 			/**
 			 *
 			 */
-			virtual wxColour getNormalColour() const
+			virtual Colour getNormalColour() const
 			{
 				return "BLACK";
 			}
 			/**
 			 *
 			 */
-			virtual wxColour getSelectionColour() const
+			virtual Colour getSelectionColour() const
 			{
 				return "RED";
 			}
 			/**
 			 *
 			 */
-			virtual wxColour getActivationColour() const
+			virtual Colour getActivationColour() const
 			{
 				return "BLUE";
 			}
@@ -0,0 +1,55 @@
+#include "Renderer.hpp"
+
+#include <cstring>
+
+namespace View
+{
+	namespace
+	{
+		/**
+		 * The colours of the wxWidgets colour database that the shapes use
+		 */
+		struct NamedColour
+		{
+				const char* name;
+				unsigned char red;
+				unsigned char green;
+				unsigned char blue;
+		};
+		//	struct NamedColour
+
+		const NamedColour namedColours[] = {	{ "BLACK", 0, 0, 0},
+												{ "BLUE", 0, 0, 255},
+												{ "CYAN", 0, 255, 255},
+												{ "GREEN", 0, 255, 0},
+												{ "GREY", 128, 128, 128},
+												{ "INDIAN RED", 79, 47, 79},
+												{ "LIGHT GREY", 192, 192, 192},
+												{ "MAGENTA", 255, 0, 255},
+												{ "ORANGE", 204, 50, 50},
+												{ "PALE GREEN", 143, 188, 143},
+												{ "RED", 255, 0, 0},
+												{ "WHITE", 255, 255, 255},
+												{ "YELLOW", 255, 255, 0}};
+	} // namespace
+
+	/**
+	 *
+	 */
+	Colour::Colour( const char* aName) :
+						red( 0),
+						green( 0),
+						blue( 0)
+	{
+		for (const NamedColour& namedColour : namedColours)
+		{
+			if (std::strcmp( namedColour.name, aName) == 0)
+			{
+				red = namedColour.red;
+				green = namedColour.green;
+				blue = namedColour.blue;
+				break;
+			}
+		}
+	}
+} // namespace View
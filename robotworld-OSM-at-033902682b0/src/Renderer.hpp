@@ -0,0 +1,127 @@
+#ifndef RENDERER_HPP_
+#define RENDERER_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+#include "Size.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace View
+{
+	/**
+	 * A colour for a Renderer. Unlike wxColour it needs no wxApp or colour database, so a Renderer can be used
+	 * without the GUI.
+	 */
+	struct Colour
+	{
+			/**
+			 *
+			 */
+			Colour(	unsigned char aRed,
+					unsigned char aGreen,
+					unsigned char aBlue) :
+						red( aRed),
+						green( aGreen),
+						blue( aBlue)
+			{
+			}
+			/**
+			 * Not explicit so the shapes can pass a colour by its name, e.g. setPen( "RED", 1)
+			 *
+			 * @param aName A name of the wxWidgets colour database, with the same red, green and blue. A name that
+			 * is not known gives black.
+			 */
+			Colour( const char* aName);
+
+			unsigned char red;
+			unsigned char green;
+			unsigned char blue;
+	};
+	//	struct Colour
+
+	/**
+	 * The drawing commands the Shapes use to draw themselves.
+	 *
+	 * The pen is used for lines, points and the outline of filled figures, the brush for the inside of filled
+	 * figures. All coordinates are logical coordinates of the canvas. The points, sizes and rectangles are those of
+	 * the model, see Point.hpp, the Renderer itself does not depend on the GUI.
+	 *
+	 * @see WxDCRenderer for drawing on the screen
+	 * @see SoftwareRenderer for drawing without a display
+	 */
+	class Renderer
+	{
+		public:
+			/**
+			 *
+			 */
+			virtual ~Renderer() = default;
+			/**
+			 * Sets a solid pen of aWidth pixels
+			 */
+			virtual void setPen(	const Colour& aColour,
+									int aWidth) = 0;
+			/**
+			 * Sets a solid brush
+			 */
+			virtual void setBrush( const Colour& aColour) = 0;
+			/**
+			 *
+			 */
+			virtual void drawPoint( const wxPoint& aPoint) = 0;
+			/**
+			 *
+			 */
+			virtual void drawLine(	const wxPoint& aBegin,
+									const wxPoint& anEnd) = 0;
+			/**
+			 * Draws the connected line segments through aPoints
+			 */
+			virtual void drawLines(	std::size_t aNumberOfPoints,
+									const wxPoint aPoints[]) = 0;
+			/**
+			 * Draws a closed polygon filled with the brush
+			 */
+			virtual void drawPolygon(	std::size_t aNumberOfPoints,
+										const wxPoint aPoints[]) = 0;
+			/**
+			 * Draws a rectangle filled with the brush
+			 */
+			virtual void drawRectangle( const wxRect& aRectangle) = 0;
+			/**
+			 * Draws a circle filled with the brush
+			 */
+			virtual void drawCircle(	const wxPoint& aCentre,
+										int aRadius) = 0;
+			/**
+			 *
+			 * @param aTopLeft The top left corner of the text
+			 */
+			virtual void drawText(	const std::string& aText,
+									const wxPoint& aTopLeft) = 0;
+			/**
+			 *
+			 * @param aTopLeft The top left corner of the text before the rotation
+			 * @param anAngle The rotation around aTopLeft in degrees, counter clockwise
+			 */
+			virtual void drawRotatedText(	const std::string& aText,
+											const wxPoint& aTopLeft,
+											double anAngle) = 0;
+			/**
+			 *
+			 * @return the size of aText when it is drawn
+			 */
+			virtual wxSize getTextExtent( const std::string& aText) const = 0;
+			/**
+			 *
+			 * @return the number of pixels per logical unit
+			 */
+			virtual double getScale() const = 0;
+	};
+	//	class Renderer
+} // namespace View
+
+#endif // RENDERER_HPP_
@@ -0,0 +1,396 @@
+#include "Replay.hpp"
+
+#include "BoundedVector.hpp"
+#include "Logger.hpp"
+#include "RecordingFormat.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace Model
+{
+	namespace
+	{
+		/**
+		 *
+		 */
+		PathAlgorithm::Path readPath( RecordingFormat::Reader& aReader)
+		{
+			PathAlgorithm::Path path;
+			std::uint64_t vertexCount = aReader.getVarint();
+			int x = 0;
+			int y = 0;
+			for (std::uint64_t i = 0; i < vertexCount; ++i)
+			{
+				x += static_cast< int >( aReader.getSigned());
+				y += static_cast< int >( aReader.getSigned());
+				path.push_back( PathAlgorithm::Vertex( x, y));
+			}
+			return path;
+		}
+	} // namespace
+
+	/**
+	 *
+	 */
+	/* static */Replay& Replay::getReplay()
+	{
+		static Replay replay;
+		return replay;
+	}
+	/**
+	 *
+	 */
+	Replay::Replay() :
+						data( nullptr),
+						size( 0),
+						recordsSize( 0),
+						firstRecordOffset( 0),
+						keyFrameInterval( 1),
+						tickCount( 0),
+						tick( 0),
+						offset( 0),
+						frameOffset( 0),
+						playing( false)
+	{
+	}
+	/**
+	 *
+	 */
+	Replay::~Replay()
+	{
+		close();
+	}
+	/**
+	 *
+	 */
+	void Replay::open( const std::string& aFileName)
+	{
+		close();
+
+		file = boost::interprocess::file_mapping( aFileName.c_str(), boost::interprocess::read_only);
+		region = boost::interprocess::mapped_region( file, boost::interprocess::read_only);
+		data = static_cast< const unsigned char* >( region.get_address());
+		size = region.get_size();
+
+		const std::string& magic = RecordingFormat::magic;
+		if (size < magic.size() || std::memcmp( data, magic.data(), magic.size()) != 0)
+		{
+			close();
+			throw std::runtime_error( aFileName + " is not a recording");
+		}
+		RecordingFormat::Reader reader( data, size, magic.size());
+		if (reader.getVarint() != RecordingFormat::version)
+		{
+			close();
+			throw std::runtime_error( aFileName + " has an unsupported recording version");
+		}
+		keyFrameInterval = std::max( reader.getVarint(), static_cast< std::uint64_t >( 1));
+		firstRecordOffset = reader.getOffset();
+
+		const std::string& indexMagic = RecordingFormat::indexMagic;
+		bool indexed = size >= firstRecordOffset + RecordingFormat::trailerSize
+		        && std::memcmp( data + size - indexMagic.size(), indexMagic.data(), indexMagic.size()) == 0;
+		if (indexed)
+		{
+			std::uint64_t indexOffset = RecordingFormat::getFixed64( data + size - RecordingFormat::trailerSize);
+			reader.setOffset( indexOffset);
+			if (reader.getByte() != RecordingFormat::IndexRecord)
+			{
+				close();
+				throw std::runtime_error( aFileName + " has an invalid keyframe index");
+			}
+			std::uint64_t keyFrameCount = reader.getVarint();
+			if (reader.getOffset() + keyFrameCount * 8 + RecordingFormat::trailerSize > size)
+			{
+				close();
+				throw std::runtime_error( aFileName + " has an invalid keyframe index");
+			}
+			for (std::uint64_t i = 0; i < keyFrameCount; ++i)
+			{
+				keyFrameOffsets.push_back( RecordingFormat::getFixed64( data + reader.getOffset() + i * 8));
+			}
+			recordsSize = indexOffset;
+			// Only the ticks after the last keyframe must be counted
+			scan( keyFrameOffsets.empty() ? firstRecordOffset : keyFrameOffsets.back());
+		} else
+		{
+			TRACE_DEVELOP( aFileName + " has no keyframe index, scanning the recording");
+			recordsSize = size;
+			scan( firstRecordOffset);
+		}
+
+		TRACE_DEVELOP( "Opened recording " + aFileName + " with " + std::to_string( tickCount) + " ticks");
+
+		seek( 0);
+	}
+	/**
+	 *
+	 */
+	void Replay::close()
+	{
+		stop();
+
+		region = boost::interprocess::mapped_region();
+		file = boost::interprocess::file_mapping();
+		data = nullptr;
+		size = 0;
+		recordsSize = 0;
+		keyFrameOffsets.clear();
+		tickCount = 0;
+		tick = 0;
+		offset = 0;
+		robotStates.clear();
+	}
+	/**
+	 *
+	 */
+	void Replay::seek( unsigned long aTick)
+	{
+		if (tickCount == 0)
+		{
+			return;
+		}
+		aTick = std::min( aTick, tickCount - 1);
+
+		// The keyframe of tick n * keyFrameInterval is the n-th entry of the index
+		std::size_t keyFrame = std::min( static_cast< std::size_t >( aTick / keyFrameInterval), keyFrameOffsets.size() - 1);
+		offset = keyFrameOffsets[keyFrame];
+		robotStates.clear();
+		decodeFrame();
+		while (tick < aTick && decodeFrame())
+		{
+		}
+	}
+	/**
+	 *
+	 */
+	bool Replay::next()
+	{
+		if (tick + 1 >= tickCount)
+		{
+			return false;
+		}
+		return decodeFrame();
+	}
+	/**
+	 *
+	 */
+	void Replay::apply()
+	{
+		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
+		bool newRobots = false;
+		for (const RobotState& robotState : robotStates)
+		{
+			RobotPtr robot = robotWorld.getRobot( robotState.name);
+			if (!robot)
+			{
+				robot = robotWorld.newRobot( robotState.name, robotState.position, false);
+				newRobots = true;
+			}
+			robot->setSize( robotState.size, false);
+			robot->setPosition( robotState.position, false);
+			robot->setFront( BoundedVector( robotState.front.x, robotState.front.y), false);
+			robot->setPath( robotState.path, false);
+			robot->notifyObservers();
+		}
+		if (newRobots)
+		{
+			robotWorld.notifyObservers( Base::Notification::ObjectsCreated);
+		}
+	}
+	/**
+	 *
+	 */
+	void Replay::play(	unsigned long aTick,
+						double aSpeed)
+	{
+		stop();
+
+		seek( aTick);
+		apply();
+
+		std::chrono::microseconds tickDuration( static_cast< long >( 100000 / std::max( aSpeed, 0.001))); // @suppress("Avoid magic numbers")
+
+		playing = true;
+		std::thread newReplayThread( [this, tickDuration]
+		{
+			try
+			{
+				while (playing && next())
+				{
+					apply();
+					std::this_thread::sleep_for( tickDuration);
+				}
+			}
+			catch (std::exception& e)
+			{
+				Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": ") + e.what());
+			}
+			catch (...)
+			{
+				Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": unknown exception"));
+			}
+			playing = false;
+			TRACE_DEVELOP( "Replay stopped at tick " + std::to_string( tick));
+		});
+		replayThread.swap( newReplayThread);
+	}
+	/**
+	 *
+	 */
+	void Replay::stop()
+	{
+		playing = false;
+		if (replayThread.joinable() && replayThread.get_id() != std::this_thread::get_id())
+		{
+			replayThread.join();
+		}
+	}
+	/**
+	 *
+	 */
+	bool Replay::decodeFrame()
+	{
+		RecordingFormat::Reader reader( data, recordsSize, offset);
+		try
+		{
+			while (!reader.atEnd())
+			{
+				std::size_t recordOffset = reader.getOffset();
+				unsigned char recordType = reader.getByte();
+				switch (recordType)
+				{
+					case RecordingFormat::PathRecord:
+					case RecordingFormat::ReplanRecord:
+					{
+						std::string name = reader.getString();
+						PathAlgorithm::Path path = readPath( reader);
+						for (RobotState& robotState : robotStates)
+						{
+							if (robotState.name == name)
+							{
+								robotState.path.swap( path);
+							}
+						}
+						if (recordType == RecordingFormat::ReplanRecord)
+						{
+							TRACE_DEVELOP( "Replay tick " + std::to_string( tick) + ": " + name + " replanned");
+						}
+						break;
+					}
+					case RecordingFormat::CollisionRecord:
+					{
+						std::string name = reader.getString();
+						TRACE_DEVELOP( "Replay tick " + std::to_string( tick) + ": " + name + " collided");
+						break;
+					}
+					case RecordingFormat::KeyFrame:
+					{
+						unsigned long keyFrameTick = reader.getVarint();
+						std::uint64_t robotCount = reader.getVarint();
+						std::vector< RobotState > keyFrameStates;
+						for (std::uint64_t i = 0; i < robotCount; ++i)
+						{
+							RobotState robotState;
+							robotState.name = reader.getString();
+							robotState.size.x = static_cast< int >( reader.getSigned());
+							robotState.size.y = static_cast< int >( reader.getSigned());
+							robotState.position.x = static_cast< int >( reader.getSigned());
+							robotState.position.y = static_cast< int >( reader.getSigned());
+							robotState.front.x = static_cast< int >( reader.getSigned());
+							robotState.front.y = static_cast< int >( reader.getSigned());
+							robotState.driving = reader.getByte() != 0;
+							std::uint64_t pathOffset = reader.getVarint();
+							if (pathOffset != 0)
+							{
+								robotState.path = decodePath( pathOffset);
+							}
+							keyFrameStates.push_back( robotState);
+						}
+						robotStates.swap( keyFrameStates);
+						tick = keyFrameTick;
+						offset = reader.getOffset();
+						frameOffset = recordOffset;
+						return true;
+					}
+					case RecordingFormat::DeltaFrame:
+					{
+						// Decode into a copy so a truncated frame leaves the current state intact
+						std::vector< RobotState > deltaStates = robotStates;
+						std::uint64_t robotCount = reader.getVarint();
+						for (std::uint64_t i = 0; i < robotCount; ++i)
+						{
+							std::uint64_t robotIndex = reader.getVarint();
+							if (robotIndex >= deltaStates.size())
+							{
+								throw std::runtime_error( "Invalid robot index in recording at offset " + std::to_string( recordOffset));
+							}
+							RobotState& robotState = deltaStates[robotIndex];
+							robotState.position.x += static_cast< int >( reader.getSigned());
+							robotState.position.y += static_cast< int >( reader.getSigned());
+							robotState.front.x += static_cast< int >( reader.getSigned());
+							robotState.front.y += static_cast< int >( reader.getSigned());
+							robotState.driving = reader.getByte() != 0;
+						}
+						robotStates.swap( deltaStates);
+						++tick;
+						offset = reader.getOffset();
+						frameOffset = recordOffset;
+						return true;
+					}
+					case RecordingFormat::IndexRecord:
+					{
+						// An index without a trailer, the recording was truncated while it was closed
+						return false;
+					}
+					default:
+					{
+						throw std::runtime_error( "Invalid record type in recording at offset " + std::to_string( recordOffset));
+					}
+				}
+			}
+		}
+		catch (std::out_of_range&)
+		{
+			// The last record of a recording that was not closed may be incomplete
+		}
+		return false;
+	}
+	/**
+	 *
+	 */
+	void Replay::scan( std::uint64_t anOffset)
+	{
+		offset = anOffset;
+		while (decodeFrame())
+		{
+			if (tick % keyFrameInterval == 0 && (keyFrameOffsets.empty() || frameOffset > keyFrameOffsets.back()))
+			{
+				keyFrameOffsets.push_back( frameOffset);
+			}
+			tickCount = tick + 1;
+		}
+		// Anything after the last complete frame is ignored
+		recordsSize = offset;
+	}
+	/**
+	 *
+	 */
+	PathAlgorithm::Path Replay::decodePath( std::uint64_t anOffset) const
+	{
+		RecordingFormat::Reader reader( data, recordsSize, anOffset);
+		unsigned char recordType = reader.getByte();
+		if (recordType != RecordingFormat::PathRecord && recordType != RecordingFormat::ReplanRecord)
+		{
+			throw std::runtime_error( "Invalid path offset in recording: " + std::to_string( anOffset));
+		}
+		reader.getString();
+		return readPath( reader);
+	}
+} // namespace Model
@@ -0,0 +1,167 @@
+#ifndef REPLAY_HPP_
+#define REPLAY_HPP_
+
+#include "Config.hpp"
+
+#include "AStar.hpp"
+#include "Point.hpp"
+#include "Size.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Model
+{
+	/**
+	 * Replays a recording of the Recorder, enabled with the command line argument -replay=file. The speed
+	 * is given with -replayspeed=factor (default 1) and the first tick with -replaystart=tick.
+	 *
+	 * The recording is memory mapped. Seeking to a tick starts decoding at the indexed keyframe at or before
+	 * that tick, so the cost of a seek is bounded by the keyframe interval and independent of the length of the
+	 * recording.
+	 */
+	class Replay
+	{
+		public:
+			/**
+			 * The state of a robot at the current tick
+			 */
+			struct RobotState
+			{
+					std::string name;
+					wxSize size;
+					wxPoint position;
+					wxPoint front;
+					bool driving;
+					PathAlgorithm::Path path;
+			};
+			/**
+			 *
+			 */
+			static Replay& getReplay();
+			/**
+			 * Maps aFileName and reads the keyframe index. If the recording has no index because it was not closed
+			 * the index is rebuilt by scanning the recording.
+			 */
+			void open( const std::string& aFileName);
+			/**
+			 *
+			 */
+			void close();
+			/**
+			 *
+			 */
+			bool isOpen() const
+			{
+				return data != nullptr;
+			}
+			/**
+			 *
+			 * @return the number of ticks in the recording
+			 */
+			unsigned long getTickCount() const
+			{
+				return tickCount;
+			}
+			/**
+			 *
+			 * @return the tick of the current state
+			 */
+			unsigned long getTick() const
+			{
+				return tick;
+			}
+			/**
+			 * Decodes the state at aTick, which is clamped to the last tick of the recording
+			 */
+			void seek( unsigned long aTick);
+			/**
+			 * Decodes the state at the next tick
+			 *
+			 * @return false if the end of the recording was reached
+			 */
+			bool next();
+			/**
+			 *
+			 */
+			const std::vector< RobotState >& getRobotStates() const
+			{
+				return robotStates;
+			}
+			/**
+			 * Shows the current state in the RobotWorld, creating the robots that do not exist
+			 */
+			void apply();
+			/**
+			 * Plays the recording from aTick in its own thread
+			 *
+			 * @param aSpeed The factor relative to the real time of 100 ms per tick
+			 */
+			void play(	unsigned long aTick,
+						double aSpeed);
+			/**
+			 *
+			 */
+			void stop();
+
+		protected:
+			/**
+			 *
+			 */
+			Replay();
+			/**
+			 *
+			 */
+			virtual ~Replay();
+			/**
+			 * Decodes records from the current offset up to and including the next frame
+			 *
+			 * @return false if there is no next frame
+			 */
+			bool decodeFrame();
+			/**
+			 * Scans the records from anOffset, which must be the offset of a keyframe, to the end. Adds the offsets
+			 * of the indexed keyframes that are not in the index yet and counts the ticks.
+			 */
+			void scan( std::uint64_t anOffset);
+			/**
+			 *
+			 */
+			PathAlgorithm::Path decodePath( std::uint64_t anOffset) const;
+
+		private:
+			boost::interprocess::file_mapping file;
+			boost::interprocess::mapped_region region;
+			const unsigned char* data;
+			std::size_t size;
+			/**
+			 * The size without the index, i.e. the end of the records
+			 */
+			std::size_t recordsSize;
+			std::size_t firstRecordOffset;
+
+			unsigned long keyFrameInterval;
+			std::vector< std::uint64_t > keyFrameOffsets;
+			unsigned long tickCount;
+
+			unsigned long tick;
+			std::size_t offset;
+			/**
+			 * The offset of the frame of the current tick
+			 */
+			std::size_t frameOffset;
+			std::vector< RobotState > robotStates;
+
+			std::thread replayThread;
+			std::atomic< bool > playing;
+	};
+	//	class Replay
+} // namespace Model
+
+#endif // REPLAY_HPP_
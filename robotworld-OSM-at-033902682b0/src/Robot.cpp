@@ -8,12 +8,16 @@
 #include "MathUtils.hpp"
 #include "Message.hpp"
 #include "MessageTypes.hpp"
+#include "Recorder.hpp"
 #include "RobotWorld.hpp"
 #include "Server.hpp"
 #include "Shape2DUtils.hpp"
+#include "Shard.hpp"
+#include "Simulation.hpp"
 #include "Wall.hpp"
 #include "WayPoint.hpp"
 
+#include <charconv>
 #include <chrono>
 #include <ctime>
 #include <sstream>
@@ -42,6 +46,9 @@ namespace Model
 	{
 		// We use the real position for starters, not an estimated position.
 		startPosition = position;
+		updatePose();
+		publishState();
+		publishPath();
 	}
 	/**
 	 *
@@ -67,10 +74,12 @@ namespace Model
 	void Robot::setName(const std::string& aName,
 	        bool aNotifyObservers /*= true*/)
 	{
+		std::string oldName = name;
 		name = aName;
+		RobotWorld::getRobotWorld().updateNameIndex(getObjectId(), oldName);
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::AttributesChanged);
 		}
 	}
 	/**
@@ -86,9 +95,11 @@ namespace Model
 	void Robot::setSize(const wxSize& aSize, bool aNotifyObservers /*= true*/)
 	{
 		size = aSize;
+		updatePose();
+		publishState();
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::AttributesChanged);
 		}
 	}
 	/**
@@ -98,9 +109,12 @@ namespace Model
 	        bool aNotifyObservers /*= true*/)
 	{
 		position = aPosition;
+		updatePose();
+		publishState();
+		RobotWorld::getRobotWorld().getChangeJournal().record(Change::EntityMoved, Change::RobotEntity, getObjectId());
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::PositionChanged);
 		}
 	}
 	/**
@@ -117,9 +131,11 @@ namespace Model
 	        bool aNotifyObservers /*= true*/)
 	{
 		front = aVector;
+		updatePose();
+		publishState();
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::PositionChanged);
 		}
 	}
 	/**
@@ -137,7 +153,20 @@ namespace Model
 		speed = aNewSpeed;
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::AttributesChanged);
+		}
+	}
+	/**
+	 *
+	 */
+	void Robot::setPath(const PathAlgorithm::Path& aPath,
+	        bool aNotifyObservers /*= true*/)
+	{
+		path = aPath;
+		publishPath();
+		if (aNotifyObservers == true)
+		{
+			notifyObservers(Base::Notification::PathChanged);
 		}
 	}
 	/**
@@ -145,7 +174,18 @@ namespace Model
 	 */
 	void Robot::startActing()
 	{
+		// A ghost only mirrors a robot of another shard
+		if (Shard::getShard().isGhost(name))
+		{
+			return;
+		}
 		acting = true;
+		publishState();
+		// In lockstep the robot is started and stepped by the tick loop of the simulation
+		if (Simulation::getSimulation().isLockstep())
+		{
+			return;
+		}
 		std::thread newRobotThread([this]
 		{
 			startDriving();
@@ -159,14 +199,36 @@ namespace Model
 	{
 		acting = false;
 		driving = false;
-		robotThread.join();
+		publishState();
+		// The robot may stop itself from its own thread on arrival or collision
+		if (robotThread.joinable() && robotThread.get_id() != std::this_thread::get_id())
+		{
+			robotThread.join();
+		}
 	}
 	/**
 	 *
 	 */
 	void Robot::startDriving()
+	{
+		beginDriving();
+
+		calculateRoute(goal, true);
+
+		prepareDriving();
+
+		if (!Simulation::getSimulation().isLockstep())
+		{
+			drive();
+		}
+	}
+	/**
+	 *
+	 */
+	void Robot::beginDriving()
 	{
 		driving = true;
+		publishState();
 
 		if (this == RobotWorld::getRobotWorld().getLocalRobot().get())
 		{
@@ -175,9 +237,6 @@ namespace Model
 		{
 			goal = RobotWorld::getRobotWorld().getGoal("PeerGoal");
 		}
-		calculateRoute(goal, true);
-
-		drive();
 	}
 	/**
 	 *
@@ -185,6 +244,7 @@ namespace Model
 	void Robot::stopDriving()
 	{
 		driving = false;
+		publishState();
 	}
 	/**
 	 *
@@ -203,6 +263,9 @@ namespace Model
 		{
 			localPort =
 			        Application::MainApplication::getArg("-local_port").value;
+		} else if (Shard::getShard().isSharded())
+		{
+			localPort = std::to_string(Shard::getShard().getPort(Shard::getShard().getIndex()));
 		}
 
 		if (Messaging::CommunicationService::getCommunicationService().isStopped())
@@ -234,6 +297,9 @@ namespace Model
 		{
 			localPort =
 			        Application::MainApplication::getArg("-local_port").value;
+		} else if (Shard::getShard().isSharded())
+		{
+			localPort = std::to_string(Shard::getShard().getPort(Shard::getShard().getIndex()));
 		}
 
 		Messaging::CommunicationService::getCommunicationService().stopServer(
@@ -267,9 +333,7 @@ namespace Model
 	 */
 	wxRegion Robot::getRegion() const
 	{
-		wxPoint translatedPoints[] =
-		{getFrontRight(), getFrontLeft(), getBackLeft(), getBackRight()};
-		return wxRegion(4, translatedPoints);    // @suppress("Avoid magic numbers")
+		return wxRegion(corners.size(), corners.data());
 	}
 	/**
 	 *
@@ -283,113 +347,10 @@ namespace Model
 	/**
 	 *
 	 */
-	wxPoint Robot::getFrontLeft() const
-	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		wxPoint originalFrontLeft(x, y);
-		double angle = Utils::Shape2DUtils::getAngle(front) + 0.5 * Utils::PI;
-
-		wxPoint frontLeft(
-		        static_cast<int>((originalFrontLeft.x - position.x)
-		                * std::cos(angle)
-		                - (originalFrontLeft.y - position.y) * std::sin(angle)
-		                + position.x),
-		        static_cast<int>((originalFrontLeft.y - position.y)
-		                * std::cos(angle)
-		                + (originalFrontLeft.x - position.x) * std::sin(angle)
-		                + position.y));
-
-		return frontLeft;
-	}
-	/**
-	 *
-	 */
-	wxPoint Robot::getFrontRight() const
+	void Robot::handleNotification(const Base::Notification& aNotification)
 	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		wxPoint originalFrontRight(x + size.x, y);
-		double angle = Utils::Shape2DUtils::getAngle(front) + 0.5 * Utils::PI;
-
-		wxPoint frontRight(
-		        static_cast<int>((originalFrontRight.x - position.x)
-		                * std::cos(angle)
-		                - (originalFrontRight.y - position.y) * std::sin(angle)
-		                + position.x),
-		        static_cast<int>((originalFrontRight.y - position.y)
-		                * std::cos(angle)
-		                + (originalFrontRight.x - position.x) * std::sin(angle)
-		                + position.y));
-
-		return frontRight;
-	}
-	/**
-	 *
-	 */
-	wxPoint Robot::getBackLeft() const
-	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		wxPoint originalBackLeft(x, y + size.y);
-
-		double angle = Utils::Shape2DUtils::getAngle(front) + 0.5 * Utils::PI;
-
-		wxPoint backLeft(
-		        static_cast<int>((originalBackLeft.x - position.x)
-		                * std::cos(angle)
-		                - (originalBackLeft.y - position.y) * std::sin(angle)
-		                + position.x),
-		        static_cast<int>((originalBackLeft.y - position.y)
-		                * std::cos(angle)
-		                + (originalBackLeft.x - position.x) * std::sin(angle)
-		                + position.y));
-
-		return backLeft;
-	}
-	/**
-	 *
-	 */
-	wxPoint Robot::getBackRight() const
-	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		wxPoint originalBackRight(x + size.x, y + size.y);
-
-		double angle = Utils::Shape2DUtils::getAngle(front) + 0.5 * Utils::PI;
-
-		wxPoint backRight(
-		        static_cast<int>((originalBackRight.x - position.x)
-		                * std::cos(angle)
-		                - (originalBackRight.y - position.y) * std::sin(angle)
-		                + position.x),
-		        static_cast<int>((originalBackRight.y - position.y)
-		                * std::cos(angle)
-		                + (originalBackRight.x - position.x) * std::sin(angle)
-		                + position.y));
-
-		return backRight;
-	}
-	/**
-	 *
-	 */
-	void Robot::handleNotification()
-	{
-		//	std::unique_lock<std::recursive_mutex> lock(robotMutex);
-
-		static int update = 0;
-		if ((++update % 200) == 0)    // @suppress("Avoid magic numbers")
-		{
-			notifyObservers();
-		}
+		// Bursts are coalesced by the NotificationDispatcher
+		notifyObservers(aNotification.getTopics());
 	}
 
 	void handlePopulateRequest(Messaging::Message& aMessage)
@@ -404,14 +365,33 @@ namespace Model
 
 	void handleStartRequest(Messaging::Message& aMessage)
 	{
+		// A peer that is not in lockstep sends no seed, starting without one would let the nodes diverge
+		std::uint64_t seed = 0;
+		const std::string& body = aMessage.getBody();
+		std::from_chars_result result = std::from_chars(body.data(), body.data() + body.size(), seed);
+		bool validSeed = !body.empty() && result.ec == std::errc() && result.ptr == body.data() + body.size();
+		if (Simulation::getSimulation().isLockstep() && !validSeed)
+		{
+			Application::Logger::log(__PRETTY_FUNCTION__ + std::string(": the peer sent no valid seed, is it in lockstep mode?"));
+			aMessage.setMessageType(Messaging::StartResponse);
+			aMessage.setBody("Messaging::StartResponse: no valid seed, not started");
+			return;
+		}
+
+		// Robot 0 has right of way, after the reverse that is the robot of the requester on both nodes
 		Model::RobotWorld::getRobotWorld().reverseRobotVector();
-		for (Model::RobotPtr robot : Model::RobotWorld::getRobotWorld().getRobots())
+		Model::WorldSnapshotPtr world = Model::RobotWorld::getRobotWorld().getSnapshot();
+		for (const Model::RobotPtr& robot : *world->robots)
 		{
 			if (!robot->isActing())
 			{
 				robot->startActing();
 			}
 		}
+		if (Simulation::getSimulation().isLockstep())
+		{
+			Simulation::getSimulation().start(seed);
+		}
 		TRACE_DEVELOP("Started Robots");
 		aMessage.setMessageType(Messaging::StartResponse);
 		aMessage.setBody("Messaging::StartResponse");
@@ -420,7 +400,8 @@ namespace Model
 	void handleStopRequest(Messaging::Message& aMessage)
 	{
 		RobotPtr robot = RobotWorld::getRobotWorld().getRobot("Peer");
-		if (robot && robot->isActing())
+		// In lockstep the stop is part of the input of a tick of the peer
+		if (robot && robot->isActing() && !Simulation::getSimulation().isLockstep())
 		{
 			robot->stopActing();
 			TRACE_DEVELOP("Stopped Peer Robot");
@@ -460,6 +441,21 @@ namespace Model
 				handleStopRequest(aMessage);
 				break;
 			}
+			case Messaging::TickRequest:
+			{
+				Simulation::getSimulation().handleTickRequest(aMessage);
+				break;
+			}
+			case Messaging::HandoffRequest:
+			{
+				Shard::getShard().handleHandoffRequest(aMessage);
+				break;
+			}
+			case Messaging::GhostRequest:
+			{
+				Shard::getShard().handleGhostRequest(aMessage);
+				break;
+			}
 			default:
 			{
 				TRACE_DEVELOP(
@@ -490,6 +486,19 @@ namespace Model
 			{
 				break;
 			}
+			case Messaging::TickResponse:
+			{
+				break;
+			}
+			case Messaging::HandoffResponse:
+			{
+				Shard::getShard().handleHandoffResponse(aMessage);
+				break;
+			}
+			case Messaging::GhostResponse:
+			{
+				break;
+			}
 			default:
 			{
 				TRACE_DEVELOP(
@@ -532,8 +541,14 @@ namespace Model
 				this == RobotWorld::getRobotWorld().getLocalRobot().get() ?
 						RobotWorld::getRobotWorld().getRobot("Peer") :
 						RobotWorld::getRobotWorld().getLocalRobot();
-		int dX = position.x - andereRobot->position.x;
-		int dY = position.y - andereRobot->position.y;
+		if (!andereRobot)
+		{
+			return false;
+		}
+		// The other robot moves on its own thread, only its published state is consistent
+		wxPoint anderePosition = andereRobot->getState().position;
+		int dX = position.x - anderePosition.x;
+		int dY = position.y - anderePosition.y;
 		double dist = std::sqrt( std::pow(dX, 2) + std::pow(dY, 2) );
 		double robotSize = std::max(size.GetWidth(), size.GetHeight()) * 3;
 
@@ -545,66 +560,44 @@ namespace Model
 	/**
 	 *
 	 */
-	void Robot::drive()
+	/* static */float Robot::toRobotSpeed(unsigned long aSpeedSetting)
 	{
-		try
-		{
-			TRACE_DEVELOP("Driving path with " + std::to_string(path.size()) + " vertexes.");
-			// The runtime value always wins!!
-			speed = static_cast<float>(Application::MainApplication::getSettings().getSpeed()) / 2.5f;
+		float robotSpeed = static_cast<float>(aSpeedSetting) / 2.5f;
 
-			// Compare a float/double with another float/double: use epsilon...
-			if (std::fabs(speed - 0.0) <= std::numeric_limits<float>::epsilon())
-			{
-				setSpeed(2, false);    // @suppress("Avoid magic numbers")
-			}
+		// Compare a float/double with another float/double: use epsilon...
+		if (std::fabs(robotSpeed - 0.0) <= std::numeric_limits<float>::epsilon())
+		{
+			robotSpeed = 2;    // @suppress("Avoid magic numbers")
+		}
+		return robotSpeed;
+	}
+	/**
+	 *
+	 */
+	void Robot::prepareDriving()
+	{
+		TRACE_DEVELOP("Driving path with " + std::to_string(path.size()) + " vertexes.");
+		// The runtime value always wins!!
+		speed = toRobotSpeed(Application::MainApplication::getSettings().getSpeed());
 
-			// We use the real position for starters, not an estimated position.
-			startPosition = position;
+		// We use the real position for starters, not an estimated position.
+		startPosition = position;
 
-			alreadyCollided = false;
-			pathPoint = 0;
-			while (position.x > 0 && position.x < 500 && position.y > 0
-			        && position.y < 500 && pathPoint < path.size())    // @suppress("Avoid magic numbers")
+		alreadyCollided = false;
+		pathPoint = 0;
+	}
+	/**
+	 *
+	 */
+	void Robot::drive()
+	{
+		try
+		{
+			while (step())
 			{
-				if (!andereRobotInDeBuurt() || this == RobotWorld::getRobotWorld().getRobot(0).get())
-				{
-					const PathAlgorithm::Vertex& vertex = path[pathPoint +=
-							static_cast<unsigned int>(speed)];
-					front = BoundedVector(vertex.asPoint(), position);
-					position.x = vertex.x;
-					position.y = vertex.y;
-				}
-				if (andereRobotInDeBuurt() && !alreadyCollided)
-				{
-					TRACE_DEVELOP("Recalculating route - " + name);
-					calculateRoute(goal, false);
-					TRACE_DEVELOP("Recalculated route (new size: " + std::to_string(path.size()) + ")");
-					pathPoint = 0;
-					alreadyCollided = true;
-				}
-
-				// Stop on arrival or collision
-				if (arrived(goal) || collision())
-				{
-					Application::Logger::log(
-					        __PRETTY_FUNCTION__
-					                + std::string(": arrived or collision"));
-					driving = false;
-					stopActing();
-				}
-
-				notifyObservers();
-
 				// If there is no sleep_for here the robot will immediately be on its destination....
 				std::this_thread::sleep_for(std::chrono::milliseconds(100));    // @suppress("Avoid magic numbers")
-
-				// this should be the last thing in the loop
-				if (driving == false)
-				{
-					break;
-				}
-			}    // while
+			}
 		} catch(std::exception& e)
 		{
 			Application::Logger::log(
@@ -618,6 +611,114 @@ namespace Model
 			        << std::endl;
 		}
 	}
+	/**
+	 *
+	 */
+	bool Robot::step()
+	{
+		if (readStep())
+		{
+			replanStep();
+		}
+		return commitStep();
+	}
+	/**
+	 *
+	 */
+	bool Robot::readStep()
+	{
+		pendingStep = PendingStep();
+		if (!driving || position.x <= 0 || position.x >= 500 || position.y <= 0
+		        || position.y >= 500 || pathPoint >= path.size())    // @suppress("Avoid magic numbers")
+		{
+			pendingStep.stop = true;
+			return false;
+		}
+
+		bool contact = false;
+		if (!path.empty() && (!andereRobotInDeBuurt() || this == RobotWorld::getRobotWorld().getRobot(0).get()))
+		{
+			unsigned int previousPathPoint = std::min(pathPoint, static_cast<unsigned int>(path.size() - 1));
+			pathPoint += static_cast<unsigned int>(speed);
+			contact = moveTo(previousPathPoint, std::min(pathPoint, static_cast<unsigned int>(path.size() - 1)));
+			pendingStep.moved = true;
+		}
+		if (andereRobotInDeBuurt() && !alreadyCollided)
+		{
+			// The contact of the move is kept for the check after the replan
+			pendingStep.collided = contact;
+			return true;
+		}
+		checkStep(contact);
+		return false;
+	}
+	/**
+	 *
+	 */
+	void Robot::replanStep()
+	{
+		// As calculateRoute and applyRoute, but the route is published by commitStep
+		PathAlgorithm::Path route = planRoute(false);
+		if (goal)
+		{
+			front = BoundedVector(goal->getPosition(), position);
+			updatePose();
+		}
+		path = route;
+		pathPoint = 0;
+		alreadyCollided = true;
+		pendingStep.replanned = true;
+
+		checkStep(pendingStep.collided);
+	}
+	/**
+	 *
+	 */
+	bool Robot::commitStep()
+	{
+		if (pendingStep.stop)
+		{
+			stopActing();
+			return false;
+		}
+		if (pendingStep.moved)
+		{
+			RobotWorld::getRobotWorld().getChangeJournal().record(Change::EntityMoved, Change::RobotEntity, getObjectId());
+		}
+		if (pendingStep.replanned)
+		{
+			TRACE_DEVELOP("Recalculated route - " + name + " (new size: " + std::to_string(path.size()) + ")");
+			publishPath();
+			astar.notifyObservers(Base::Notification::PathChanged);
+			Recorder::getRecorder().recordPath(*this, true);
+		}
+
+		// Stop on arrival or collision
+		if (pendingStep.collided || pendingStep.arrived)
+		{
+			Application::Logger::log(
+			        __PRETTY_FUNCTION__
+			                + std::string(": arrived or collision"));
+			if (pendingStep.collided)
+			{
+				Recorder::getRecorder().recordCollision(*this);
+			}
+			stopActing();
+		}
+
+		publishState();
+		notifyObservers(Base::Notification::PositionChanged);
+
+		return driving;
+	}
+	/**
+	 *
+	 */
+	void Robot::checkStep(bool aContact)
+	{
+		pendingStep.collided = aContact || collision();
+		pendingStep.arrived = !pendingStep.collided && arrived(goal);
+	}
 	/**
 	 *
 	 */
@@ -628,17 +729,49 @@ namespace Model
 		{
 			// Turn off logging if not debugging AStar
 			Application::Logger::setDisable();
-
-			front = BoundedVector(aGoal->getPosition(), position);
-			//handleNotificationsFor( astar);
-			path = astar.search(position, aGoal->getPosition(), size,
-				this == RobotWorld::getRobotWorld().getLocalRobot().get(),
-				ignoreRobot
-			);
-			//stopHandlingNotificationsFor( astar);
-
+			PathAlgorithm::Path route = planRoute(ignoreRobot);
 			Application::Logger::setDisable(false);
+
+			applyRoute(route, ignoreRobot);
+		}
+	}
+	/**
+	 *
+	 */
+	PathAlgorithm::Path Robot::planRoute(bool ignoreRobot)
+	{
+		if (!goal)
+		{
+			return PathAlgorithm::Path();
+		}
+		// The open set is published once by applyRoute, not for every vertex from the thread that searches
+		astar.enableNotification(false);
+		PathAlgorithm::Path route = astar.search(position, goal->getPosition(), size,
+			this == RobotWorld::getRobotWorld().getLocalRobot().get(),
+			ignoreRobot
+		);
+		astar.enableNotification();
+		return route;
+	}
+	/**
+	 *
+	 */
+	void Robot::applyRoute(const PathAlgorithm::Path& aPath, bool ignoreRobot)
+	{
+		if (!goal)
+		{
+			return;
 		}
+		front = BoundedVector(goal->getPosition(), position);
+		updatePose();
+		path = aPath;
+
+		publishState();
+		publishPath();
+		astar.notifyObservers(Base::Notification::PathChanged);
+
+		// Ignoring the other robot means this is the initial route, otherwise it is a replan
+		Recorder::getRecorder().recordPath(*this, !ignoreRobot);
 	}
 	/**
 	 *
@@ -657,14 +790,13 @@ namespace Model
 	 */
 	bool Robot::collision()
 	{
-		wxPoint frontLeft = getFrontLeft();
-		wxPoint frontRight = getFrontRight();
-		wxPoint backLeft = getBackLeft();
-		wxPoint backRight = getBackRight();
+		const wxPoint& frontLeft = corners[FrontLeft];
+		const wxPoint& frontRight = corners[FrontRight];
+		const wxPoint& backLeft = corners[BackLeft];
+		const wxPoint& backRight = corners[BackRight];
 
-		const std::vector<WallPtr>& walls =
-		        RobotWorld::getRobotWorld().getWalls();
-		for (WallPtr wall : walls)
+		WorldSnapshotPtr world = RobotWorld::getRobotWorld().getSnapshot();
+		for (Wall* wall : world->getWalls(boundingBox))
 		{
 			if (Utils::Shape2DUtils::intersect(frontLeft, frontRight,
 			        wall->getPoint1(), wall->getPoint2())
@@ -676,20 +808,185 @@ namespace Model
 				return true;
 			}
 		}
-		const std::vector<RobotPtr>& robots =
-		        RobotWorld::getRobotWorld().getRobots();
-		for (RobotPtr robot : robots)
+		for (const RobotPtr& robot : *world->robots)
 		{
 			if (getObjectId() == robot->getObjectId())
 			{
 				continue;
 			}
-			if (intersects(robot->getRegion()))
+			// The other robot moves on its own thread, only its published state is consistent
+			RobotState robotState = robot->getState();
+			if (boundingBox.Intersects(robotState.boundingBox)
+			        && intersects(wxRegion(robotState.corners.size(), robotState.corners.data())))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	/**
+	 *
+	 */
+	bool Robot::moveTo(unsigned int aFromPathPoint, unsigned int aToPathPoint)
+	{
+		wxPoint previousPosition = position;
+		BoundedVector previousFront = front;
+		std::array<wxPoint, 4> previousCorners = corners;
+
+		const PathAlgorithm::Vertex& vertex = path[aToPathPoint];
+		front = BoundedVector(vertex.asPoint(), position);
+		position = vertex.asPoint();
+		updatePose();
+
+		// The hull of the complete move is a cheap conservative test, most moves end here
+		if (!sweptCollision(previousCorners))
+		{
+			return false;
+		}
+
+		// Time of impact: redo the move vertex by vertex, i.e. including the vertices that were skipped,
+		// and stop before the first vertex that makes contact
+		position = previousPosition;
+		front = previousFront;
+		updatePose();
+		for (unsigned int i = aFromPathPoint + 1; i <= aToPathPoint; ++i)
+		{
+			wxPoint safePosition = position;
+			BoundedVector safeFront = front;
+			std::array<wxPoint, 4> safeCorners = corners;
+
+			front = BoundedVector(path[i].asPoint(), position);
+			position = path[i].asPoint();
+			updatePose();
+
+			if (sweptCollision(safeCorners))
+			{
+				position = safePosition;
+				front = safeFront;
+				updatePose();
+				return true;
+			}
+		}
+
+		// The hull was too conservative, none of the vertices make contact: keep the original heading
+		front = BoundedVector(vertex.asPoint(), previousPosition);
+		position = vertex.asPoint();
+		updatePose();
+		return false;
+	}
+	/**
+	 *
+	 */
+	bool Robot::sweptCollision(const std::array<wxPoint, 4>& aPreviousCorners) const
+	{
+		std::vector<wxPoint> points(aPreviousCorners.begin(), aPreviousCorners.end());
+		points.insert(points.end(), corners.begin(), corners.end());
+		std::vector<wxPoint> hull = Utils::Shape2DUtils::getConvexHull(points);
+		if (hull.size() < 3)
+		{
+			return false;
+		}
+
+		int hullSize = static_cast<int>(hull.size());
+		wxRect sweptBoundingBox = Utils::Shape2DUtils::getBoundingBox(hull.data(), hullSize);
+
+		WorldSnapshotPtr world = RobotWorld::getRobotWorld().getSnapshot();
+		for (Wall* wall : world->getWalls(sweptBoundingBox))
+		{
+			// A wall that is already touched in the previous pose is handled by collision(),
+			// which deliberately ignores the back of the robot
+			if (Utils::Shape2DUtils::intersectsPolygon(hull.data(), hullSize, wall->getPoint1(), wall->getPoint2())
+			        && !Utils::Shape2DUtils::intersectsPolygon(aPreviousCorners.data(), 4, wall->getPoint1(), wall->getPoint2()))    // @suppress("Avoid magic numbers")
+			{
+				return true;
+			}
+		}
+
+		wxRegion previousRegion(aPreviousCorners.size(), aPreviousCorners.data());
+		wxRegion sweptRegion(hull.size(), hull.data());
+		for (const RobotPtr& robot : *world->robots)
+		{
+			if (robot.get() == this)
+			{
+				continue;
+			}
+			RobotState robotState = robot->getState();
+			if (!sweptBoundingBox.Intersects(robotState.boundingBox))
+			{
+				continue;
+			}
+			wxRegion robotRegion(robotState.corners.size(), robotState.corners.data());
+			wxRegion touchedBefore = previousRegion;
+			touchedBefore.Intersect(robotRegion);
+			if (!touchedBefore.IsEmpty())
+			{
+				continue;
+			}
+			robotRegion.Intersect(sweptRegion);
+			if (!robotRegion.IsEmpty())
 			{
 				return true;
 			}
 		}
 		return false;
 	}
+	/**
+	 *
+	 */
+	void Robot::updatePose()
+	{
+		heading = Utils::Shape2DUtils::getAngle(front);
+		cosHeading = std::cos(heading);
+		sinHeading = std::sin(heading);
+
+		// The corners are rotated over heading + 0.5 * PI:
+		// cos(heading + 0.5 * PI) == -sin(heading) and sin(heading + 0.5 * PI) == cos(heading)
+		double cosRotation = -sinHeading;
+		double sinRotation = cosHeading;
 
+		// Offsets of the corners relative to the position, before rotation
+		int left = -(size.x / 2);
+		int top = -(size.y / 2);
+		int right = left + size.x;
+		int bottom = top + size.y;
+
+		const wxPoint offsets[] = {	wxPoint(right, top),
+									wxPoint(left, top),
+									wxPoint(left, bottom),
+									wxPoint(right, bottom)};
+		for (std::size_t i = 0; i < corners.size(); ++i)
+		{
+			corners[i].x = static_cast<int>(offsets[i].x * cosRotation
+			        - offsets[i].y * sinRotation + position.x);
+			corners[i].y = static_cast<int>(offsets[i].y * cosRotation
+			        + offsets[i].x * sinRotation + position.y);
+		}
+		boundingBox = Utils::Shape2DUtils::getBoundingBox(corners.data(), static_cast<int>(corners.size()));
+	}
+	/**
+	 *
+	 */
+	void Robot::publishState()
+	{
+		RobotState newState;
+		newState.position = position;
+		newState.size = size;
+		newState.frontX = front.x;
+		newState.frontY = front.y;
+		newState.heading = heading;
+		newState.cosHeading = cosHeading;
+		newState.sinHeading = sinHeading;
+		newState.corners = corners;
+		newState.boundingBox = boundingBox;
+		newState.acting = acting;
+		newState.driving = driving;
+		state.store(newState);
+	}
+	/**
+	 *
+	 */
+	void Robot::publishPath()
+	{
+		std::atomic_store(&pathSnapshot, std::make_shared<const PathAlgorithm::Path>(path));
+	}
 }    // namespace Model
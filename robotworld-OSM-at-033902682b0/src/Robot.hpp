@@ -11,8 +11,10 @@
 #include "Observer.hpp"
 #include "Point.hpp"
 #include "Region.hpp"
+#include "SeqLock.hpp"
 #include "Size.hpp"
 
+#include <array>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -34,6 +36,24 @@ namespace Model
 	class Goal;
 	typedef std::shared_ptr< Goal > GoalPtr;
 
+	/**
+	 * A consistent snapshot of the pose and status of a Robot, see Robot::getState
+	 */
+	struct RobotState
+	{
+			wxPoint position;
+			wxSize size;
+			double frontX = 0.0;
+			double frontY = 0.0;
+			double heading = 0.0;
+			double cosHeading = 1.0;
+			double sinHeading = 0.0;
+			std::array< wxPoint, 4 > corners;
+			wxRect boundingBox;
+			bool acting = false;
+			bool driving = false;
+	};
+
 	/**
 	 *
 	 */
@@ -135,13 +155,82 @@ namespace Model
 				return driving;
 			}
 			/**
-			 *
+			 * Plans the route to the goal and prepares for driving. Unless the lockstep simulation is used
+			 * the robot then drives the route, stepping itself until it stops.
 			 */
 			virtual void startDriving();
 			/**
 			 *
 			 */
 			virtual void stopDriving();
+			/**
+			 * Executes a single step of driving: moves the robot along the path according to its speed, replans if
+			 * another robot is near and stops on arrival or collision.
+			 *
+			 * @return true if the robot is still driving after the step
+			 */
+			bool step();
+			/**
+			 * @name The phases of step
+			 *
+			 * The Simulation steps all robots at once. readStep and replanStep only read the world and the published
+			 * state of the other robots and write the robot itself, so they may run in parallel for different robots.
+			 * No robot publishes before commitStep, so every robot sees the other robots as they were at the start of
+			 * the step, whatever the order of the robots and the number of threads. commitStep publishes the result
+			 * and notifies the observers and must be executed for one robot at a time, in the order of the robots.
+			 */
+			//@{
+			/**
+			 * Moves the robot and checks for contact, see step
+			 *
+			 * @return true if another robot is near and replanStep must be called before commitStep
+			 */
+			bool readStep();
+			/**
+			 * Plans a new route from the position after the move and checks for contact in the turned pose
+			 */
+			void replanStep();
+			/**
+			 * Publishes the step, records it and stops the robot on arrival or collision
+			 *
+			 * @return true if the robot is still driving after the step
+			 */
+			bool commitStep();
+			//@}
+			/**
+			 * @name The phases of startDriving
+			 *
+			 * The Simulation plans the initial routes of all robots at once: planRoute only reads the world and writes
+			 * the AStar of the robot itself, so it may run in parallel for different robots. beginDriving and
+			 * applyRoute change the state of the robot and notify its observers and must be executed for one robot at
+			 * a time.
+			 */
+			//@{
+			/**
+			 * Marks the robot as driving and selects its goal
+			 */
+			void beginDriving();
+			/**
+			 *
+			 * @return the route from the current position to the goal, the robot itself is not changed
+			 */
+			PathAlgorithm::Path planRoute( bool ignoreRobot);
+			/**
+			 * Turns the robot towards the goal, makes aPath the current path and publishes it
+			 */
+			void applyRoute(	const PathAlgorithm::Path& aPath,
+								bool ignoreRobot);
+			/**
+			 * Prepares for driving the current path from the current position
+			 */
+			void prepareDriving();
+			//@}
+			/**
+			 *
+			 * @param aSpeedSetting The speed as set in the MainSettings
+			 * @return the number of path vertices a robot moves per step for aSpeedSetting
+			 */
+			static float toRobotSpeed( unsigned long aSpeedSetting);
 			/**
 			 *
 			 * @return true if the robot is communicating, i.e. listens with an active ServerConnection
@@ -175,29 +264,80 @@ namespace Model
 			/**
 			 *
 			 */
-			wxPoint getFrontLeft() const;
+			wxPoint getFrontLeft() const
+			{
+				return corners[FrontLeft];
+			}
+			/**
+			 *
+			 */
+			wxPoint getFrontRight() const
+			{
+				return corners[FrontRight];
+			}
+			/**
+			 *
+			 */
+			wxPoint getBackLeft() const
+			{
+				return corners[BackLeft];
+			}
+			/**
+			 *
+			 */
+			wxPoint getBackRight() const
+			{
+				return corners[BackRight];
+			}
+			/**
+			 *
+			 * @return the corners of the robot in the order front right, front left, back left and back right,
+			 * i.e. usable as a polygon
+			 */
+			const std::array< wxPoint, 4 >& getCorners() const
+			{
+				return corners;
+			}
+			/**
+			 *
+			 * @return the smallest rectangle that contains all corners
+			 */
+			const wxRect& getBoundingBox() const
+			{
+				return boundingBox;
+			}
 			/**
 			 *
+			 * @return the angle of the front, i.e. Utils::Shape2DUtils::getAngle( getFront())
 			 */
-			wxPoint getFrontRight() const;
+			double getHeading() const
+			{
+				return heading;
+			}
 			/**
 			 *
+			 * @return std::cos( getHeading())
 			 */
-			wxPoint getBackLeft() const;
+			double getCosHeading() const
+			{
+				return cosHeading;
+			}
 			/**
 			 *
+			 * @return std::sin( getHeading())
 			 */
-			wxPoint getBackRight() const;
+			double getSinHeading() const
+			{
+				return sinHeading;
+			}
 			/**
 			 * @name Observer functions
 			 */
 			//@{
 			/**
-			 * A Notifier will call this function if this Observer will handle the notifications of that
-			 * Notifier. It is the responsibility of the Observer to filter any events it is interested in.
-			 *
+			 * Forwards the notifications of the path search to the observers of the robot
 			 */
-			virtual void handleNotification() override;
+			virtual void handleNotification( const Base::Notification& aNotification) override;
 			//@}
 			/**
 			 *
@@ -213,6 +353,43 @@ namespace Model
 			{
 				return path;
 			}
+			/**
+			 * @name Published state
+			 *
+			 * The robot publishes its state whenever it changes outside a step and once at the end of each step.
+			 * These functions may be called from any thread: they never block the robot and never see a half
+			 * updated robot.
+			 */
+			//@{
+			/**
+			 *
+			 */
+			RobotState getState() const
+			{
+				return state.load();
+			}
+			/**
+			 *
+			 * @return the path as it was last published, never nullptr
+			 */
+			PathAlgorithm::PathPtr getPathSnapshot() const
+			{
+				return std::atomic_load( &pathSnapshot);
+			}
+			/**
+			 *
+			 * @return the open set at the end of the last route calculation, never nullptr
+			 */
+			PathAlgorithm::OpenSetPtr getOpenSetSnapshot() const
+			{
+				return astar.getOpenSetSnapshot();
+			}
+			//@}
+			/**
+			 * Used by the Replay to show a recorded path
+			 */
+			void setPath(	const PathAlgorithm::Path& aPath,
+							bool aNotifyObservers = true);
 			/**
 			 * @name Messaging::MessageHandler functions
 			 */
@@ -256,7 +433,7 @@ namespace Model
 
 		protected:
 			/**
-			 *
+			 * Steps the robot until it stops driving, used if the robot runs in its own thread
 			 */
 			void drive();
 			/**
@@ -271,7 +448,50 @@ namespace Model
 			 *
 			 */
 			bool collision();
+			/**
+			 * Moves the robot along the path from path[aFromPathPoint] to path[aToPathPoint]. The volume swept between the current pose
+			 * and the new pose is tested against the walls and the other robots, so a robot that moves
+			 * several vertices per tick cannot tunnel through a thin wall or another robot. On contact the
+			 * robot stops at the last vertex before the contact.
+			 *
+			 * @return true if the robot made contact while moving
+			 */
+			bool moveTo(	unsigned int aFromPathPoint,
+							unsigned int aToPathPoint);
+			/**
+			 *
+			 * @param aPreviousCorners The corners of the pose the robot moved from
+			 * @return true if the convex hull of the previous and the current corners touches a wall or another
+			 * robot that was not already touched in the previous pose
+			 */
+			bool sweptCollision( const std::array< wxPoint, 4 >& aPreviousCorners) const;
+			/**
+			 * Recalculates the cached heading and corners. Must be called whenever position, front or size changes.
+			 */
+			void updatePose();
+			/**
+			 * Checks for contact and arrival in the current pose, part of readStep and replanStep
+			 */
+			void checkStep( bool aContact);
+			/**
+			 * Publishes the current pose and status for getState
+			 */
+			void publishState();
+			/**
+			 * Publishes the current path for getPathSnapshot
+			 */
+			void publishPath();
 		private:
+			/**
+			 * Indices in corners
+			 */
+			enum Corner
+			{
+				FrontRight,
+				FrontLeft,
+				BackLeft,
+				BackRight
+			};
 			/**
 			 *
 			 */
@@ -288,6 +508,16 @@ namespace Model
 			 *
 			 */
 			BoundedVector front;
+			/**
+			 * @name Pose cache, see updatePose()
+			 */
+			//@{
+			double heading;
+			double cosHeading;
+			double sinHeading;
+			std::array< wxPoint, 4 > corners;
+			wxRect boundingBox;
+			//@}
 			/**
 			 *
 			 */
@@ -320,10 +550,6 @@ namespace Model
 			 *
 			 */
 			std::thread robotThread;
-			/**
-			 *
-			 */
-			mutable std::recursive_mutex robotMutex;
 			/**
 			 *
 			 */
@@ -331,6 +557,26 @@ namespace Model
 
 			unsigned int pathPoint;
 			bool alreadyCollided;
+			/**
+			 * What readStep and replanStep leave for commitStep
+			 */
+			struct PendingStep
+			{
+					bool stop = false;
+					bool moved = false;
+					bool replanned = false;
+					bool collided = false;
+					bool arrived = false;
+			};
+			PendingStep pendingStep;
+			/**
+			 *
+			 */
+			Base::SeqLock< RobotState > state;
+			/**
+			 *
+			 */
+			PathAlgorithm::PathPtr pathSnapshot;
 	};
 } // namespace Model
 #endif // ROBOT_HPP_
@@ -9,8 +9,11 @@
 #include "RobotWorldCanvas.hpp"
 #include "Shape2DUtils.hpp"
 #include "Trace.hpp"
+#include "WxDCRenderer.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <sstream>
 
 namespace View
@@ -20,7 +23,9 @@ namespace View
 	 */
 	RobotShape::RobotShape( Model::RobotPtr aRobot) :
 								RectangleShape( std::dynamic_pointer_cast<Model::ModelObject>(aRobot), aRobot->getPosition(), aRobot->getName()),
-								robotWorldCanvas(nullptr)
+								robotWorldCanvas(nullptr),
+								drawnPathSpacing( 0),
+								boundedBorderWidth( 0)
 	{
 	}
 	/**
@@ -66,38 +71,51 @@ namespace View
 	/**
 	 *
 	 */
-	void RobotShape::handleNotification()
+	void RobotShape::handleNotification( const Base::Notification& UNUSEDPARAM(aNotification))
 	{
-		setCentre( getRobot()->getPosition());
-		robotWorldCanvas->handleNotification();
+		// This runs on the thread of the NotificationDispatcher, so the shape is only marked dirty. The shape reads
+		// the published state of the robot when the GUI thread repaints it. The shapes of the other objects do not
+		// change, the world is not synchronised. A shape that is not on a canvas, e.g. of the FrameCapture, is drawn
+		// anyway.
+		if (robotWorldCanvas != nullptr)
+		{
+			robotWorldCanvas->handleBackGroundRepaint( *this);
+		}
 	}
 	/**
 	 *
 	 */
-	void RobotShape::draw( wxDC& dc)
+	void RobotShape::draw( Renderer& renderer)
 	{
 		//FUNCTRACE_DEVELOP();
 
-		updateSizeToTitle( dc);
+		updateSizeToTitle( renderer);
 
-		drawStartPosition( dc);
+		drawStartPosition( renderer);
 
 		if(Application::MainApplication::getSettings().getDrawOpenSet())
 		{
-			drawOpenSet( dc);
+			drawOpenSet( renderer);
 		}
 
-		drawPath( dc);
+		drawPath( renderer);
 
-		drawRobot( dc);
+		drawRobot( renderer);
 	}
 	/**
 	 *
 	 */
 	bool RobotShape::occupies( const wxPoint& aPoint) const
 	{
-		wxPoint cornerPoints[] = { getRobot()->getFrontRight(), getRobot()->getFrontLeft(), getRobot()->getBackLeft(), getRobot()->getBackRight() };
-		return Utils::Shape2DUtils::isInsidePolygon( cornerPoints, 4, aPoint);
+		const std::array< wxPoint, 4 > cornerPoints = getRobot()->getState().corners;
+		return Utils::Shape2DUtils::isInsidePolygon( cornerPoints.data(), cornerPoints.size(), aPoint);
+	}
+	/**
+	 *
+	 */
+	wxPoint RobotShape::getCentre() const
+	{
+		return getRobot()->getState().position;
 	}
 	/**
 	 *
@@ -107,6 +125,76 @@ namespace View
 		getRobot()->setPosition( aPoint, false);
 		RectangleShape::setCentre( getRobot()->getPosition());
 	}
+	/**
+	 *
+	 */
+	wxRect RobotShape::getBoundingBox() const
+	{
+		const Model::RobotState robotState = getRobot()->getState();
+		const wxPoint& position = robotState.position;
+
+		int left = position.x;
+		int top = position.y;
+		int right = position.x;
+		int bottom = position.y;
+		auto include = [&left, &top, &right, &bottom](	const wxPoint& aPoint,
+														int aMargin)
+		{
+			left = std::min( left, aPoint.x - aMargin);
+			top = std::min( top, aPoint.y - aMargin);
+			right = std::max( right, aPoint.x + aMargin);
+			bottom = std::max( bottom, aPoint.y + aMargin);
+		};
+
+		// The corners are drawn as thick points
+		for (const wxPoint& corner : robotState.corners)
+		{
+			include( corner, borderWidth + 2);
+		}
+		// The nose and the title that is rotated around the centre
+		include( wxPoint( static_cast< int >( position.x + robotState.cosHeading * 25), static_cast< int >( position.y + robotState.sinHeading * 25)), 1);
+		include( position, (titleSize.x + titleSize.y) / 2 + 1);
+
+		return wxRect( left, top, right - left + 1, bottom - top + 1);
+	}
+	/**
+	 *
+	 */
+	wxRect RobotShape::getDecorationBoundingBox() const
+	{
+		Model::RobotPtr robot = getRobot();
+		PathAlgorithm::PathPtr path = robot->getPathSnapshot();
+		PathAlgorithm::OpenSetPtr openSet = Application::MainApplication::getSettings().getDrawOpenSet() ? robot->getOpenSetSnapshot() : nullptr;
+		if (path == boundedPath && openSet == boundedOpenSet && robot->startPosition == boundedStartPosition && borderWidth == boundedBorderWidth)
+		{
+			return decorationBoundingBox;
+		}
+		boundedPath = path;
+		boundedOpenSet = openSet;
+		boundedStartPosition = robot->startPosition;
+		boundedBorderWidth = borderWidth;
+
+		int margin = 3 + borderWidth + 5;
+		int left = robot->startPosition.x - margin;
+		int top = robot->startPosition.y - margin;
+		int right = robot->startPosition.x + margin;
+		int bottom = robot->startPosition.y + margin;
+		auto include = [this, &left, &top, &right, &bottom](const PathAlgorithm::Vertex& aVertex)
+		{
+			left = std::min( left, aVertex.x - borderWidth);
+			top = std::min( top, aVertex.y - borderWidth);
+			right = std::max( right, aVertex.x + borderWidth);
+			bottom = std::max( bottom, aVertex.y + borderWidth);
+		};
+		std::for_each( path->begin(), path->end(), include);
+		if (openSet)
+		{
+			std::for_each( openSet->begin(), openSet->end(), include);
+		}
+
+		decorationBoundingBox = wxRect( left, top, right - left + 1, bottom - top + 1);
+		return decorationBoundingBox;
+	}
 	/**
 	 *
 	 */
@@ -144,10 +232,10 @@ namespace View
 	/**
 	 *
 	 */
-	void RobotShape::updateSizeToTitle( wxDC& dc)
+	void RobotShape::updateSizeToTitle( Renderer& renderer)
 	{
 		// The minimum size of the RectangleShape is the size of the title
-		titleSize = dc.GetTextExtent( title);
+		titleSize = renderer.getTextExtent( title);
 		if (size.x < (titleSize.x + 2 * spacing + 2 * borderWidth))
 		{
 			size.x = titleSize.x + 2 * spacing + 2 * borderWidth;
@@ -164,76 +252,146 @@ namespace View
 	/**
 	 *
 	 */
-	void RobotShape::drawStartPosition( wxDC& dc)
+	void RobotShape::drawStartPosition( Renderer& renderer)
 	{
 		// Draw the start position
-		dc.SetPen( wxPen(  "RED", borderWidth + 5, wxPENSTYLE_SOLID));
-		dc.DrawCircle( getRobot()->startPosition, 3);
+		renderer.setPen( "RED", borderWidth + 5);
+		renderer.drawCircle( getRobot()->startPosition, 3);
 	}
 	/**
 	 *
 	 */
-	void RobotShape::drawOpenSet( wxDC& dc)
+	void RobotShape::drawOpenSet( Renderer& renderer)
 	{
-		PathAlgorithm::OpenSet openSet = getRobot()->getOpenSet();
-		if (openSet.size() != 0)
+		PathAlgorithm::OpenSetPtr openSet = getRobot()->getOpenSetSnapshot();
+
+		// Only a wxDC benefits from the bitmap, other renderers draw the points
+		WxDCRenderer* wxDCRenderer = dynamic_cast< WxDCRenderer* >( &renderer);
+		if (wxDCRenderer == nullptr)
 		{
-			dc.SetPen( wxPen( "PALE GREEN", borderWidth, wxPENSTYLE_SOLID));
-			for (const PathAlgorithm::Vertex &vertex : openSet)
+			renderer.setPen( "PALE GREEN", borderWidth);
+			for (const PathAlgorithm::Vertex &vertex : *openSet)
 			{
-				dc.DrawPoint( vertex.asPoint());
+				renderer.drawPoint( vertex.asPoint());
 			}
+			return;
+		}
+
+		if (openSet != drawnOpenSet)
+		{
+			drawnOpenSet = openSet;
+			openSetBitmap = wxBitmap();
+			if (openSet->size() != 0)
+			{
+				int left = openSet->front().x;
+				int top = openSet->front().y;
+				int right = left;
+				int bottom = top;
+				for (const PathAlgorithm::Vertex &vertex : *openSet)
+				{
+					left = std::min( left, vertex.x);
+					top = std::min( top, vertex.y);
+					right = std::max( right, vertex.x);
+					bottom = std::max( bottom, vertex.y);
+				}
+				openSetOrigin = wxPoint( left - borderWidth, top - borderWidth);
+
+				// The open set is scattered so it is drawn once in a bitmap of which the white background is masked
+				openSetBitmap.Create( right - left + 2 * borderWidth + 1, bottom - top + 2 * borderWidth + 1);
+				wxMemoryDC bitmapDC( openSetBitmap);
+				bitmapDC.SetBackground( *wxWHITE_BRUSH);
+				bitmapDC.Clear();
+				bitmapDC.SetPen( wxPen( "PALE GREEN", borderWidth, wxPENSTYLE_SOLID));
+				for (const PathAlgorithm::Vertex &vertex : *openSet)
+				{
+					bitmapDC.DrawPoint( vertex.asPoint() - openSetOrigin);
+				}
+				bitmapDC.SelectObject( wxNullBitmap);
+				openSetBitmap.SetMask( new wxMask( openSetBitmap, wxColour( "WHITE")));
+			}
+		}
+		if (openSet->size() != 0)
+		{
+			wxDCRenderer->getDC().DrawBitmap( openSetBitmap, openSetOrigin, true);
 		}
 	}
 	/**
 	 *
 	 */
-	void RobotShape::drawPath( wxDC& dc)
+	void RobotShape::drawPath( Renderer& renderer)
 	{
-		PathAlgorithm::Path path = getRobot()->getPath();
-		if (path.size() != 0)
+		PathAlgorithm::PathPtr path = getRobot()->getPathSnapshot();
+
+		// Vertices closer together than the width of the pen or than one pixel at the current scale are covered by
+		// the line anyway
+		int spacing = std::max( borderWidth, static_cast< int >( std::ceil( 1.0 / renderer.getScale())));
+
+		if (path != drawnPath || spacing != drawnPathSpacing)
 		{
-			dc.SetPen( wxPen(  "BLACK", borderWidth, wxPENSTYLE_SOLID));
-			for (const PathAlgorithm::Vertex &vertex : path)
+			drawnPath = path;
+			drawnPathSpacing = spacing;
+			pathPoints.clear();
+			for (const PathAlgorithm::Vertex &vertex : *path)
 			{
-				dc.DrawPoint( vertex.asPoint());
+				wxPoint point = vertex.asPoint();
+				if (pathPoints.empty() || std::abs( point.x - pathPoints.back().x) >= spacing || std::abs( point.y - pathPoints.back().y) >= spacing)
+				{
+					pathPoints.push_back( point);
+				}
 			}
+			if (path->size() != 0 && pathPoints.back() != path->back().asPoint())
+			{
+				pathPoints.push_back( path->back().asPoint());
+			}
+		}
+
+		if (pathPoints.size() != 0)
+		{
+			renderer.setPen( "BLACK", borderWidth);
+			renderer.drawLines( pathPoints.size(), pathPoints.data());
 		}
 	}
 	/**
 	 *
 	 */
-	void RobotShape::drawRobot( wxDC& dc)
+	void RobotShape::drawRobot( Renderer& renderer)
 	{
 		// Draws a rectangle with the given top left corner, and with the given size.
-		dc.SetBrush( *wxWHITE_BRUSH);
+		renderer.setBrush( Colour( "WHITE"));
 		if (isSelected())
 		{
-			dc.SetPen( wxPen( getSelectionColour(), borderWidth, wxPENSTYLE_SOLID));
+			renderer.setPen( getSelectionColour(), borderWidth);
 		} else
 		{
-			dc.SetPen( wxPen( getNormalColour(), borderWidth, wxPENSTYLE_SOLID));
+			renderer.setPen( getNormalColour(), borderWidth);
 		}
-		wxPoint cornerPoints[] = { getRobot()->getFrontRight(), getRobot()->getFrontLeft(), getRobot()->getBackLeft(), getRobot()->getBackRight() };
-		dc.DrawPolygon( 4, cornerPoints);
+		// A single consistent snapshot, the robot may move while it is drawn
+		const Model::RobotState robotState = getRobot()->getState();
+		const std::array< wxPoint, 4 >& cornerPoints = robotState.corners;
+		renderer.drawPolygon( cornerPoints.size(), cornerPoints.data());
 
-		dc.SetPen( wxPen(  "RED", borderWidth + 2, wxPENSTYLE_SOLID));
-		dc.DrawPoint( cornerPoints[1]);
-		dc.SetPen( wxPen(  "GREEN", borderWidth + 2, wxPENSTYLE_SOLID));
-		dc.DrawPoint( cornerPoints[0]);
-		dc.SetPen( wxPen( "INDIAN RED", borderWidth + 2, wxPENSTYLE_SOLID));
-		dc.DrawPoint( cornerPoints[2]);
-		dc.SetPen( wxPen( "PALE GREEN", borderWidth + 2, wxPENSTYLE_SOLID));
-		dc.DrawPoint( cornerPoints[3]);
+		renderer.setPen( "RED", borderWidth + 2);
+		renderer.drawPoint( cornerPoints[1]);
+		renderer.setPen( "GREEN", borderWidth + 2);
+		renderer.drawPoint( cornerPoints[0]);
+		renderer.setPen( "INDIAN RED", borderWidth + 2);
+		renderer.drawPoint( cornerPoints[2]);
+		renderer.setPen( "PALE GREEN", borderWidth + 2);
+		renderer.drawPoint( cornerPoints[3]);
 
-		double angle = Utils::Shape2DUtils::getAngle( getRobot()->getFront());
+		double angle = robotState.heading;
+		double cosAngle = robotState.cosHeading;
+		double sinAngle = robotState.sinHeading;
 
 		// Draw the nose
-		dc.SetPen( wxPen(  "BLACK", 1, wxPENSTYLE_SOLID));
-		dc.DrawLine( centre.x, centre.y, static_cast< int >( centre.x + std::cos( angle) * 25), static_cast< int >( centre.y + std::sin( angle) * 25));
+		renderer.setPen( "BLACK", 1);
+		const wxPoint& position = robotState.position;
+		renderer.drawLine( position, wxPoint( static_cast< int >( position.x + cosAngle * 25), static_cast< int >( position.y + sinAngle * 25)));
 
-		int textOffsetx = static_cast< int >( std::cos( -angle - 0.5 * Utils::PI) * (titleSize.x / 2) + std::sin( -angle - 0.5 * Utils::PI) * (titleSize.y / 2));
-		int textOffsety = static_cast< int >( std::sin( -angle - 0.5 * Utils::PI) * (titleSize.x / 2) - std::cos( -angle - 0.5 * Utils::PI) * (titleSize.y / 2));
-		dc.DrawRotatedText( title, centre.x - textOffsetx, centre.y + textOffsety, (-angle - 0.5 * Utils::PI) / Utils::PI * 180);
+		// The text is rotated over -angle - 0.5 * PI:
+		// cos( -angle - 0.5 * PI) == -sin( angle) and sin( -angle - 0.5 * PI) == -cos( angle)
+		int textOffsetx = static_cast< int >( -sinAngle * (titleSize.x / 2) - cosAngle * (titleSize.y / 2));
+		int textOffsety = static_cast< int >( -cosAngle * (titleSize.x / 2) + sinAngle * (titleSize.y / 2));
+		renderer.drawRotatedText( title, wxPoint( position.x - textOffsetx, position.y + textOffsety), (-angle - 0.5 * Utils::PI) / Utils::PI * 180);
 	}
 } // namespace View
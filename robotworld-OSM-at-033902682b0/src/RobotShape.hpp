@@ -8,6 +8,7 @@
 #include "Widgets.hpp"
 
 #include <string>
+#include <vector>
 
 namespace View
 {
@@ -39,21 +40,21 @@ namespace View
 			/**
 			 *
 			 */
-			virtual wxColour getNormalColour() const override
+			virtual Colour getNormalColour() const override
 			{
 				return "BLACK";
 			}
 			/**
 			 *
 			 */
-			virtual wxColour getSelectionColour() const override
+			virtual Colour getSelectionColour() const override
 			{
 				return "RED";
 			}
 			/**
 			 *
 			 */
-			virtual wxColour getActivationColour() const override
+			virtual Colour getActivationColour() const override
 			{
 				return "LIGHT GREY";
 			}
@@ -70,10 +71,10 @@ namespace View
 			 */
 			//@{
 			/**
-			 * A Notifier will call this function if this Observer will handle the notifications of that
-			 * Notifier. It is the responsibility of the Observer to filter any events it is interested in.
+			 * Follows the position of the robot and repaints the canvas, the shape subscribes to the position and
+			 * the path of the robot only
 			 */
-			virtual void handleNotification() override;
+			virtual void handleNotification( const Base::Notification& aNotification) override;
 			//@}
 			/**
 			 * @name (Pure) virtual abstract Shape functions
@@ -82,17 +83,37 @@ namespace View
 			/**
 			 *
 			 */
-			virtual void draw( wxDC& dc) override;
+			virtual void draw( Renderer& renderer) override;
 			/**
 			 *
 			 * @param aPoint
 			 * @return True if the point is in the shape
 			 */
 			virtual bool occupies( const wxPoint& aPoint) const override;
+			/**
+			 * The position the robot published last, the robot moves on its own thread
+			 */
+			virtual wxPoint getCentre() const override;
 			/**
 			 *
 			 */
 			virtual void setCentre( const wxPoint& aPoint) override;
+			/**
+			 * The robot with its nose and title
+			 */
+			virtual wxRect getBoundingBox() const override;
+			/**
+			 * The start position, the path and the open set if that is drawn. The rectangle is only recalculated when
+			 * the robot publishes a new path or open set.
+			 */
+			virtual wxRect getDecorationBoundingBox() const override;
+			/**
+			 * A robot is drawn on top of the background layer
+			 */
+			virtual bool isStatic() const override
+			{
+				return false;
+			}
 			/**
 			 *
 			 */
@@ -125,26 +146,46 @@ namespace View
 			 *
 			 */
 			RobotWorldCanvas* robotWorldCanvas;
+			/**
+			 * The path as it was drawn last, the points are only rebuilt when the robot publishes a new path
+			 */
+			PathAlgorithm::PathPtr drawnPath;
+			int drawnPathSpacing;
+			std::vector< wxPoint > pathPoints;
+			/**
+			 * The open set as it was drawn last, the bitmap is only redrawn when the robot publishes a new open set
+			 */
+			PathAlgorithm::OpenSetPtr drawnOpenSet;
+			wxBitmap openSetBitmap;
+			wxPoint openSetOrigin;
+			/**
+			 * The decoration the cached decorationBoundingBox was calculated for
+			 */
+			mutable PathAlgorithm::PathPtr boundedPath;
+			mutable PathAlgorithm::OpenSetPtr boundedOpenSet;
+			mutable wxPoint boundedStartPosition;
+			mutable int boundedBorderWidth;
+			mutable wxRect decorationBoundingBox;
 			/**
 			 *
 			 */
-			void updateSizeToTitle( wxDC& dc);
+			void updateSizeToTitle( Renderer& renderer);
 			/**
 			 *
 			 */
-			void drawStartPosition( wxDC& dc);
+			void drawStartPosition( Renderer& renderer);
 			/**
 			 *
 			 */
-			void drawOpenSet( wxDC& dc);
+			void drawOpenSet( Renderer& renderer);
 			/**
 			 *
 			 */
-			void drawPath( wxDC& dc);
+			void drawPath( Renderer& renderer);
 			/**
 			 *
 			 */
-			void drawRobot( wxDC& dc);
+			void drawRobot( Renderer& renderer);
 	};
 } // namespace View
 #endif // ROBOTSHAPE_HPP_
@@ -2,18 +2,188 @@
 
 #include "Goal.hpp"
 #include "Logger.hpp"
+#include "MemoryPool.hpp"
 #include "Robot.hpp"
 #include "Wall.hpp"
 #include "WayPoint.hpp"
+#include "WorldBuilder.hpp"
 #include "MessageTypes.hpp"
 
 #include <algorithm>
+#include <exception>
+#include <string>
 
 namespace Model
 {
-	RobotWorld::RobotWorld() :localRobot(nullptr)
+	namespace
+	{
+		/**
+		 * Points aName in aNameIndex to the first object in aVector with that name, or removes aName if there is none
+		 */
+		template<typename T>
+		void reindexName(const std::vector<std::shared_ptr<T> >& aVector,
+		        std::unordered_map<std::string, std::shared_ptr<T> >& aNameIndex,
+		        const std::string& aName)
+		{
+			aNameIndex.erase(aName);
+			if (auto i = std::find_if(aVector.begin(), aVector.end(),
+			        [&aName](const std::shared_ptr<T>& anObject)
+			        {	return anObject->getName() == aName;}); i != aVector.end())
+			{
+				aNameIndex.emplace(aName, *i);
+			}
+		}
+		/**
+		 * Records the removal of the objects in aVector that are not in aKeepObjects
+		 */
+		template<typename T>
+		void recordRemovals(const std::vector<std::shared_ptr<T> >& aVector,
+		        const std::vector<Base::ObjectId>& aKeepObjects,
+		        ChangeJournal& aChangeJournal,
+		        Change::Entity anEntity)
+		{
+			for (const std::shared_ptr<T>& object : aVector)
+			{
+				if (std::find(aKeepObjects.begin(), aKeepObjects.end(), object->getObjectId()) == aKeepObjects.end())
+				{
+					aChangeJournal.record(Change::EntityRemoved, anEntity, object->getObjectId());
+				}
+			}
+		}
+		/**
+		 * Removes anObject, which is already erased from aVector, from the indexes
+		 */
+		template<typename T>
+		void unindex(const std::shared_ptr<T>& anObject,
+		        const std::vector<std::shared_ptr<T> >& aVector,
+		        std::unordered_map<std::string, std::shared_ptr<T> >& aNameIndex,
+		        std::unordered_map<Base::ObjectId, std::shared_ptr<T> >& anIdIndex)
+		{
+			anIdIndex.erase(anObject->getObjectId());
+			if (auto i = aNameIndex.find(anObject->getName()); i != aNameIndex.end() && i->second == anObject)
+			{
+				// Another object with the same name may be next in line
+				reindexName(aVector, aNameIndex, anObject->getName());
+			}
+		}
+		/**
+		 *
+		 * @return the object that aKey maps to in anIndex, nullptr if there is none
+		 */
+		template<typename Key, typename T>
+		std::shared_ptr<T> lookup(const std::unordered_map<Key, std::shared_ptr<T> >& anIndex,
+		        const Key& aKey)
+		{
+			if (auto i = anIndex.find(aKey); i != anIndex.end())
+			{
+				return i->second;
+			}
+			return nullptr;
+		}
+	} // namespace
+
+	/**
+	 *
+	 */
+	RobotPtr WorldSnapshot::getRobot(const std::string& aName) const
 	{
+		return lookup(*robotNameIndex, aName);
+	}
+	/**
+	 *
+	 */
+	RobotPtr WorldSnapshot::getRobot(const Base::ObjectId& anObjectId) const
+	{
+		return lookup(*robotIdIndex, anObjectId);
+	}
+	/**
+	 *
+	 */
+	WayPointPtr WorldSnapshot::getWayPoint(const std::string& aName) const
+	{
+		return lookup(*wayPointNameIndex, aName);
+	}
+	/**
+	 *
+	 */
+	WayPointPtr WorldSnapshot::getWayPoint(const Base::ObjectId& anObjectId) const
+	{
+		return lookup(*wayPointIdIndex, anObjectId);
+	}
+	/**
+	 *
+	 */
+	GoalPtr WorldSnapshot::getGoal(const std::string& aName) const
+	{
+		return lookup(*goalNameIndex, aName);
+	}
+	/**
+	 *
+	 */
+	GoalPtr WorldSnapshot::getGoal(const Base::ObjectId& anObjectId) const
+	{
+		return lookup(*goalIdIndex, anObjectId);
+	}
+	/**
+	 *
+	 */
+	WallPtr WorldSnapshot::getWall(const Base::ObjectId& anObjectId) const
+	{
+		return lookup(*wallIdIndex, anObjectId);
+	}
 
+	/**
+	 *
+	 */
+	std::vector<Wall*> WorldSnapshot::getWalls(const wxRect& aBoundingBox) const
+	{
+		std::vector<Wall*> result = wallIndex->query(aBoundingBox);
+		result.erase(
+		        std::remove_if(result.begin(), result.end(),
+		                [&aBoundingBox](Wall* aWall)
+		                {
+			                return !aWall->getBoundingBox().Intersects(aBoundingBox);
+		                }), result.end());
+		return result;
+	}
+
+	RobotWorld::RobotWorld() :localRobot(nullptr), updateDepth(0), pendingChanges(0)
+	{
+		// An empty world is published as a snapshot of the empty vectors and indexes
+		std::atomic_store(&snapshot, WorldSnapshotPtr(std::make_shared<WorldSnapshot>()));
+		publishSnapshot(AllChanged);
+	}
+	/**
+	 *
+	 */
+	RobotWorld::Update::Update(RobotWorld& aRobotWorld, unsigned int aChanges) :
+	        robotWorld(aRobotWorld)
+	{
+		robotWorld.writerMutex.lock();
+		++robotWorld.updateDepth;
+		robotWorld.pendingChanges |= aChanges;
+	}
+	/**
+	 *
+	 */
+	RobotWorld::Update::~Update()
+	{
+		if (--robotWorld.updateDepth == 0 && robotWorld.pendingChanges != 0)
+		{
+			unsigned int changes = robotWorld.pendingChanges;
+			robotWorld.pendingChanges = 0;
+			try
+			{
+				robotWorld.publishSnapshot(changes);
+			}
+			catch (std::exception& e)
+			{
+				// The changes are published with those of the next Update
+				robotWorld.pendingChanges = changes;
+				Application::Logger::log(__PRETTY_FUNCTION__ + std::string(": ") + e.what());
+			}
+		}
+		robotWorld.writerMutex.unlock();
 	}
 
 	/**
@@ -31,11 +201,18 @@ namespace Model
 	        const wxPoint& aPosition /*= wxPoint(-1,-1)*/,
 	        bool aNotifyObservers /*= true*/)
 	{
-		RobotPtr robot = std::make_shared<Robot>(aName, aPosition);
-		robots.push_back(robot);
+		RobotPtr robot = std::allocate_shared<Robot>(Base::PoolAllocator<Robot>(), aName, aPosition);
+		{
+			Update update(*this, RobotsChanged);
+			robots.push_back(robot);
+			// emplace keeps an earlier object with the same name in the name index
+			robotNameIndex.emplace(robot->getName(), robot);
+			robotIdIndex.emplace(robot->getObjectId(), robot);
+			changeJournal.record(Change::EntityAdded, Change::RobotEntity, robot->getObjectId());
+		}
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::ObjectsCreated);
 		}
 		return robot;
 	}
@@ -47,11 +224,17 @@ namespace Model
 	        const wxPoint& aPosition /*= wxPoint(-1,-1)*/,
 	        bool aNotifyObservers /*= true*/)
 	{
-		WayPointPtr wayPoint(new WayPoint(aName, aPosition));
-		wayPoints.push_back(wayPoint);
+		WayPointPtr wayPoint = std::allocate_shared<WayPoint>(Base::PoolAllocator<WayPoint>(), aName, aPosition);
+		{
+			Update update(*this, WayPointsChanged);
+			wayPoints.push_back(wayPoint);
+			wayPointNameIndex.emplace(wayPoint->getName(), wayPoint);
+			wayPointIdIndex.emplace(wayPoint->getObjectId(), wayPoint);
+			changeJournal.record(Change::EntityAdded, Change::WayPointEntity, wayPoint->getObjectId());
+		}
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::ObjectsCreated);
 		}
 		return wayPoint;
 	}
@@ -62,11 +245,17 @@ namespace Model
 	        const wxPoint& aPosition /*= wxPoint(-1,-1)*/,
 	        bool aNotifyObservers /*= true*/)
 	{
-		GoalPtr goal = std::make_shared<Goal>(aName, aPosition);
-		goals.push_back(goal);
+		GoalPtr goal = std::allocate_shared<Goal>(Base::PoolAllocator<Goal>(), aName, aPosition);
+		{
+			Update update(*this, GoalsChanged);
+			goals.push_back(goal);
+			goalNameIndex.emplace(goal->getName(), goal);
+			goalIdIndex.emplace(goal->getObjectId(), goal);
+			changeJournal.record(Change::EntityAdded, Change::GoalEntity, goal->getObjectId());
+		}
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::ObjectsCreated);
 		}
 		return goal;
 	}
@@ -76,32 +265,127 @@ namespace Model
 	WallPtr RobotWorld::newWall(const wxPoint& aPoint1, const wxPoint& aPoint2,
 	        bool aNotifyObservers /*= true*/)
 	{
-		WallPtr wall = std::make_shared<Wall>(aPoint1, aPoint2);
-		walls.push_back(wall);
+		WallPtr wall = std::allocate_shared<Wall>(Base::PoolAllocator<Wall>(), aPoint1, aPoint2);
+		{
+			Update update(*this, WallsChanged);
+			walls.push_back(wall);
+			wallIndex.insert(wall.get(), wall->getBoundingBox());
+			wallIdIndex.emplace(wall->getObjectId(), wall);
+			changeJournal.record(Change::EntityAdded, Change::WallEntity, wall->getObjectId());
+		}
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::ObjectsCreated);
 		}
 		return wall;
 	}
 	/**
 	 *
 	 */
-	void RobotWorld::deleteRobot(RobotPtr aRobot,
+	void RobotWorld::commit(const WorldBuilder& aWorldBuilder,
+	        bool aNotifyObservers /*= true*/)
+	{
+		const std::vector<RobotPtr>& newRobots = aWorldBuilder.getRobots();
+		const std::vector<WayPointPtr>& newWayPoints = aWorldBuilder.getWayPoints();
+		const std::vector<GoalPtr>& newGoals = aWorldBuilder.getGoals();
+		const std::vector<WallPtr>& newWalls = aWorldBuilder.getWalls();
+		unsigned int changes = 0;
+		changes |= newRobots.empty() ? 0U : static_cast<unsigned int>(RobotsChanged);
+		changes |= newWayPoints.empty() ? 0U : static_cast<unsigned int>(WayPointsChanged);
+		changes |= newGoals.empty() ? 0U : static_cast<unsigned int>(GoalsChanged);
+		changes |= newWalls.empty() ? 0U : static_cast<unsigned int>(WallsChanged);
+		{
+			Update update(*this, changes);
+
+			robots.insert(robots.end(), newRobots.begin(), newRobots.end());
+			wayPoints.insert(wayPoints.end(), newWayPoints.begin(), newWayPoints.end());
+			goals.insert(goals.end(), newGoals.begin(), newGoals.end());
+			walls.insert(walls.end(), newWalls.begin(), newWalls.end());
+
+			robotIdIndex.reserve(robots.size());
+			robotNameIndex.reserve(robots.size());
+			for (const RobotPtr& robot : newRobots)
+			{
+				robotNameIndex.emplace(robot->getName(), robot);
+				robotIdIndex.emplace(robot->getObjectId(), robot);
+				changeJournal.record(Change::EntityAdded, Change::RobotEntity, robot->getObjectId());
+			}
+			wayPointIdIndex.reserve(wayPoints.size());
+			wayPointNameIndex.reserve(wayPoints.size());
+			for (const WayPointPtr& wayPoint : newWayPoints)
+			{
+				wayPointNameIndex.emplace(wayPoint->getName(), wayPoint);
+				wayPointIdIndex.emplace(wayPoint->getObjectId(), wayPoint);
+				changeJournal.record(Change::EntityAdded, Change::WayPointEntity, wayPoint->getObjectId());
+			}
+			goalIdIndex.reserve(goals.size());
+			goalNameIndex.reserve(goals.size());
+			for (const GoalPtr& goal : newGoals)
+			{
+				goalNameIndex.emplace(goal->getName(), goal);
+				goalIdIndex.emplace(goal->getObjectId(), goal);
+				changeJournal.record(Change::EntityAdded, Change::GoalEntity, goal->getObjectId());
+			}
+			wallIdIndex.reserve(walls.size());
+			for (const WallPtr& wall : newWalls)
+			{
+				wallIndex.insert(wall.get(), wall->getBoundingBox());
+				wallIdIndex.emplace(wall->getObjectId(), wall);
+				changeJournal.record(Change::EntityAdded, Change::WallEntity, wall->getObjectId());
+			}
+			for (const std::pair<RobotPtr, wxPoint>& move : aWorldBuilder.getRobotMoves())
+			{
+				move.first->setPosition(move.second, false);
+			}
+		}
+		if (aNotifyObservers == true)
+		{
+			notifyObservers(Base::Notification::ObjectsCreated);
+		}
+	}
+	/**
+	 *
+	 */
+	void RobotWorld::replace(const WorldBuilder& aWorldBuilder,
+	        const std::vector<Base::ObjectId>& aKeepObjects,
 	        bool aNotifyObservers /*= true*/)
 	{
-		auto i = std::find_if(robots.begin(), robots.end(), [aRobot](RobotPtr r)
 		{
-			return aRobot->getName() == r->getName();
-		});
-		if (i != robots.end())
+			Update update(*this, 0);
+			unpopulate(aKeepObjects, false);
+			commit(aWorldBuilder, false);
+		}
+		if (aNotifyObservers == true)
+		{
+			notifyObservers(Base::Notification::ObjectsCreated);
+		}
+	}
+	/**
+	 *
+	 */
+	void RobotWorld::deleteRobot(RobotPtr aRobot,
+	        bool aNotifyObservers /*= true*/)
+	{
+		bool deleted = false;
 		{
-			robots.erase(i);
-			if (aNotifyObservers == true)
+			Update update(*this, RobotsChanged);
+			auto i = std::find_if(robots.begin(), robots.end(), [&aRobot](const RobotPtr& r)
 			{
-				notifyObservers();
+				return aRobot->getName() == r->getName();
+			});
+			if (i != robots.end())
+			{
+				RobotPtr robot = *i;
+				robots.erase(i);
+				unindex(robot, robots, robotNameIndex, robotIdIndex);
+				changeJournal.record(Change::EntityRemoved, Change::RobotEntity, robot->getObjectId());
+				deleted = true;
 			}
 		}
+		if (deleted && aNotifyObservers == true)
+		{
+			notifyObservers(Base::Notification::ObjectsDeleted);
+		}
 	}
 	/**
 	 *
@@ -109,332 +393,349 @@ namespace Model
 	void RobotWorld::deleteWayPoint(WayPointPtr aWayPoint,
 	        bool aNotifyObservers /*= true*/)
 	{
-		auto i = std::find_if(wayPoints.begin(), wayPoints.end(),
-		        [aWayPoint](WayPointPtr w)
-		        {
-			        return aWayPoint->getName() == w->getName();
-		        });
-		if (i != wayPoints.end())
+		bool deleted = false;
 		{
-			wayPoints.erase(i);
-			if (aNotifyObservers == true)
+			Update update(*this, WayPointsChanged);
+			auto i = std::find_if(wayPoints.begin(), wayPoints.end(),
+			        [&aWayPoint](const WayPointPtr& w)
+			        {
+				        return aWayPoint->getName() == w->getName();
+			        });
+			if (i != wayPoints.end())
 			{
-				notifyObservers();
+				WayPointPtr wayPoint = *i;
+				wayPoints.erase(i);
+				unindex(wayPoint, wayPoints, wayPointNameIndex, wayPointIdIndex);
+				changeJournal.record(Change::EntityRemoved, Change::WayPointEntity, wayPoint->getObjectId());
+				deleted = true;
 			}
 		}
+		if (deleted && aNotifyObservers == true)
+		{
+			notifyObservers(Base::Notification::ObjectsDeleted);
+		}
 	}
 	/**
 	 *
 	 */
 	void RobotWorld::deleteGoal(GoalPtr aGoal, bool aNotifyObservers /*= true*/)
 	{
-		auto i = std::find_if(goals.begin(), goals.end(), [aGoal](GoalPtr g)
+		bool deleted = false;
 		{
-			return aGoal->getName() == g->getName();
-		});
-		if (i != goals.end())
-		{
-			goals.erase(i);
-
-			if (aNotifyObservers == true)
+			Update update(*this, GoalsChanged);
+			auto i = std::find_if(goals.begin(), goals.end(), [&aGoal](const GoalPtr& g)
 			{
-				notifyObservers();
+				return aGoal->getName() == g->getName();
+			});
+			if (i != goals.end())
+			{
+				GoalPtr goal = *i;
+				goals.erase(i);
+				unindex(goal, goals, goalNameIndex, goalIdIndex);
+				changeJournal.record(Change::EntityRemoved, Change::GoalEntity, goal->getObjectId());
+				deleted = true;
 			}
 		}
+		if (deleted && aNotifyObservers == true)
+		{
+			notifyObservers(Base::Notification::ObjectsDeleted);
+		}
 	}
 	/**
 	 *
 	 */
 	void RobotWorld::deleteWall(WallPtr aWall, bool aNotifyObservers /*= true*/)
 	{
-		auto i = std::find_if(walls.begin(), walls.end(), [aWall](WallPtr w)
-		{
-			return
-			aWall->getPoint1() == w->getPoint1() &&
-			aWall->getPoint2() == w->getPoint2();
-		});
-		if (i != walls.end())
+		bool deleted = false;
 		{
-			walls.erase(i);
-
-			if (aNotifyObservers == true)
+			Update update(*this, WallsChanged);
+			auto i = std::find_if(walls.begin(), walls.end(), [&aWall](const WallPtr& w)
+			{
+				return
+				aWall->getPoint1() == w->getPoint1() &&
+				aWall->getPoint2() == w->getPoint2();
+			});
+			if (i != walls.end())
 			{
-				notifyObservers();
+				wallIndex.remove(i->get(), (*i)->getBoundingBox());
+				wallIdIndex.erase((*i)->getObjectId());
+				changeJournal.record(Change::EntityRemoved, Change::WallEntity, (*i)->getObjectId());
+				walls.erase(i);
+				deleted = true;
 			}
 		}
+		if (deleted && aNotifyObservers == true)
+		{
+			notifyObservers(Base::Notification::ObjectsDeleted);
+		}
 	}
 	/**
 	 *
 	 */
 	RobotPtr RobotWorld::getRobot(const std::string& aName) const
 	{
-		if (auto i = std::find_if(robots.begin(), robots.end(),
-		        [&aName](RobotPtr robot)
-		        {	return robot->getName() == aName;}); i != robots.end())
-		{
-			return *i;
-		}
-		return nullptr;
+		return getSnapshot()->getRobot(aName);
 	}
 	/**
 	 *
 	 */
 	RobotPtr RobotWorld::getRobot(const Base::ObjectId& anObjectId) const
 	{
-		if (auto i = std::find_if(robots.begin(), robots.end(),
-		        [&anObjectId](RobotPtr robot)
-		        {	return robot->getObjectId() == anObjectId;}); i
-		        != robots.end())
-		{
-			return *i;
-		}
-		return nullptr;
+		return getSnapshot()->getRobot(anObjectId);
 	}
 
 	RobotPtr RobotWorld::getRobot(int index) const
 	{
-		return robots.at(index);
+		return getSnapshot()->robots->at(index);
 	}
 	/**
 	 *
 	 */
 	WayPointPtr RobotWorld::getWayPoint(const std::string& aName) const
 	{
-		if (auto i = std::find_if(wayPoints.begin(), wayPoints.end(),
-		        [&aName](WayPointPtr wayPoint)
-		        {	return wayPoint->getName() == aName;}); i
-		        != wayPoints.end())
-		{
-			return *i;
-		}
-		return nullptr;
+		return getSnapshot()->getWayPoint(aName);
 	}
 	/**
 	 *
 	 */
 	WayPointPtr RobotWorld::getWayPoint(const Base::ObjectId& anObjectId) const
 	{
-		if (auto i = std::find_if(wayPoints.begin(), wayPoints.end(),
-		        [&anObjectId](WayPointPtr wayPoint)
-		        {	return wayPoint->getObjectId() == anObjectId;}); i
-		        != wayPoints.end())
-		{
-			return *i;
-		}
-		return nullptr;
+		return getSnapshot()->getWayPoint(anObjectId);
 	}
 	/**
 	 *
 	 */
 	GoalPtr RobotWorld::getGoal(const std::string& aName) const
 	{
-		if (auto i = std::find_if(goals.begin(), goals.end(),
-		        [&aName](GoalPtr goal)
-		        {	return goal->getName() == aName;}); i != goals.end())
-		{
-			return *i;
-		}
-		return nullptr;
+		return getSnapshot()->getGoal(aName);
 	}
 	/**
 	 *
 	 */
 	GoalPtr RobotWorld::getGoal(const Base::ObjectId& anObjectId) const
 	{
-		if (auto i = std::find_if(goals.begin(), goals.end(),
-		        [&anObjectId](GoalPtr goal)
-		        {	return goal->getObjectId() == anObjectId;}); i
-		        != goals.end())
-		{
-			return *i;
-		}
-		return nullptr;
+		return getSnapshot()->getGoal(anObjectId);
 	}
 	/**
 	 *
 	 */
 	WallPtr RobotWorld::getWall(const Base::ObjectId& anObjectId) const
 	{
-		if (auto i = std::find_if(walls.begin(), walls.end(),
-		        [&anObjectId](WallPtr wall)
-		        {	return wall->getObjectId() == anObjectId;}); i
-		        != walls.end())
-		{
-			return *i;
-		}
-		return nullptr;
+		return getSnapshot()->getWall(anObjectId);
 	}
 
 	/**
 	 *
 	 */
-	const std::vector<RobotPtr>& RobotWorld::getRobots() const
+	std::shared_ptr<const std::vector<RobotPtr> > RobotWorld::getRobots() const
+	{
+		return getSnapshot()->robots;
+	}
+	/**
+	 *
+	 */
+	std::shared_ptr<const std::vector<WayPointPtr> > RobotWorld::getWayPoints() const
+	{
+		return getSnapshot()->wayPoints;
+	}
+	/**
+	 *
+	 */
+	std::shared_ptr<const std::vector<GoalPtr> > RobotWorld::getGoals() const
 	{
-		return robots;
+		return getSnapshot()->goals;
 	}
 	/**
 	 *
 	 */
-	const std::vector<WayPointPtr>& RobotWorld::getWayPoints() const
+	std::shared_ptr<const std::vector<WallPtr> > RobotWorld::getWalls() const
 	{
-		return wayPoints;
+		return getSnapshot()->walls;
 	}
 	/**
 	 *
 	 */
-	const std::vector<GoalPtr>& RobotWorld::getGoals() const
+	std::vector<Wall*> RobotWorld::getWalls(const wxRect& aBoundingBox) const
 	{
-		return goals;
+		return getSnapshot()->getWalls(aBoundingBox);
 	}
 	/**
 	 *
 	 */
-	const std::vector<WallPtr>& RobotWorld::getWalls() const
+	void RobotWorld::updateWallIndex(Wall* aWall, const wxRect& anOldBoundingBox)
 	{
-		return walls;
+		Update update(*this, WallIndexChanged);
+		wallIndex.move(aWall, anOldBoundingBox, aWall->getBoundingBox());
+		changeJournal.record(Change::EntityMoved, Change::WallEntity, aWall->getObjectId());
 	}
 	/**
 	 *
 	 */
-	void populateWorld0(bool fromRequest)
+	void RobotWorld::updateNameIndex(const Base::ObjectId& anObjectId,
+	        const std::string& anOldName)
+	{
+		Update update(*this, 0);
+		if (auto i = robotIdIndex.find(anObjectId); i != robotIdIndex.end())
+		{
+			pendingChanges |= RobotsChanged;
+			reindexName(robots, robotNameIndex, anOldName);
+			reindexName(robots, robotNameIndex, i->second->getName());
+		} else if (auto j = wayPointIdIndex.find(anObjectId); j != wayPointIdIndex.end())
+		{
+			pendingChanges |= WayPointsChanged;
+			reindexName(wayPoints, wayPointNameIndex, anOldName);
+			reindexName(wayPoints, wayPointNameIndex, j->second->getName());
+		} else if (auto k = goalIdIndex.find(anObjectId); k != goalIdIndex.end())
+		{
+			pendingChanges |= GoalsChanged;
+			reindexName(goals, goalNameIndex, anOldName);
+			reindexName(goals, goalNameIndex, k->second->getName());
+		}
+	}
+	/**
+	 *
+	 */
+	void populateWorld0(WorldBuilder& aWorldBuilder, bool fromRequest)
 	{
-		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
 				if (fromRequest)
 				{
-					robotWorld.newRobot("Peer", wxPoint(50, 60), false);
-					robotWorld.newGoal("PeerGoal", wxPoint(450, 440), false);
+					aWorldBuilder.addRobot("Peer", wxPoint(50, 60));
+					aWorldBuilder.addGoal("PeerGoal", wxPoint(450, 440));
 				} else
 				{
 					Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getLocalRobot();
 					robot->setPosition(wxPoint(50, 60), false);
-					robotWorld.newGoal("YourGoal", wxPoint(450, 440), false);
+					aWorldBuilder.addGoal("YourGoal", wxPoint(450, 440));
 				}
 	}
 	/**
 	 *
 	 */
-	void populateWorld1(bool fromRequest)
+	void populateWorld1(WorldBuilder& aWorldBuilder, bool fromRequest)
 	{
-		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
 		if (fromRequest)
 		{
-			robotWorld.newRobot("Peer", wxPoint(450, 450), false);
-			robotWorld.newGoal("PeerGoal", wxPoint(50, 50), false);
+			aWorldBuilder.addRobot("Peer", wxPoint(450, 450));
+			aWorldBuilder.addGoal("PeerGoal", wxPoint(50, 50));
 		} else
 		{
 			Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getLocalRobot();
 			robot->setPosition(wxPoint(450, 450), false);
-			robotWorld.newGoal("YourGoal", wxPoint(50, 50), false);
+			aWorldBuilder.addGoal("YourGoal", wxPoint(50, 50));
 		}
 	}
 	/**
 	 *
 	 */
-	void populateWorld2(bool fromRequest)
+	void populateWorld2(WorldBuilder& aWorldBuilder, bool fromRequest)
 	{
-		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
 		if (fromRequest)
 		{
-			robotWorld.newRobot("Peer", wxPoint(40, 40), false);
-			robotWorld.newGoal("PeerGoal", wxPoint(480, 480), false);
+			aWorldBuilder.addRobot("Peer", wxPoint(40, 40));
+			aWorldBuilder.addGoal("PeerGoal", wxPoint(480, 480));
 		} else
 		{
 			Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getLocalRobot();
 			robot->setPosition(wxPoint(20, 20), false);
-			robotWorld.newGoal("YourGoal", wxPoint(480, 480), false);
+			aWorldBuilder.addGoal("YourGoal", wxPoint(480, 480));
 		}
 	}
 	/**
 	 *
 	 */
-	void populateWorld3(bool fromRequest)
+	void populateWorld3(WorldBuilder& aWorldBuilder, bool fromRequest)
 		{
-			RobotWorld& robotWorld = RobotWorld::getRobotWorld();
 			if (fromRequest)
 			{
-				robotWorld.newRobot("Peer", wxPoint(480, 40), false);
-				robotWorld.newGoal("PeerGoal", wxPoint(40, 480), false);
+				aWorldBuilder.addRobot("Peer", wxPoint(480, 40));
+				aWorldBuilder.addGoal("PeerGoal", wxPoint(40, 480));
 			} else
 			{
 				Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getLocalRobot();
 				robot->setPosition(wxPoint(480, 40), false);
-				robotWorld.newGoal("YourGoal", wxPoint(40, 480), false);
+				aWorldBuilder.addGoal("YourGoal", wxPoint(40, 480));
 			}
 		}
 
-	void wallAroundTheWorld()
+	void wallAroundTheWorld(WorldBuilder& aWorldBuilder)
 	{
-		RobotWorld::getRobotWorld().newWall(wxPoint(0,0), wxPoint(0,500), false);
-		RobotWorld::getRobotWorld().newWall(wxPoint(0,0), wxPoint(500,0), false);
-		RobotWorld::getRobotWorld().newWall(wxPoint(500,0), wxPoint(500,500), false);
-		RobotWorld::getRobotWorld().newWall(wxPoint(0,500), wxPoint(500,500), false);
+		aWorldBuilder.addWall(wxPoint(0,0), wxPoint(0,500));
+		aWorldBuilder.addWall(wxPoint(0,0), wxPoint(500,0));
+		aWorldBuilder.addWall(wxPoint(500,0), wxPoint(500,500));
+		aWorldBuilder.addWall(wxPoint(0,500), wxPoint(500,500));
 	}
 
 	/**
 	 *
 	 */
-	void populateWorld4(bool fromRequest)
+	void populateWorld4(WorldBuilder& aWorldBuilder, bool fromRequest)
 		{
-			populateWorld0(fromRequest);
-			wallAroundTheWorld();
-			RobotWorld::getRobotWorld().newWall(wxPoint(480, 300), wxPoint(150, 300), false);
+			populateWorld0(aWorldBuilder, fromRequest);
+			wallAroundTheWorld(aWorldBuilder);
+			aWorldBuilder.addWall(wxPoint(480, 300), wxPoint(150, 300));
 		}
 	/**
 	 *
 	 */
-	void populateWorld5(bool fromRequest)
+	void populateWorld5(WorldBuilder& aWorldBuilder, bool fromRequest)
 		{
-			populateWorld1(fromRequest);
-			RobotWorld::getRobotWorld().newWall(wxPoint(20, 100), wxPoint(350, 100), false);
+			populateWorld1(aWorldBuilder, fromRequest);
+			aWorldBuilder.addWall(wxPoint(20, 100), wxPoint(350, 100));
 		}
 	/**
 	 *
 	 */
 	void RobotWorld::populate(int worldNumber, bool fromRequest)
 	{
-		switch(worldNumber)
 		{
-			case 0:
+			// All objects of the world become visible in one snapshot
+			Update update(*this, 0);
+			WorldBuilder worldBuilder;
+			switch(worldNumber)
 			{
-				populateWorld0(fromRequest);
-				break;
-			}
+				case 0:
+				{
+					populateWorld0(worldBuilder, fromRequest);
+					break;
+				}
 
-			case 1:
-			{
-				populateWorld1(fromRequest);
-				break;
-			}
+				case 1:
+				{
+					populateWorld1(worldBuilder, fromRequest);
+					break;
+				}
 
-			case 2:
-			{
-				populateWorld2(fromRequest);
-				break;
-			}
+				case 2:
+				{
+					populateWorld2(worldBuilder, fromRequest);
+					break;
+				}
 
-			case 3:
-			{
-				populateWorld3(fromRequest);
-				break;
-			}
+				case 3:
+				{
+					populateWorld3(worldBuilder, fromRequest);
+					break;
+				}
 
-			case 4:
-			{
-				populateWorld4(fromRequest);
-				break;
-			}
-			case 5:
-			{
-				populateWorld5(fromRequest);
-				break;
-			}
-			default:
-			{
-				break;
+				case 4:
+				{
+					populateWorld4(worldBuilder, fromRequest);
+					break;
+				}
+				case 5:
+				{
+					populateWorld5(worldBuilder, fromRequest);
+					break;
+				}
+				default:
+				{
+					break;
+				}
 			}
+			worldBuilder.commit(false);
 		}
 
-		notifyObservers();
+		notifyObservers(Base::Notification::ObjectsCreated);
 	}
 	/**
 	 *
@@ -442,14 +743,24 @@ namespace Model
 	void RobotWorld::unpopulate(bool aNotifyObservers /*= true*/)
 	{
 		localRobot->setPosition(wxPoint(-1, -1), aNotifyObservers);
-		robots.clear();
-		wayPoints.clear();
-		goals.clear();
-		walls.clear();
+		{
+			Update update(*this, AllChanged);
+			const std::vector<Base::ObjectId> keepNothing;
+			recordRemovals(robots, keepNothing, changeJournal, Change::RobotEntity);
+			recordRemovals(wayPoints, keepNothing, changeJournal, Change::WayPointEntity);
+			recordRemovals(goals, keepNothing, changeJournal, Change::GoalEntity);
+			recordRemovals(walls, keepNothing, changeJournal, Change::WallEntity);
+			robots.clear();
+			wayPoints.clear();
+			goals.clear();
+			walls.clear();
+			wallIndex.clear();
+			rebuildIndexes();
+		}
 
 		if (aNotifyObservers)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::ObjectsDeleted);
 		}
 	}
 	/**
@@ -458,84 +769,98 @@ namespace Model
 	void RobotWorld::unpopulate(const std::vector<Base::ObjectId>& aKeepObjects,
 	        bool aNotifyObservers /*= true*/)
 	{
-		if (robots.size() > 0)
-		{
-			robots.erase(
-			        std::remove_if(robots.begin(), robots.end(),
-			                [&aKeepObjects](
-			                        RobotPtr aRobot)
-			                        {
-				                        return std::find( aKeepObjects.begin(),
-						                        aKeepObjects.end(),
-						                        aRobot->getObjectId()) == aKeepObjects.end();
-			                        }), robots.end());
-		}
-		if (wayPoints.size() > 0)
-		{
-			wayPoints.erase(
-			        std::remove_if(wayPoints.begin(), wayPoints.end(),
-			                [&aKeepObjects](
-			                        WayPointPtr aWayPoint)
-			                        {
-				                        return std::find( aKeepObjects.begin(),
-						                        aKeepObjects.end(),
-						                        aWayPoint->getObjectId()) == aKeepObjects.end();
-			                        }), wayPoints.end());
-		}
-		if (goals.size() > 0)
-		{
-			goals.erase(
-			        std::remove_if(goals.begin(), goals.end(),
-			                [&aKeepObjects](
-			                        GoalPtr aGoal)
-			                        {
-				                        return std::find( aKeepObjects.begin(),
-						                        aKeepObjects.end(),
-						                        aGoal->getObjectId()) == aKeepObjects.end();
-			                        }), goals.end());
-		}
-		if (walls.size() > 0)
-		{
-			walls.erase(
-			        std::remove_if(walls.begin(), walls.end(),
-			                [&aKeepObjects](
-			                        WallPtr aWall)
-			                        {
-				                        return std::find( aKeepObjects.begin(),
-						                        aKeepObjects.end(),
-						                        aWall->getObjectId()) == aKeepObjects.end();
-			                        }), walls.end());
+		{
+			Update update(*this, AllChanged);
+			recordRemovals(robots, aKeepObjects, changeJournal, Change::RobotEntity);
+			recordRemovals(wayPoints, aKeepObjects, changeJournal, Change::WayPointEntity);
+			recordRemovals(goals, aKeepObjects, changeJournal, Change::GoalEntity);
+			recordRemovals(walls, aKeepObjects, changeJournal, Change::WallEntity);
+			if (robots.size() > 0)
+			{
+				robots.erase(
+				        std::remove_if(robots.begin(), robots.end(),
+				                [&aKeepObjects](
+				                        const RobotPtr& aRobot)
+				                        {
+					                        return std::find( aKeepObjects.begin(),
+							                        aKeepObjects.end(),
+							                        aRobot->getObjectId()) == aKeepObjects.end();
+				                        }), robots.end());
+			}
+			if (wayPoints.size() > 0)
+			{
+				wayPoints.erase(
+				        std::remove_if(wayPoints.begin(), wayPoints.end(),
+				                [&aKeepObjects](
+				                        const WayPointPtr& aWayPoint)
+				                        {
+					                        return std::find( aKeepObjects.begin(),
+							                        aKeepObjects.end(),
+							                        aWayPoint->getObjectId()) == aKeepObjects.end();
+				                        }), wayPoints.end());
+			}
+			if (goals.size() > 0)
+			{
+				goals.erase(
+				        std::remove_if(goals.begin(), goals.end(),
+				                [&aKeepObjects](
+				                        const GoalPtr& aGoal)
+				                        {
+					                        return std::find( aKeepObjects.begin(),
+							                        aKeepObjects.end(),
+							                        aGoal->getObjectId()) == aKeepObjects.end();
+				                        }), goals.end());
+			}
+			if (walls.size() > 0)
+			{
+				walls.erase(
+				        std::remove_if(walls.begin(), walls.end(),
+				                [&aKeepObjects](
+				                        const WallPtr& aWall)
+				                        {
+					                        return std::find( aKeepObjects.begin(),
+							                        aKeepObjects.end(),
+							                        aWall->getObjectId()) == aKeepObjects.end();
+				                        }), walls.end());
+			}
+			wallIndex.clear();
+			for (const WallPtr& wall : walls)
+			{
+				wallIndex.insert(wall.get(), wall->getBoundingBox());
+			}
+			rebuildIndexes();
 		}
 
 		if (aNotifyObservers)
 		{
-			notifyObservers();
+			notifyObservers(Base::Notification::ObjectsDeleted);
 		}
 	}
 	std::string RobotWorld::asCode() const
 	{
+		WorldSnapshotPtr world = getSnapshot();
 		std::ostringstream os;
 		os << "\n\n";
-		for (RobotPtr ptr : robots)
+		for (const RobotPtr& ptr : *world->robots)
 		{
 			os << "RobotWorld::getRobotWorld().newRobot( \"" << ptr->getName()
 			        << "\", wxPoint(" << ptr->getPosition().x << ","
 			        << ptr->getPosition().y << "),false);\n";
 		}
-		for (WallPtr ptr : walls)
+		for (const WallPtr& ptr : *world->walls)
 		{
 			os << "RobotWorld::getRobotWorld().newWall( " << "wxPoint("
 			        << ptr->getPoint1().x << "," << ptr->getPoint1().y << "),"
 			        << "wxPoint(" << ptr->getPoint2().x << ","
 			        << ptr->getPoint2().y << "),false);\n";
 		}
-		for (WayPointPtr ptr : wayPoints)
+		for (const WayPointPtr& ptr : *world->wayPoints)
 		{
 			os << "RobotWorld::getRobotWorld().newWayPoint( \""
 			        << ptr->getName() << "\", wxPoint(" << ptr->getPosition().x
 			        << "," << ptr->getPosition().y << "),false);\n";
 		}
-		for (GoalPtr ptr : goals)
+		for (const GoalPtr& ptr : *world->goals)
 		{
 			os << "RobotWorld::getRobotWorld().newGoal( \"" << ptr->getName()
 			        << "\", wxPoint(" << ptr->getPosition().x << ","
@@ -556,23 +881,24 @@ namespace Model
 	 */
 	std::string RobotWorld::asDebugString() const
 	{
+		WorldSnapshotPtr world = getSnapshot();
 		std::ostringstream os;
 
 		os << asString() << '\n';
 
-		for (RobotPtr ptr : robots)
+		for (const RobotPtr& ptr : *world->robots)
 		{
 			os << ptr->asDebugString() << '\n';
 		}
-		for (WayPointPtr ptr : wayPoints)
+		for (const WayPointPtr& ptr : *world->wayPoints)
 		{
 			os << ptr->asDebugString() << '\n';
 		}
-		for (GoalPtr ptr : goals)
+		for (const GoalPtr& ptr : *world->goals)
 		{
 			os << ptr->asDebugString() << '\n';
 		}
-		for (WallPtr ptr : walls)
+		for (const WallPtr& ptr : *world->walls)
 		{
 			os << ptr->asDebugString() << '\n';
 		}
@@ -590,7 +916,94 @@ namespace Model
 
 	void RobotWorld::reverseRobotVector()
 	{
+		Update update(*this, RobotsChanged);
 		std::reverse(robots.begin(), robots.end());
+		// The first robot with a name may have changed
+		rebuildIndexes();
+	}
+	/**
+	 *
+	 */
+	WorldSnapshotPtr RobotWorld::getSnapshot() const
+	{
+		return std::atomic_load(&snapshot);
+	}
+	/**
+	 *
+	 */
+	ChangeJournal& RobotWorld::getChangeJournal()
+	{
+		return changeJournal;
+	}
+	/**
+	 *
+	 */
+	void RobotWorld::publishSnapshot(unsigned int aChanges)
+	{
+		// The vectors and indexes that did not change are shared with the current snapshot
+		std::shared_ptr<WorldSnapshot> nextSnapshot = std::make_shared<WorldSnapshot>(*std::atomic_load(&snapshot));
+		++nextSnapshot->version;
+		if (aChanges & RobotsChanged)
+		{
+			nextSnapshot->robots = std::make_shared<const std::vector<RobotPtr> >(robots);
+			nextSnapshot->robotNameIndex = std::make_shared<const std::unordered_map<std::string, RobotPtr> >(robotNameIndex);
+			nextSnapshot->robotIdIndex = std::make_shared<const std::unordered_map<Base::ObjectId, RobotPtr> >(robotIdIndex);
+		}
+		if (aChanges & WayPointsChanged)
+		{
+			nextSnapshot->wayPoints = std::make_shared<const std::vector<WayPointPtr> >(wayPoints);
+			nextSnapshot->wayPointNameIndex = std::make_shared<const std::unordered_map<std::string, WayPointPtr> >(wayPointNameIndex);
+			nextSnapshot->wayPointIdIndex = std::make_shared<const std::unordered_map<Base::ObjectId, WayPointPtr> >(wayPointIdIndex);
+		}
+		if (aChanges & GoalsChanged)
+		{
+			nextSnapshot->goals = std::make_shared<const std::vector<GoalPtr> >(goals);
+			nextSnapshot->goalNameIndex = std::make_shared<const std::unordered_map<std::string, GoalPtr> >(goalNameIndex);
+			nextSnapshot->goalIdIndex = std::make_shared<const std::unordered_map<Base::ObjectId, GoalPtr> >(goalIdIndex);
+		}
+		if (aChanges & WallsChanged)
+		{
+			nextSnapshot->walls = std::make_shared<const std::vector<WallPtr> >(walls);
+			nextSnapshot->wallIdIndex = std::make_shared<const std::unordered_map<Base::ObjectId, WallPtr> >(wallIdIndex);
+		}
+		if (aChanges & (WallsChanged | WallIndexChanged))
+		{
+			// Shares the blocks of the grid that did not change with the current snapshot
+			nextSnapshot->wallIndex = std::make_shared<const Utils::SpatialGrid<Wall*> >(wallIndex);
+		}
+		std::atomic_store(&snapshot, WorldSnapshotPtr(nextSnapshot));
+	}
+	/**
+	 *
+	 */
+	void RobotWorld::rebuildIndexes()
+	{
+		robotNameIndex.clear();
+		robotIdIndex.clear();
+		for (const RobotPtr& robot : robots)
+		{
+			robotNameIndex.emplace(robot->getName(), robot);
+			robotIdIndex.emplace(robot->getObjectId(), robot);
+		}
+		wayPointNameIndex.clear();
+		wayPointIdIndex.clear();
+		for (const WayPointPtr& wayPoint : wayPoints)
+		{
+			wayPointNameIndex.emplace(wayPoint->getName(), wayPoint);
+			wayPointIdIndex.emplace(wayPoint->getObjectId(), wayPoint);
+		}
+		goalNameIndex.clear();
+		goalIdIndex.clear();
+		for (const GoalPtr& goal : goals)
+		{
+			goalNameIndex.emplace(goal->getName(), goal);
+			goalIdIndex.emplace(goal->getObjectId(), goal);
+		}
+		wallIdIndex.clear();
+		for (const WallPtr& wall : walls)
+		{
+			wallIdIndex.emplace(wall->getObjectId(), wall);
+		}
 	}
 
 	/**
@@ -3,9 +3,16 @@
 
 #include "Config.hpp"
 
+#include "ChangeJournal.hpp"
 #include "ModelObject.hpp"
+#include "SpatialGrid.hpp"
 #include "Widgets.hpp"
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Model
@@ -25,12 +32,88 @@ namespace Model
 	class RobotWorld;
 	typedef std::shared_ptr<RobotWorld> RobotWorldPtr;
 
+	class WorldBuilder;
+
+	/**
+	 * An immutable version of the contents of the world and its indexes. The vectors and indexes are shared between
+	 * versions: a change of the walls only copies the walls and their indexes, the other vectors and indexes of the
+	 * next version are those of this version. A wall that moves only copies the blocks of the wall index it leaves
+	 * and enters, see Utils::SpatialGrid.
+	 *
+	 * A reader that holds a snapshot sees a consistent set of objects for as long as it holds the snapshot, whatever
+	 * the writers do. The objects themselves are not immutable, see e.g. Robot::getState.
+	 */
+	struct WorldSnapshot
+	{
+			/**
+			 *
+			 * @return the first robot with aName, nullptr if there is none
+			 */
+			RobotPtr getRobot( const std::string& aName) const;
+			/**
+			 *
+			 */
+			RobotPtr getRobot( const Base::ObjectId& anObjectId) const;
+			/**
+			 *
+			 */
+			WayPointPtr getWayPoint( const std::string& aName) const;
+			/**
+			 *
+			 */
+			WayPointPtr getWayPoint( const Base::ObjectId& anObjectId) const;
+			/**
+			 *
+			 */
+			GoalPtr getGoal( const std::string& aName) const;
+			/**
+			 *
+			 */
+			GoalPtr getGoal( const Base::ObjectId& anObjectId) const;
+			/**
+			 *
+			 */
+			WallPtr getWall( const Base::ObjectId& anObjectId) const;
+			/**
+			 * Uses the wall index of the snapshot so only the walls near aBoundingBox are visited.
+			 *
+			 * @return the walls whose bounding box intersects aBoundingBox. The walls are owned by the snapshot.
+			 */
+			std::vector< Wall* > getWalls( const wxRect& aBoundingBox) const;
+
+			std::uint64_t version = 0;
+			std::shared_ptr< const std::vector< RobotPtr > > robots;
+			std::shared_ptr< const std::vector< WayPointPtr > > wayPoints;
+			std::shared_ptr< const std::vector< GoalPtr > > goals;
+			std::shared_ptr< const std::vector< WallPtr > > walls;
+			std::shared_ptr< const Utils::SpatialGrid< Wall* > > wallIndex;
+			/**
+			 * Hash indexes of the vectors. A name maps to the first object in the vector with that name,
+			 * which is the object a linear search would find.
+			 */
+			std::shared_ptr< const std::unordered_map< std::string, RobotPtr > > robotNameIndex;
+			std::shared_ptr< const std::unordered_map< Base::ObjectId, RobotPtr > > robotIdIndex;
+			std::shared_ptr< const std::unordered_map< std::string, WayPointPtr > > wayPointNameIndex;
+			std::shared_ptr< const std::unordered_map< Base::ObjectId, WayPointPtr > > wayPointIdIndex;
+			std::shared_ptr< const std::unordered_map< std::string, GoalPtr > > goalNameIndex;
+			std::shared_ptr< const std::unordered_map< Base::ObjectId, GoalPtr > > goalIdIndex;
+			std::shared_ptr< const std::unordered_map< Base::ObjectId, WallPtr > > wallIdIndex;
+	};
+	typedef std::shared_ptr< const WorldSnapshot > WorldSnapshotPtr;
+
 	/**
 	 *
 	 */
 	class RobotWorld : 	public ModelObject
 	{
 		public:
+			/**
+			 * Makes the changes of the world while it exists a single version that is published when the outermost
+			 * Batch ends, so adding many objects one by one costs one copy of the vectors instead of one per object.
+			 * Other writers wait until the Batch ends and getSnapshot returns the version before the Batch until then,
+			 * also on the thread of the Batch.
+			 */
+			class Batch;
 			/**
 			 *
 			 */
@@ -59,6 +142,18 @@ namespace Model
 			WallPtr newWall(const wxPoint& aPoint1,
 							const wxPoint& aPoint2,
 							bool aNotifyObservers = true);
+			/**
+			 * Adds all objects of aWorldBuilder as one change, see WorldBuilder
+			 */
+			void commit(	const WorldBuilder& aWorldBuilder,
+							bool aNotifyObservers = true);
+			/**
+			 * Removes all objects except aKeepObjects and adds all objects of aWorldBuilder as one change, so readers
+			 * never see the empty world in between
+			 */
+			void replace(	const WorldBuilder& aWorldBuilder,
+							const std::vector< Base::ObjectId >& aKeepObjects,
+							bool aNotifyObservers = true);
 			/**
 			 *
 			 */
@@ -109,22 +204,57 @@ namespace Model
 			 *
 			 */
 			WallPtr getWall( const Base::ObjectId& anObjectId) const;
+			/**
+			 * Safe to call from any thread, never blocks. The changes of the writers are published when the outermost
+			 * change ends, a writer does not see its own changes before that.
+			 *
+			 * @return the current version of the world
+			 */
+			WorldSnapshotPtr getSnapshot() const;
+			/**
+			 * Robots, waypoints, goals and walls that are added, removed or moved are recorded in the journal
+			 */
+			ChangeJournal& getChangeJournal();
+			/**
+			 * The vectors returned by getRobots, getWayPoints, getGoals and getWalls are those of the current snapshot.
+			 * The caller must keep the returned pointer for as long as it uses the vector.
+			 */
+			std::shared_ptr< const std::vector< RobotPtr > > getRobots() const;
 			/**
 			 *
 			 */
-			const std::vector< RobotPtr >& getRobots() const;
+			std::shared_ptr< const std::vector< WayPointPtr > > getWayPoints() const;
 			/**
 			 *
 			 */
-			const std::vector< WayPointPtr >& getWayPoints() const;
+			std::shared_ptr< const std::vector< GoalPtr > > getGoals() const;
 			/**
 			 *
 			 */
-			const std::vector< GoalPtr >& getGoals() const;
+			std::shared_ptr< const std::vector< WallPtr > > getWalls() const;
 			/**
+			 * Uses the wall index of the current snapshot so only the walls near aBoundingBox are visited.
 			 *
+			 * @return the walls whose bounding box intersects aBoundingBox. The walls are owned by the world.
 			 */
-			const std::vector< WallPtr >& getWalls() const;
+			std::vector< Wall* > getWalls( const wxRect& aBoundingBox) const;
+			/**
+			 * Must be called when the points of aWall change so the wall index stays in sync.
+			 * Records the move of aWall in the change journal.
+			 *
+			 * @param aWall
+			 * @param anOldBoundingBox The bounding box of aWall before the change
+			 */
+			void updateWallIndex(	Wall* aWall,
+									const wxRect& anOldBoundingBox);
+			/**
+			 * Must be called when the name of a robot, waypoint or goal changes so the name indexes stay in sync
+			 *
+			 * @param anObjectId The ObjectId of the renamed robot, waypoint or goal
+			 * @param anOldName The name before the change
+			 */
+			void updateNameIndex(	const Base::ObjectId& anObjectId,
+									const std::string& anOldName);
 			/**
 			 *
 			 */
@@ -174,14 +304,101 @@ namespace Model
 
 		private:
 			/**
+			 * The parts of the world that changed since the last snapshot
+			 */
+			enum Changes : unsigned int
+			{
+				RobotsChanged = 1,
+				WayPointsChanged = 2,
+				GoalsChanged = 4,
+				WallsChanged = 8,
+				/**
+				 * A wall moved, the vector and the ObjectId index of the walls did not change
+				 */
+				WallIndexChanged = 16,
+				AllChanged = RobotsChanged | WayPointsChanged | GoalsChanged | WallsChanged | WallIndexChanged
+			};
+			/**
+			 * Serialises the writers. The changes are published as the next snapshot when the outermost Update ends,
+			 * so nested changes, e.g. all changes of populate, become a single version.
+			 */
+			class Update
+			{
+				public:
+					Update(	RobotWorld& aRobotWorld,
+							unsigned int aChanges);
+					~Update();
+					Update( const Update&) = delete;
+					Update& operator=( const Update&) = delete;
+
+				private:
+					RobotWorld& robotWorld;
+			};
+			friend class Update;
+			/**
+			 * Publishes the next snapshot with copies of the changed vectors and their indexes.
+			 * The writerMutex must be locked.
+			 */
+			void publishSnapshot( unsigned int aChanges);
+			/**
+			 * Rebuilds the hash indexes from the vectors
+			 */
+			void rebuildIndexes();
+
+			/**
+			 * The vectors and indexes below are only accessed by the writers, the readers use the snapshot.
 			 * The vectors are mutable to allow for lazy instantiation
 			 */
 			mutable std::vector< RobotPtr > robots;
 			mutable std::vector< WayPointPtr > wayPoints;
 			mutable std::vector< GoalPtr > goals;
 			mutable std::vector< WallPtr > walls;
+			/**
+			 * Spatial index of the bounding boxes of the walls
+			 */
+			Utils::SpatialGrid< Wall* > wallIndex;
+			/**
+			 * Hash indexes of the vectors. A name maps to the first object in the vector with that name,
+			 * which is the object a linear search would find.
+			 */
+			std::unordered_map< std::string, RobotPtr > robotNameIndex;
+			std::unordered_map< Base::ObjectId, RobotPtr > robotIdIndex;
+			std::unordered_map< std::string, WayPointPtr > wayPointNameIndex;
+			std::unordered_map< Base::ObjectId, WayPointPtr > wayPointIdIndex;
+			std::unordered_map< std::string, GoalPtr > goalNameIndex;
+			std::unordered_map< Base::ObjectId, GoalPtr > goalIdIndex;
+			std::unordered_map< Base::ObjectId, WallPtr > wallIdIndex;
 
 			RobotPtr localRobot;
+
+			mutable std::recursive_mutex writerMutex;
+			unsigned int updateDepth;
+			/**
+			 * The changes of the current Update that are not yet published
+			 */
+			unsigned int pendingChanges;
+			/**
+			 * Only accessed with std::atomic_load and std::atomic_store
+			 */
+			WorldSnapshotPtr snapshot;
+
+			ChangeJournal changeJournal;
+	};
+
+	/**
+	 *
+	 */
+	class RobotWorld::Batch
+	{
+		public:
+			explicit Batch( RobotWorld& aRobotWorld) :
+								update( aRobotWorld, 0)
+			{
+			}
+
+		private:
+			Update update;
 	};
+	//	class RobotWorld::Batch
 } // namespace Model
 #endif // ROBOTWORLD_HPP_
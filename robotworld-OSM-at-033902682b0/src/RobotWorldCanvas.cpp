@@ -4,6 +4,7 @@
 #include "GoalShape.hpp"
 #include "LineShape.hpp"
 #include "Logger.hpp"
+#include "MainApplication.hpp"
 #include "NotificationEvent.hpp"
 #include "RectangleShape.hpp"
 #include "Robot.hpp"
@@ -14,8 +15,12 @@
 #include "WallShape.hpp"
 #include "WayPoint.hpp"
 #include "WayPointShape.hpp"
+#include "WorldFile.hpp"
+#include "WorldTextFile.hpp"
+#include "WxDCRenderer.hpp"
 
 #include <algorithm>
+#include <string>
 
 namespace View
 {
@@ -36,7 +41,9 @@ namespace View
 		ID_DELETE_WALL,
 		ID_SHAPE_INFO,
 		ID_WORLD_INFO,
-		ID_GENERATE_WORLD_CODE
+		ID_GENERATE_WORLD_CODE,
+		ID_SAVE_WORLD_FILE,
+		ID_REPAINT_TIMER
 	};
 
 	/**
@@ -56,7 +63,12 @@ namespace View
 								selectionEnabled( false),
 								menuItemEnabled( false),
 								dandEnabled( true),
-								notificationHandler( nullptr)
+								notificationHandler( nullptr),
+								lastSeenChange( 0),
+								synchroniseNeeded( false),
+								coalescedNotifications( 0),
+								backgroundLayerValid( false),
+								nextShapeOrder( 0)
 	{
 		// CppCheck gives a "virtualCallInConstructor" on initialise(). I don't know why.
 		// It cannot be suppressed by a "cppcheck-suppress virtualCallInConstructor" (10-4-2022)
@@ -83,7 +95,12 @@ namespace View
 									selectionEnabled( false),
 									menuItemEnabled( false),
 									dandEnabled( true),
-									notificationHandler( nullptr)
+									notificationHandler( nullptr),
+									lastSeenChange( 0),
+									synchroniseNeeded( false),
+									coalescedNotifications( 0),
+									backgroundLayerValid( false),
+									nextShapeOrder( 0)
 	{
 		// CppCheck gives a "virtualCallInConstructor" on initialise(). I don't know why.
 		// It cannot be suppressed by a "cppcheck-suppress virtualCallInConstructor" (10-4-2022)
@@ -94,7 +111,8 @@ namespace View
 	 */
 	RobotWorldCanvas::~RobotWorldCanvas()
 	{
-		shapes.clear();
+		repaintTimer.Stop();
+		clearShapes();
 
 		PopEventHandler();
 
@@ -373,22 +391,26 @@ namespace View
 	 */
 	bool RobotWorldCanvas::isShapeAt( const wxPoint& aPoint) const
 	{
-		return  std::any_of(shapes.begin(), 
-							shapes.end(), 
-							[&aPoint](ShapePtr aShape)
-							{ 
-								return aShape->occupies( aPoint);
-							});		
+		return getShapeAt( aPoint) != nullptr;
 	}
 	/**
 	 *
 	 */
 	ShapePtr RobotWorldCanvas::getShapeAt( const wxPoint& aPoint) const
 	{
-		if(	auto i = std::find_if(shapes.begin(),shapes.end(),[&aPoint](ShapePtr shape){return shape->occupies( aPoint);});
-			i != shapes.end())
+		std::unique_lock< std::mutex > lock( shapeIndexMutex);
+		const IndexedShape* result = nullptr;
+		for (Shape* candidate : shapeIndex.query( wxRect( aPoint, wxSize( 1, 1))))
 		{
-			return *i;
+			const IndexedShape& indexedShape = indexedShapes.at( candidate);
+			if ((result == nullptr || indexedShape.order < result->order) && candidate->occupies( aPoint))
+			{
+				result = &indexedShape;
+			}
+		}
+		if (result != nullptr)
+		{
+			return result->shape;
 		}
 		return nullptr;
 	}
@@ -397,10 +419,9 @@ namespace View
 	 */
 	bool RobotWorldCanvas::selectShapeAt( const wxPoint& aPoint)
 	{
-		if(	auto i = std::find_if(shapes.begin(),shapes.end(),[&aPoint](ShapePtr shape){return shape->occupies( aPoint);});
-			i != shapes.end())
+		if (ShapePtr shape = getShapeAt( aPoint))
 		{
-			setSelectedShape( *i);
+			setSelectedShape( shape);
 			return true;
 		}
 		return false;
@@ -422,7 +443,7 @@ namespace View
 	/**
 	 *
 	 */
-	void RobotWorldCanvas::handleNotification()
+	void RobotWorldCanvas::handleNotification( const Base::Notification& UNUSEDPARAM(aNotification))
 	{
 		handleBackGroundNotification();
 	}
@@ -431,11 +452,28 @@ namespace View
 	 */
 	void RobotWorldCanvas::handleBackGroundNotification()
 	{
-		// Posting the message will put the notification event in the applications
-		// message loop, hence making sure it is handled in the main thread.
-		wxNotifyEvent event( Base::EVT_NOTIFICATIONEVENT, 1000);
-		wxPostEvent( notificationHandler, event);
-		//notificationHandler->ProcessEvent(event);
+		// The repaint timer handles the flag in the main thread, an event per notification would flood the
+		// message loop of the application
+		if (synchroniseNeeded.exchange( true))
+		{
+			++coalescedNotifications;
+		}
+	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::handleBackGroundRepaint( Shape& aShape)
+	{
+		if (!aShape.getModelObject())
+		{
+			return;
+		}
+
+		std::unique_lock< std::mutex > lock( dirtyShapesMutex);
+		if (!dirtyShapes.insert( aShape.getModelObject()->getObjectId()).second)
+		{
+			++coalescedNotifications;
+		}
 	}
 
 	/**
@@ -450,7 +488,7 @@ namespace View
 	 */
 	void RobotWorldCanvas::unpopulate()
 	{
-		shapes.clear();
+		clearShapes();
 		Model::RobotWorld::getRobotWorld().unpopulate();
 	}
 
@@ -465,6 +503,15 @@ namespace View
 		Bind( wxEVT_PAINT, &RobotWorldCanvas::OnPaint, this);
 		Bind( wxEVT_SIZE, &RobotWorldCanvas::OnSize, this);
 
+		unsigned long framesPerSecond = 60;
+		if (Application::MainApplication::isArgGiven( "-fps"))
+		{
+			framesPerSecond = std::max( std::stoul( Application::MainApplication::getArg( "-fps").value), 1UL);
+		}
+		repaintTimer.SetOwner( this, ID_REPAINT_TIMER);
+		Bind( wxEVT_TIMER, &RobotWorldCanvas::OnRepaintTimer, this, ID_REPAINT_TIMER);
+		repaintTimer.Start( static_cast< int >( std::max( 1000 / framesPerSecond, 1UL)));
+
 		SetBackgroundColour(  "WHITE");
 		SetFocus();
 
@@ -492,18 +539,68 @@ namespace View
 
 		enableItemMenuHandling();
 
-		handleNotificationsFor( Model::RobotWorld::getRobotWorld());
+		handleNotificationsFor( Model::RobotWorld::getRobotWorld(), Base::Notification::ObjectsCreated | Base::Notification::ObjectsDeleted);
+	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::Refresh(	bool eraseBackground /*= true*/,
+									const wxRect* aRect /*= nullptr*/)
+	{
+		if (aRect == nullptr)
+		{
+			backgroundLayerValid = false;
+		}
+		wxScrolledCanvas::Refresh( eraseBackground, aRect);
 	}
 	/**
 	 *
 	 */
-	void RobotWorldCanvas::render( wxDC& dc)
+	void RobotWorldCanvas::render(	wxDC& dc,
+									const wxRegion& anUpdateRegion /*= wxRegion()*/)
 	{
-		for (ShapePtr shape : shapes)
+		if (!backgroundLayerValid || !backgroundLayer.IsOk() || backgroundLayer.GetSize() != GetClientSize())
+		{
+			renderBackgroundLayer();
+		}
+
+		if (anUpdateRegion.IsEmpty())
 		{
+			dc.DrawBitmap( backgroundLayer, 0, 0);
+		} else
+		{
+			wxMemoryDC backgroundDC;
+			backgroundDC.SelectObjectAsSource( backgroundLayer);
+			for (wxRegionIterator i( anUpdateRegion); i; ++i)
+			{
+				wxRect rect = i.GetRect();
+				dc.Blit( rect.x, rect.y, rect.width, rect.height, &backgroundDC, rect.x, rect.y);
+			}
+			backgroundDC.SelectObject( wxNullBitmap);
+		}
+
+		WxDCRenderer renderer( dc);
+		for (const ShapePtr& shape : shapes)
+		{
+			if (shape->isStatic())
+			{
+				continue;
+			}
+			wxRect boundingBox = shape->getBoundingBox();
+			wxRect decorationBoundingBox = shape->getDecorationBoundingBox();
+			if (!anUpdateRegion.IsEmpty() && anUpdateRegion.Contains( boundingBox) == wxOutRegion
+			        && (decorationBoundingBox.IsEmpty() || anUpdateRegion.Contains( decorationBoundingBox) == wxOutRegion))
+			{
+				continue;
+			}
 			//		Logger::log("Drawing shape: " + shape->asString());
-			shape->draw( dc);
+			shape->draw( renderer);
 			//		Logger::log("Done drawing shape: " + shape->asString());
+
+			// Drawing may change the size of the shape, e.g. to fit its title
+			shape->addPaintedBoundingBox( boundingBox.Union( shape->getBoundingBox()));
+			shape->addPaintedDecorationBoundingBox( decorationBoundingBox);
+			indexShape( *shape, shape->getBoundingBox());
 		}
 		if (startActionShape != nullptr && actionStatus == DRAWING)
 		{
@@ -511,13 +608,37 @@ namespace View
 			dc.DrawLine( startActionShape->getCentre().x, startActionShape->getCentre().y, endActionPoint.x, endActionPoint.y);
 		}
 	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::renderBackgroundLayer()
+	{
+		wxSize size = GetClientSize();
+		backgroundLayer.Create( std::max( size.x, 1), std::max( size.y, 1));
+
+		wxMemoryDC dc( backgroundLayer);
+		dc.SetBackground( wxBrush( GetBackgroundColour()));
+		dc.Clear();
+		WxDCRenderer renderer( dc);
+		for (const ShapePtr& shape : shapes)
+		{
+			if (shape->isStatic())
+			{
+				shape->draw( renderer);
+				indexShape( *shape, shape->getBoundingBox());
+			}
+		}
+		dc.SelectObject( wxNullBitmap);
+
+		backgroundLayerValid = true;
+	}
 	/**
 	 *
 	 */
 	void RobotWorldCanvas::handlePaint( wxPaintEvent& UNUSEDPARAM(event))
 	{
 		wxPaintDC dc( this);
-		render( dc);
+		render( dc, GetUpdateRegion());
 	}
 	/**
 	 *
@@ -594,7 +715,7 @@ namespace View
 				if (startRectangleShape && endRectangeShape)
 				{
 					ShapePtr lineShape = std::make_shared<LineShape>( startRectangleShape, endRectangeShape);
-					shapes.push_back( lineShape);
+					addGenericShape( lineShape);
 				}
 				break;
 			}
@@ -995,9 +1116,9 @@ namespace View
 		ShapePtr wall = std::make_shared<WallShape>(Model::RobotWorld::getRobotWorld().newWall( start->getCentre(), end->getCentre(),false),
 													start,
 													end);
-		shapes.push_back( wall);
-		shapes.push_back( start);
-		shapes.push_back( end);
+		addGenericShape( wall);
+		addGenericShape( start);
+		addGenericShape( end);
 
 		Refresh();
 	}
@@ -1035,19 +1156,80 @@ namespace View
 	 */
 	void RobotWorldCanvas::handleNotification( wxNotifyEvent& UNUSEDPARAM(aNotifyEvent))
 	{
-		remove<Model::Robot,View::RobotShape>( Model::RobotWorld::getRobotWorld().getRobots());
-		add<Model::Robot,View::RobotShape>( Model::RobotWorld::getRobotWorld().getRobots());
+		synchroniseShapes();
+		Refresh();
+	}
+	/**
+	 *
+	 */
+	bool RobotWorldCanvas::synchroniseShapes()
+	{
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		bool staticShapesChanged = false;
 
-		remove<Model::WayPoint,View::WayPointShape>( Model::RobotWorld::getRobotWorld().getWayPoints());
-		add<Model::WayPoint,View::WayPointShape>( Model::RobotWorld::getRobotWorld().getWayPoints());
+		// Only the objects that were added or removed since the last notification are synchronised
+		std::vector< Model::Change > changes;
+		if (robotWorld.getChangeJournal().getChangesSince( lastSeenChange, changes))
+		{
+			for (const Model::Change& change : changes)
+			{
+				lastSeenChange = change.sequence;
+				if (change.entity != Model::Change::RobotEntity)
+				{
+					staticShapesChanged = true;
+				}
+				if (change.type == Model::Change::EntityMoved)
+				{
+					// The shapes draw the current position of their ModelObject
+					continue;
+				}
+				switch (change.entity)
+				{
+					case Model::Change::RobotEntity:
+					{
+						synchronise< Model::Robot, View::RobotShape >( change.objectId, robotWorld.getRobot( change.objectId));
+						break;
+					}
+					case Model::Change::WayPointEntity:
+					{
+						synchronise< Model::WayPoint, View::WayPointShape >( change.objectId, robotWorld.getWayPoint( change.objectId));
+						break;
+					}
+					case Model::Change::GoalEntity:
+					{
+						synchronise< Model::Goal, View::GoalShape >( change.objectId, robotWorld.getGoal( change.objectId));
+						break;
+					}
+					case Model::Change::WallEntity:
+					{
+						synchronise< Model::Wall, View::WallShape >( change.objectId, robotWorld.getWall( change.objectId));
+						break;
+					}
+				}
+			}
+		} else
+		{
+			// Too far behind, synchronise with the whole world
+			lastSeenChange = robotWorld.getChangeJournal().getLastSequence();
 
-		remove<Model::Goal,View::GoalShape>( Model::RobotWorld::getRobotWorld().getGoals());
-		add<Model::Goal,View::GoalShape>( Model::RobotWorld::getRobotWorld().getGoals());
+			// The notification may come from another thread, the snapshot is consistent while that thread changes the world
+			Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
 
-		remove<Model::Wall,View::WallShape>( Model::RobotWorld::getRobotWorld().getWalls());
-		add<Model::Wall,View::WallShape>( Model::RobotWorld::getRobotWorld().getWalls());
+			remove<Model::Robot,View::RobotShape>( *world->robots);
+			add<Model::Robot,View::RobotShape>( *world->robots);
 
-		Refresh();
+			remove<Model::WayPoint,View::WayPointShape>( *world->wayPoints);
+			add<Model::WayPoint,View::WayPointShape>( *world->wayPoints);
+
+			remove<Model::Goal,View::GoalShape>( *world->goals);
+			add<Model::Goal,View::GoalShape>( *world->goals);
+
+			remove<Model::Wall,View::WallShape>( *world->walls);
+			add<Model::Wall,View::WallShape>( *world->walls);
+
+			staticShapesChanged = true;
+		}
+		return staticShapesChanged;
 	}
 	/**
 	 *
@@ -1100,6 +1282,11 @@ namespace View
 			 [this](wxCommandEvent& anEvent){ this->OnGenerateWorldCode(anEvent);},
 			 ID_GENERATE_WORLD_CODE);
 
+		popupMenu.Append( ID_SAVE_WORLD_FILE, _T( "Save world file"), _T( "ID_SAVE_WORLD_FILE2"));
+		Bind(wxEVT_COMMAND_MENU_SELECTED,
+			 [this](wxCommandEvent& anEvent){ this->OnSaveWorldFile(anEvent);},
+			 ID_SAVE_WORLD_FILE);
+
 		popupMenu.Append( wxID_ABOUT, _T( "About"), _T( "Show about dialog"));
 		PopupMenu( &popupMenu);
 	}
@@ -1166,8 +1353,9 @@ namespace View
 	void RobotWorldCanvas::addShape( RobotShapePtr aRobotShape)
 	{
 		aRobotShape->setRobotWorldCanvas(this);
-		aRobotShape->handleNotificationsFor(*aRobotShape->getRobot());
-		shapes.push_back( std::dynamic_pointer_cast< Shape >( aRobotShape));
+		// A change of the name or the size changes the title and the body of the shape as well
+		aRobotShape->handleNotificationsFor(*aRobotShape->getRobot(), Base::Notification::PositionChanged | Base::Notification::PathChanged | Base::Notification::AttributesChanged);
+		addGenericShape( std::dynamic_pointer_cast< Shape >( aRobotShape));
 	}
 	/**
 	 *
@@ -1175,7 +1363,7 @@ namespace View
 	void RobotWorldCanvas::addShape( GoalShapePtr aGoalShape)
 	{
 		aGoalShape->handleNotificationsFor(*aGoalShape->getGoal());
-		shapes.push_back( std::dynamic_pointer_cast< Shape >( aGoalShape));
+		addGenericShape( std::dynamic_pointer_cast< Shape >( aGoalShape));
 	}
 	/**
 	 *
@@ -1183,7 +1371,7 @@ namespace View
 	void RobotWorldCanvas::addShape( WayPointShapePtr aWayPointShape)
 	{
 		aWayPointShape->handleNotificationsFor(*aWayPointShape->getWayPoint());
-		shapes.push_back( std::dynamic_pointer_cast< Shape >( aWayPointShape));
+		addGenericShape( std::dynamic_pointer_cast< Shape >( aWayPointShape));
 	}
 	/**
 	 *
@@ -1198,9 +1386,9 @@ namespace View
 		aWallShape->setNode1(start);
 		aWallShape->setNode2(end);
 
-		shapes.push_back( start);
-		shapes.push_back( end);
-		shapes.push_back( aWallShape);
+		addGenericShape( start);
+		addGenericShape( end);
+		addGenericShape( aWallShape);
 	}
 	/**
 	 *
@@ -1234,28 +1422,147 @@ namespace View
 	 */
 	void RobotWorldCanvas::removeShape( WallShapePtr aWallShape)
 	{
-		RectangleShapePtr start = aWallShape->hasEndPointAt( aWallShape->getBegin());
-		RectangleShapePtr end = aWallShape->hasEndPointAt( aWallShape->getEnd());
 		Model::RobotWorld::getRobotWorld().deleteWall( aWallShape->getWall(), false);
-		removeGenericShape( aWallShape);
-		removeGenericShape( start);
-		removeGenericShape( end);
+		std::vector< ShapePtr > removedShapes;
+		collectShapes( aWallShape, removedShapes);
+		removeGenericShapes( removedShapes);
+	}
+	/**
+	 *
+	 */
+	ShapePtr RobotWorldCanvas::findShape( const Base::ObjectId& anObjectId) const
+	{
+		auto shape = modelShapes.find( anObjectId);
+		if (shape != modelShapes.end())
+		{
+			return shape->second;
+		}
+		return nullptr;
+	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::addGenericShape( ShapePtr aShape)
+	{
+		shapes.push_back( aShape);
+
+		wxRect boundingBox = aShape->getBoundingBox();
+		{
+			std::unique_lock< std::mutex > lock( shapeIndexMutex);
+			indexedShapes[aShape.get()] = IndexedShape{ aShape, boundingBox, nextShapeOrder++};
+			shapeIndex.insert( aShape.get(), boundingBox);
+		}
+
+		if (aShape->getModelObject())
+		{
+			modelShapes[aShape->getModelObject()->getObjectId()] = aShape;
+		}
 	}
 	/**
 	 *
 	 */
 	void RobotWorldCanvas::removeGenericShape( ShapePtr aShape)
 	{
-		if (isShapeSelected() && aShape->getObjectId() == getSelectedShape()->getObjectId())
+		removeGenericShapes( std::vector< ShapePtr >{ aShape});
+	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::removeGenericShapes( const std::vector< ShapePtr >& aShapes)
+	{
+		std::unordered_set< Shape* > removedShapes;
+		{
+			std::unique_lock< std::mutex > lock( dirtyShapesMutex);
+			for (const ShapePtr& shape : aShapes)
+			{
+				// Before the last reference may go, see ViewObject::stopObserving
+				shape->stopObserving();
+				if (shape->getModelObject())
+				{
+					dirtyShapes.erase( shape->getModelObject()->getObjectId());
+				}
+			}
+		}
+		for (const ShapePtr& shape : aShapes)
+		{
+			if (isShapeSelected() && shape->getObjectId() == getSelectedShape()->getObjectId())
+			{
+				setSelectedShape( nullptr);
+			}
+			{
+				std::unique_lock< std::mutex > lock( shapeIndexMutex);
+				auto indexedShape = indexedShapes.find( shape.get());
+				if (indexedShape == indexedShapes.end())
+				{
+					// Not (or no longer) one of the shapes
+					continue;
+				}
+				shapeIndex.remove( indexedShape->first, indexedShape->second.boundingBox);
+				indexedShapes.erase( indexedShape);
+			}
+			if (shape->getModelObject())
+			{
+				modelShapes.erase( shape->getModelObject()->getObjectId());
+			}
+			removedShapes.insert( shape.get());
+		}
+		if (!removedShapes.empty())
+		{
+			shapes.erase( std::remove_if(	shapes.begin(),
+											shapes.end(),
+											[&removedShapes](const ShapePtr& aShape)
+											{
+												return removedShapes.find( aShape.get()) != removedShapes.end();
+											}),
+						shapes.end());
+		}
+	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::collectShapes(	const ShapePtr& aShape,
+											std::vector< ShapePtr >& aShapes)
+	{
+		aShapes.push_back( aShape);
+		if (WallShapePtr wallShape = std::dynamic_pointer_cast< WallShape >( aShape))
+		{
+			for (const RectangleShapePtr& endPoint : { wallShape->hasEndPointAt( wallShape->getBegin()), wallShape->hasEndPointAt( wallShape->getEnd())})
+			{
+				if (endPoint)
+				{
+					aShapes.push_back( endPoint);
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::indexShape(	Shape& aShape,
+										const wxRect& aBoundingBox)
+	{
+		std::unique_lock< std::mutex > lock( shapeIndexMutex);
+		auto indexedShape = indexedShapes.find( &aShape);
+		if (indexedShape != indexedShapes.end() && indexedShape->second.boundingBox != aBoundingBox)
 		{
-			setSelectedShape( nullptr);
+			shapeIndex.move( &aShape, indexedShape->second.boundingBox, aBoundingBox);
+			indexedShape->second.boundingBox = aBoundingBox;
 		}
-		shapes.erase( std::find_if( shapes.begin(),
-									shapes.end(),
-									[aShape](ShapePtr s)
-									{
-										return aShape->getObjectId() == s->getObjectId();
-									}));
+	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::clearShapes()
+	{
+		for (const ShapePtr& shape : shapes)
+		{
+			shape->stopObserving();
+		}
+		shapes.clear();
+		std::unique_lock< std::mutex > lock( shapeIndexMutex);
+		shapeIndex.clear();
+		indexedShapes.clear();
+		modelShapes.clear();
 	}
 	/**
 	 *
@@ -1453,12 +1760,38 @@ namespace View
 	void RobotWorldCanvas::OnWorldInfo( wxCommandEvent& UNUSEDPARAM(event))
 	{
 		Application::Logger::log( Model::RobotWorld::getRobotWorld().asDebugString());
+		Application::Logger::log( "Coalesced notifications: " + std::to_string( coalescedNotifications));
 	}
 
 	void RobotWorldCanvas::OnGenerateWorldCode( wxCommandEvent& UNUSEDPARAM(event))
 	{
 		Application::Logger::log( Model::RobotWorld::getRobotWorld().asCode());
 	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::OnSaveWorldFile( wxCommandEvent& UNUSEDPARAM(event))
+	{
+		wxString fileName = wxFileSelector( "Save world file", wxEmptyString, "world.rww", "rww", "World files (*.rww)|*.rww|Text world files (*.txt)|*.txt", wxFD_SAVE | wxFD_OVERWRITE_PROMPT, this);
+		if (!fileName.empty())
+		{
+			try
+			{
+				if (fileName.EndsWith( ".txt"))
+				{
+					Model::WorldTextFile::save( fileName.ToStdString());
+				} else
+				{
+					Model::WorldFile::save( fileName.ToStdString(), 10);
+				}
+				Application::Logger::log( "Saved the world to " + fileName.ToStdString());
+			}
+			catch (std::exception& e)
+			{
+				Application::Logger::log( e.what());
+			}
+		}
+	}
 	/**
 	 *
 	 */
@@ -1466,4 +1799,60 @@ namespace View
 	{
 		handleNotification(aNotifyEvent);
 	}
+	/**
+	 *
+	 */
+	void RobotWorldCanvas::OnRepaintTimer( wxTimerEvent& UNUSEDPARAM(event))
+	{
+		std::unordered_set< Base::ObjectId > changedShapes;
+		{
+			std::unique_lock< std::mutex > lock( dirtyShapesMutex);
+			changedShapes.swap( dirtyShapes);
+		}
+
+		if (synchroniseNeeded.exchange( false))
+		{
+			// Shapes were added or removed, the whole canvas is repainted but the background layer is only
+			// redrawn if static shapes were added or removed
+			if (synchroniseShapes())
+			{
+				backgroundLayerValid = false;
+			}
+			wxScrolledCanvas::Refresh();
+			return;
+		}
+
+		// Only the old and the new area of the changed shapes are repainted
+		for (const Base::ObjectId& objectId : changedShapes)
+		{
+			ShapePtr shape = findShape( objectId);
+			if (!shape)
+			{
+				continue;
+			}
+			if (!shape->getPaintedBoundingBox().IsEmpty())
+			{
+				RefreshRect( shape->getPaintedBoundingBox());
+			}
+			wxRect boundingBox = shape->getBoundingBox();
+			RefreshRect( boundingBox);
+			shape->setPaintedBoundingBox( boundingBox);
+			indexShape( *shape, boundingBox);
+
+			// The decoration, e.g. the path of a robot, mostly stays where it is while the shape moves
+			wxRect decorationBoundingBox = shape->getDecorationBoundingBox();
+			if (decorationBoundingBox != shape->getPaintedDecorationBoundingBox())
+			{
+				if (!shape->getPaintedDecorationBoundingBox().IsEmpty())
+				{
+					RefreshRect( shape->getPaintedDecorationBoundingBox());
+				}
+				if (!decorationBoundingBox.IsEmpty())
+				{
+					RefreshRect( decorationBoundingBox);
+				}
+				shape->setPaintedDecorationBoundingBox( decorationBoundingBox);
+			}
+		}
+	}
 } // namespace View
@@ -6,9 +6,15 @@
 #include "NotificationHandler.hpp"
 #include "RobotWorld.hpp"
 #include "Shape.hpp"
+#include "SpatialGrid.hpp"
 #include "ViewObject.hpp"
 #include "Widgets.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace View
@@ -149,19 +155,45 @@ namespace View
 			//@{
 			/**
 			 * A Notifier will call this function if this Observer will handle the notifications of that
-			 * Notifier. It is the responsibility of the Observer to filter any events it is interested in.
+			 * Notifier. The canvas subscribes to the creation and deletion of the objects of the world.
 			 * This function should only be called from the main thread because wxWidgets does not allow
 			 * for painting widgets in a background thread: all painting should be done in the main thread.
 			 * Therefore all notifications are routed to handleBackGroundNotification() as a convenience.
 			 *
 			 */
-			virtual void handleNotification() override;
+			virtual void handleNotification( const Base::Notification& aNotification) override;
 			//@}
 			/**
 			 * A Notifier that runs in a background thread should call this function instead of handleNotification().
-			 * handleNotification() is routed to this function as a convenience. Bad for performance though.
+			 * handleNotification() is routed to this function as a convenience.
+			 *
+			 * Only marks the canvas dirty. The repaint timer synchronises the shapes with the world and repaints
+			 * the canvas in the main thread, at most -fps times per second (default 60).
 			 */
 			virtual void handleBackGroundNotification();
+			/**
+			 * Marks aShape for a repaint without synchronising the shapes with the world, for the shapes that
+			 * follow their own ModelObject. The repaint timer invalidates only the rectangle aShape was painted in
+			 * and the rectangle it occupies now, and its decoration only if that changed.
+			 *
+			 * Called from the thread of the NotificationDispatcher, so only the ObjectId is recorded. The repaint
+			 * timer reads the bounding box and moves aShape in the shape index on the GUI thread.
+			 */
+			virtual void handleBackGroundRepaint( Shape& aShape);
+			/**
+			 *
+			 * @return the number of notifications that did not cost a repaint of their own because the canvas was
+			 * 		   already dirty
+			 */
+			unsigned long getCoalescedNotifications() const
+			{
+				return coalescedNotifications;
+			}
+			/**
+			 * A refresh of the whole canvas also redraws the background layer, a refresh of a rectangle does not
+			 */
+			virtual void Refresh(	bool eraseBackground = true,
+									const wxRect* aRect = nullptr) override;
 			/**
 			 * Asks the world to populates itself with a robot, a goal and the given number of walls
 			 */
@@ -176,9 +208,15 @@ namespace View
 			 */
 			void initialise();
 			/**
-			 *
+			 * Copies the background layer and draws the dynamic shapes that intersect anUpdateRegion, everything if
+			 * anUpdateRegion is empty
 			 */
-			void render( wxDC& dc);
+			void render(	wxDC& dc,
+							const wxRegion& anUpdateRegion = wxRegion());
+			/**
+			 * Draws the static shapes in the background layer
+			 */
+			void renderBackgroundLayer();
 			/**
 			 * @name Event handling functions
 			 *
@@ -228,6 +266,13 @@ namespace View
 			virtual void handleNotification( wxNotifyEvent& aNotifyEvent);
 
 			//@}
+			/**
+			 * Adds the shapes for the objects that were added to RobotWorld and removes the shapes of the objects
+			 * that were removed
+			 *
+			 * @return true if static shapes were added or removed
+			 */
+			bool synchroniseShapes();
 			virtual void handleActivation( ShapePtr aShape);
 			virtual void handleSelection( ShapePtr aShape);
 			/**
@@ -271,10 +316,37 @@ namespace View
 			 *
 			 */
 			void removeShape( WallShapePtr aWallShape);
+			/**
+			 *
+			 */
+			void addGenericShape( ShapePtr aShape);
 			/**
 			 *
 			 */
 			void removeGenericShape( ShapePtr aShape);
+			/**
+			 * Removes all of aShapes in a single pass over shapes, the order of the remaining shapes is kept
+			 */
+			void removeGenericShapes( const std::vector< ShapePtr >& aShapes);
+			/**
+			 * Appends aShape and the shapes that are part of it, i.e. the end points of a wall, to aShapes
+			 */
+			void collectShapes(	const ShapePtr& aShape,
+								std::vector< ShapePtr >& aShapes);
+			/**
+			 * Moves aShape in the shape index if its bounding box changed. May be called from any thread.
+			 */
+			void indexShape(	Shape& aShape,
+								const wxRect& aBoundingBox);
+			/**
+			 *
+			 */
+			void clearShapes();
+			/**
+			 *
+			 * @return the Shape that looks at the ModelObject with anObjectId, nullptr if there is none
+			 */
+			ShapePtr findShape( const Base::ObjectId& anObjectId) const;
 		private:
 			/**
 			 * @name Event handlers
@@ -323,7 +395,11 @@ namespace View
 
 			void OnGenerateWorldCode( wxCommandEvent& event);
 
+			void OnSaveWorldFile( wxCommandEvent& event);
+
 			void OnNotificationEvent( wxNotifyEvent& aNotifyEvent);
+
+			void OnRepaintTimer( wxTimerEvent& event);
 			//@}
 
 			std::vector< ShapePtr > shapes;
@@ -357,6 +433,67 @@ namespace View
 			bool dandEnabled;
 
 			Base::NotificationHandler< std::function< void( wxNotifyEvent&) > > * notificationHandler;
+			/**
+			 * The sequence number of the last change of the change journal of RobotWorld that is handled
+			 */
+			std::uint64_t lastSeenChange;
+			/**
+			 * Drives the repaints, see handleBackGroundNotification
+			 */
+			wxTimer repaintTimer;
+			std::atomic< bool > synchroniseNeeded;
+			std::atomic< unsigned long > coalescedNotifications;
+			/**
+			 * The ObjectIds of the ModelObjects of the shapes that changed since the last tick of the repaint timer.
+			 * The timer looks the shapes up in modelShapes, a shape that was removed in the meantime is skipped.
+			 */
+			std::mutex dirtyShapesMutex;
+			std::unordered_set< Base::ObjectId > dirtyShapes;
+			/**
+			 * The static shapes drawn once, see Shape::isStatic
+			 */
+			wxBitmap backgroundLayer;
+			bool backgroundLayerValid;
+			/**
+			 * The bounding boxes of the shapes, without their decoration, so that a hit test only asks the shapes
+			 * under the point whether they occupy it. The order is the position in shapes, the first shape in
+			 * shapes wins as before.
+			 *
+			 * The shapes that follow their ModelObject are moved in the index by the repaint timer, see
+			 * handleBackGroundRepaint. shapeIndex and indexedShapes are guarded by shapeIndexMutex.
+			 */
+			struct IndexedShape
+			{
+					ShapePtr shape;
+					wxRect boundingBox;
+					unsigned long order;
+			};
+			mutable std::mutex shapeIndexMutex;
+			Utils::SpatialGrid< Shape* > shapeIndex;
+			std::unordered_map< Shape*, IndexedShape > indexedShapes;
+			unsigned long nextShapeOrder;
+			/**
+			 * The shapes by the ObjectId of their ModelObject, see findShape
+			 */
+			std::unordered_map< Base::ObjectId, ShapePtr > modelShapes;
+
+			/**
+			 * Adds a Shape for aT if there is no Shape for anObjectId, removes the Shape for anObjectId if aT is
+			 * nullptr, i.e. if the ModelObject is no longer in RobotWorld
+			 */
+			template< typename T, typename S >
+			void synchronise(	const Base::ObjectId& anObjectId,
+								const std::shared_ptr< T >& aT)
+			{
+				ShapePtr shape = findShape( anObjectId);
+				if (aT && !shape)
+				{
+					addShape( std::shared_ptr< S >( new S( aT)));
+				} else if (!aT && shape)
+				{
+					removeShape( std::dynamic_pointer_cast< S >( shape));
+				}
+			}
 
 			/**
 			 * This function removes all Shapes that look at a ModelObject that is not longer in RobotWorld
@@ -364,28 +501,22 @@ namespace View
 			template< typename T, typename S >
 			void remove( const std::vector<std::shared_ptr< T > >& aTs)
 			{
-				std::vector< ShapePtr> shapePtrs;
-				std::copy_if(	shapes.begin(),
-								shapes.end(),
-								std::back_inserter(shapePtrs),
-								[&aTs](ShapePtr aShape)
-								{
-									std::shared_ptr< S > shape = std::dynamic_pointer_cast< S >( aShape);
-									if (shape)
-									{
-										return std::find_if(	aTs.begin(),
-																aTs.end(),
-																[shape](std::shared_ptr< T > aT)
-																{
-																	return shape->getModelObject()->getObjectId() == aT->getObjectId();
-																}) == aTs.end();
-									}
-									return false;
-								});
-				for(ShapePtr shape : shapePtrs)
+				std::unordered_set< Base::ObjectId > objectIds;
+				for(const std::shared_ptr< T >& t : aTs)
 				{
-					removeShape( std::dynamic_pointer_cast< S >( shape));
+					objectIds.insert( t->getObjectId());
+				}
+
+				// The ModelObjects are already gone from RobotWorld, only the shapes are removed
+				std::vector< ShapePtr > removedShapes;
+				for (const std::pair< const Base::ObjectId, ShapePtr >& modelShape : modelShapes)
+				{
+					if (objectIds.find( modelShape.first) == objectIds.end() && std::dynamic_pointer_cast< S >( modelShape.second))
+					{
+						collectShapes( modelShape.second, removedShapes);
+					}
 				}
+				removeGenericShapes( removedShapes);
 			}
 			/**
 			 * This function add Shapes for ModelObjects that are in RobotWorld but that have no Shape yet
@@ -395,17 +526,7 @@ namespace View
 			{
 				for(std::shared_ptr< T > t : aTs)
 				{
-					auto result = std::find_if(	shapes.begin(),
-												shapes.end(),
-												[t](ShapePtr aShape)
-												{
-													if(aShape->getModelObject())
-													{
-														return aShape->getModelObject()->getObjectId() == t->getObjectId();
-													}
-													return false;
-												});
-					if( result == shapes.end())
+					if( !findShape( t->getObjectId()))
 					{
 						addShape(std::shared_ptr< S >(new S(t)));
 					}
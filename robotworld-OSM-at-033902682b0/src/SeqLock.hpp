@@ -0,0 +1,115 @@
+#ifndef SEQLOCK_HPP_
+#define SEQLOCK_HPP_
+
+#include "Config.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace Base
+{
+	/**
+	 * A sequence lock: a value that is published by writers and read by any number of readers without
+	 * blocking them. A writer increments the sequence number before and after it writes the value; a reader copies the
+	 * value and retries if the sequence number was odd or changed while it copied.
+	 *
+	 * Readers never block a writer and never block each other. A reader only retries if it overlaps with a write,
+	 * which is rare if the value is published once per tick. Writers are serialised by a mutex.
+	 *
+	 * @tparam T The type of the value, it must be trivially copyable
+	 */
+	template< typename T >
+	class SeqLock
+	{
+			static_assert( std::is_trivially_copyable< T >::value, "A SeqLock can only hold trivially copyable values");
+
+		public:
+			/**
+			 *
+			 */
+			SeqLock() :
+							SeqLock( T())
+			{
+			}
+			/**
+			 *
+			 */
+			explicit SeqLock( const T& aValue) :
+							sequence( 0)
+			{
+				store( aValue);
+			}
+			/**
+			 * Publishes aValue
+			 */
+			void store( const T& aValue)
+			{
+				std::uint64_t buffer[numberOfWords] = {};
+				std::memcpy( buffer, &aValue, sizeof(T));
+
+				std::unique_lock< std::mutex > lock( writerMutex);
+				std::uint64_t currentSequence = sequence.load( std::memory_order_relaxed);
+				sequence.store( currentSequence + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence( std::memory_order_release);
+				for (std::size_t i = 0; i < numberOfWords; ++i)
+				{
+					words[i].store( buffer[i], std::memory_order_relaxed);
+				}
+				sequence.store( currentSequence + 2, std::memory_order_release);
+			}
+			/**
+			 *
+			 * @return the last published value
+			 */
+			T load() const
+			{
+				std::uint64_t buffer[numberOfWords];
+				for (;;)
+				{
+					std::uint64_t before = sequence.load( std::memory_order_acquire);
+					if (before & 1)
+					{
+						// A write is in progress
+						std::this_thread::yield();
+						continue;
+					}
+					for (std::size_t i = 0; i < numberOfWords; ++i)
+					{
+						buffer[i] = words[i].load( std::memory_order_relaxed);
+					}
+					std::atomic_thread_fence( std::memory_order_acquire);
+					if (sequence.load( std::memory_order_relaxed) == before)
+					{
+						break;
+					}
+				}
+
+				T value;
+				std::memcpy( &value, buffer, sizeof(T));
+				return value;
+			}
+			/**
+			 *
+			 * @return the number of values that were published
+			 */
+			std::uint64_t getVersion() const
+			{
+				return sequence.load( std::memory_order_acquire) / 2;
+			}
+
+		private:
+			static const std::size_t numberOfWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+			std::atomic< std::uint64_t > sequence;
+			std::array< std::atomic< std::uint64_t >, numberOfWords > words;
+			std::mutex writerMutex;
+	};
+	//	class SeqLock
+} // namespace Base
+
+#endif // SEQLOCK_HPP_
@@ -4,6 +4,7 @@
 #include "Config.hpp"
 
 #include "ObjectId.hpp"
+#include "Renderer.hpp"
 #include "ViewObject.hpp"
 #include "Widgets.hpp"
 
@@ -56,7 +57,9 @@ namespace View
 			Shape() :
 				ViewObject(),
 				data( nullptr),
-				selected( false)
+				selected( false),
+				paintedBoundingBox(),
+				paintedDecorationBoundingBox()
 		{
 		}
 			/**
@@ -65,7 +68,9 @@ namespace View
 			explicit Shape(Model::ModelObjectPtr aModelObject) :
 				ViewObject(aModelObject),
 				data( nullptr),
-				selected( false)
+				selected( false),
+				paintedBoundingBox(),
+				paintedDecorationBoundingBox()
 			{
 				handleNotificationsFor( *aModelObject);
 			}
@@ -80,7 +85,7 @@ namespace View
 			/**
 			 *
 			 */
-			virtual void draw( wxDC& dc) = 0;
+			virtual void draw( Renderer& renderer) = 0;
 			/**
 			 *
 			 * @param aPoint
@@ -95,7 +100,21 @@ namespace View
 			 *
 			 */
 			virtual void setCentre( const wxPoint& aPoint) = 0;
+			/**
+			 *
+			 * @return the rectangle that contains the shape itself as draw() paints it in the current state
+			 */
+			virtual wxRect getBoundingBox() const = 0;
 			//@}
+			/**
+			 *
+			 * @return the rectangle that contains what draw() paints apart from the shape itself, e.g. the path of
+			 * a robot, empty if there is nothing else
+			 */
+			virtual wxRect getDecorationBoundingBox() const
+			{
+				return wxRect();
+			}
 			/**
 			 * @name Accessors and mutators
 			 */
@@ -150,6 +169,61 @@ namespace View
 			{
 				return getCentre();
 			}
+			/**
+			 * A static Shape is drawn in the background layer of the RobotWorldCanvas, which is only redrawn when
+			 * the static shapes change
+			 */
+			virtual bool isStatic() const
+			{
+				return true;
+			}
+			/**
+			 * The RobotWorldCanvas invalidates this rectangle to erase the Shape when it changes
+			 *
+			 * @return the union of the bounding boxes the Shape was painted with since it was last invalidated
+			 */
+			const wxRect& getPaintedBoundingBox() const
+			{
+				return paintedBoundingBox;
+			}
+			/**
+			 *
+			 */
+			void setPaintedBoundingBox( const wxRect& aBoundingBox)
+			{
+				paintedBoundingBox = aBoundingBox;
+			}
+			/**
+			 *
+			 */
+			void addPaintedBoundingBox( const wxRect& aBoundingBox)
+			{
+				paintedBoundingBox = paintedBoundingBox.IsEmpty() ? aBoundingBox : paintedBoundingBox.Union( aBoundingBox);
+			}
+			/**
+			 * The same as getPaintedBoundingBox for getDecorationBoundingBox
+			 */
+			const wxRect& getPaintedDecorationBoundingBox() const
+			{
+				return paintedDecorationBoundingBox;
+			}
+			/**
+			 *
+			 */
+			void setPaintedDecorationBoundingBox( const wxRect& aBoundingBox)
+			{
+				paintedDecorationBoundingBox = aBoundingBox;
+			}
+			/**
+			 *
+			 */
+			void addPaintedDecorationBoundingBox( const wxRect& aBoundingBox)
+			{
+				if (!aBoundingBox.IsEmpty())
+				{
+					paintedDecorationBoundingBox = paintedDecorationBoundingBox.IsEmpty() ? aBoundingBox : paintedDecorationBoundingBox.Union( aBoundingBox);
+				}
+			}
 			//@}
 			/**
 			 * This function is called by the RobotWorldCanvas if enableActivation is set for the RobotWorldCanvas.
@@ -202,6 +276,8 @@ namespace View
 		private:
 			ShapeData* data;
 			bool selected;
+			wxRect paintedBoundingBox;
+			wxRect paintedDecorationBoundingBox;
 	};
 	//	class Shape
 } // namespace View
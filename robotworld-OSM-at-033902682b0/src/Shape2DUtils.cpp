@@ -217,6 +217,93 @@ namespace Utils
 		}
 		return true;
 	}
+	/**
+	 *
+	 */
+	/* static */bool Shape2DUtils::intersectsPolygon(	const wxPoint* aPolygon,
+														int aNumberOfPoints,
+														const wxPoint& aStartLine,
+														const wxPoint& anEndLine)
+	{
+		for (int i = 0; i < aNumberOfPoints; ++i)
+		{
+			if (intersect( aPolygon[i], aPolygon[(i + 1) % aNumberOfPoints], aStartLine, anEndLine))
+			{
+				return true;
+			}
+		}
+		// No edge is crossed so the line is either completely inside or completely outside
+		return isInsidePolygon( aPolygon, aNumberOfPoints, aStartLine);
+	}
+	/**
+	 *
+	 */
+	/* static */std::vector< wxPoint > Shape2DUtils::getConvexHull( std::vector< wxPoint > aPoints)
+	{
+		// Andrew's monotone chain
+		if (aPoints.size() < 3)
+		{
+			return aPoints;
+		}
+
+		std::sort( aPoints.begin(), aPoints.end(), []( const wxPoint& lhs, const wxPoint& rhs)
+		{
+			return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);
+		});
+
+		auto cross = []( const wxPoint& o, const wxPoint& a, const wxPoint& b)
+		{
+			return static_cast< long long >( a.x - o.x) * (b.y - o.y) - static_cast< long long >( a.y - o.y) * (b.x - o.x);
+		};
+
+		std::vector< wxPoint > hull( 2 * aPoints.size());
+		std::size_t k = 0;
+		// Lower hull
+		for (std::size_t i = 0; i < aPoints.size(); ++i)
+		{
+			while (k >= 2 && cross( hull[k - 2], hull[k - 1], aPoints[i]) <= 0)
+			{
+				--k;
+			}
+			hull[k++] = aPoints[i];
+		}
+		// Upper hull
+		for (std::size_t i = aPoints.size() - 1, lower = k + 1; i > 0; --i)
+		{
+			while (k >= lower && cross( hull[k - 2], hull[k - 1], aPoints[i - 1]) <= 0)
+			{
+				--k;
+			}
+			hull[k++] = aPoints[i - 1];
+		}
+		// The last point is the first point
+		hull.resize( k - 1);
+		return hull;
+	}
+	/**
+	 *
+	 */
+	/* static */wxRect Shape2DUtils::getBoundingBox(	const wxPoint* aPoints,
+														int aNumberOfPoints)
+	{
+		if (aNumberOfPoints <= 0)
+		{
+			return wxRect();
+		}
+
+		int left = aPoints[0].x;
+		int top = aPoints[0].y;
+		int right = left;
+		int bottom = top;
+		for (int i = 1; i < aNumberOfPoints; ++i)
+		{
+			left = std::min( left, aPoints[i].x);
+			top = std::min( top, aPoints[i].y);
+			right = std::max( right, aPoints[i].x);
+			bottom = std::max( bottom, aPoints[i].y);
+		}
+		return wxRect( wxPoint( left, top), wxPoint( right, bottom));
+	}
 	/**
 	 *
 	 */
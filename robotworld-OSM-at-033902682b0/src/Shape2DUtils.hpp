@@ -9,6 +9,7 @@
 #include "Size.hpp"
 
 #include <string>
+#include <vector>
 
 namespace Utils
 {
@@ -74,6 +75,32 @@ namespace Utils
 			static bool isInsidePolygon( 	const wxPoint* aPolygon,
 											int aNumberOfPoints,
 											const wxPoint& aPoint);
+			/**
+			 *
+			 * @param aPolygon The array of points
+			 * @param aNumberOfPoints The number of points in the array
+			 * @param aStartLine
+			 * @param anEndLine
+			 * @return True if the line intersects an edge of the polygon or lies completely inside the polygon
+			 */
+			static bool intersectsPolygon(	const wxPoint* aPolygon,
+											int aNumberOfPoints,
+											const wxPoint& aStartLine,
+											const wxPoint& anEndLine);
+			/**
+			 *
+			 * @param aPoints
+			 * @return the counterclockwise convex hull of the points, without collinear points
+			 */
+			static std::vector< wxPoint > getConvexHull( std::vector< wxPoint > aPoints);
+			/**
+			 *
+			 * @param aPoints The array of points
+			 * @param aNumberOfPoints The number of points in the array
+			 * @return the smallest rectangle that contains all points
+			 */
+			static wxRect getBoundingBox(	const wxPoint* aPoints,
+											int aNumberOfPoints);
 			/**
 			 *
 			 * @param aStartpoint
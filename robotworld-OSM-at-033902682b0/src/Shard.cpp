@@ -0,0 +1,537 @@
+#include "Shard.hpp"
+
+#include "Client.hpp"
+#include "Goal.hpp"
+#include "Logger.hpp"
+#include "MainApplication.hpp"
+#include "Message.hpp"
+#include "MessageTypes.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Trace.hpp"
+#include "Wall.hpp"
+#include "WayPoint.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace Model
+{
+	namespace
+	{
+		/**
+		 * A handoff without response is sent again after this time
+		 */
+		const std::chrono::seconds handoffTimeout( 2);
+		/**
+		 * Robots closer than this to a border are mirrored to the neighbour: the reach of a robot on either side of
+		 * the border plus the distance a robot moves between two updates
+		 */
+		const int haloWidth = 100;
+	} // namespace
+
+	/**
+	 *
+	 */
+	std::string Shard::Handoff::asString() const
+	{
+		std::ostringstream os;
+		// The name is last because it may contain spaces
+		os << position.x << " " << position.y << " " << acting << " " << name;
+		return os.str();
+	}
+	/**
+	 *
+	 */
+	/* static */Shard::Handoff Shard::Handoff::fromString( const std::string& aString)
+	{
+		Handoff handoff;
+		std::istringstream is( aString);
+		is >> handoff.position.x >> handoff.position.y >> handoff.acting;
+		is.get();
+		std::getline( is, handoff.name);
+		if (!is || handoff.name.empty())
+		{
+			throw std::invalid_argument( "Invalid handoff: " + aString);
+		}
+		return handoff;
+	}
+	/**
+	 *
+	 */
+	std::string Shard::GhostUpdate::asString() const
+	{
+		std::ostringstream os;
+		os << shard;
+		for (const Ghost& ghost : ghosts)
+		{
+			// The name is last because it may contain spaces
+			os << "\n" << ghost.position.x << " " << ghost.position.y << " " << ghost.size.x << " " << ghost.size.y << " "
+			        << ghost.frontX << " " << ghost.frontY << " " << ghost.name;
+		}
+		return os.str();
+	}
+	/**
+	 *
+	 */
+	/* static */Shard::GhostUpdate Shard::GhostUpdate::fromString( const std::string& aString)
+	{
+		GhostUpdate ghostUpdate;
+		std::istringstream is( aString);
+		std::string line;
+		std::getline( is, line);
+		std::istringstream shardStream( line);
+		if (!(shardStream >> ghostUpdate.shard))
+		{
+			throw std::invalid_argument( "Invalid ghost update: " + aString);
+		}
+		while (std::getline( is, line))
+		{
+			Ghost ghost;
+			std::istringstream ghostStream( line);
+			ghostStream >> ghost.position.x >> ghost.position.y >> ghost.size.x >> ghost.size.y >> ghost.frontX >> ghost.frontY;
+			ghostStream.get();
+			std::getline( ghostStream, ghost.name);
+			if (!ghostStream || ghost.name.empty())
+			{
+				throw std::invalid_argument( "Invalid ghost: " + line);
+			}
+			ghostUpdate.ghosts.push_back( ghost);
+		}
+		return ghostUpdate;
+	}
+	/**
+	 *
+	 */
+	/* static */void Shard::checkArguments()
+	{
+		unsigned int index = 0;
+		unsigned int count = 1;
+		unsigned short basePort = 12345;
+		readArguments( index, count, basePort);
+	}
+	/**
+	 *
+	 */
+	/* static */Shard& Shard::getShard()
+	{
+		static Shard shard;
+		return shard;
+	}
+	/**
+	 *
+	 */
+	Shard::Shard() :
+								index( 0),
+								count( 1),
+								basePort( 12345),
+								worldLeft( 0),
+								worldWidth( 0),
+								running( false)
+	{
+		try
+		{
+			readArguments( index, count, basePort);
+		}
+		catch (std::exception&)
+		{
+			// Reported at startup by checkArguments
+			index = 0;
+			count = 1;
+			basePort = 12345;
+		}
+	}
+	/**
+	 *
+	 */
+	/* static */void Shard::readArguments(	unsigned int& anIndex,
+											unsigned int& aCount,
+											unsigned short& aBasePort)
+	{
+		if (Application::MainApplication::isArgGiven( "-shard"))
+		{
+			const std::string& shard = Application::MainApplication::getArg( "-shard").value;
+			std::size_t separator = shard.find( '/');
+			if (separator == std::string::npos)
+			{
+				throw std::invalid_argument( "Invalid -shard, expected index/count: " + shard);
+			}
+			unsigned int index = static_cast< unsigned int >( std::stoul( shard.substr( 0, separator)));
+			unsigned int count = static_cast< unsigned int >( std::stoul( shard.substr( separator + 1)));
+			if (count == 0 || index >= count)
+			{
+				throw std::invalid_argument( "Invalid -shard, the index must be less than the count: " + shard);
+			}
+			anIndex = index;
+			aCount = count;
+		}
+		if (Application::MainApplication::isArgGiven( "-shard_port"))
+		{
+			aBasePort = static_cast< unsigned short >( std::stoul( Application::MainApplication::getArg( "-shard_port").value));
+		}
+	}
+	/**
+	 *
+	 */
+	Shard::~Shard()
+	{
+		stop();
+	}
+	/**
+	 *
+	 */
+	unsigned short Shard::getPort( unsigned int anIndex) const
+	{
+		return static_cast< unsigned short >( basePort + anIndex);
+	}
+	/**
+	 *
+	 */
+	wxRect Shard::getRegion() const
+	{
+		std::unique_lock< std::mutex > lock( shardMutex);
+		if (worldWidth == 0)
+		{
+			return wxRect();
+		}
+		int left = worldLeft + static_cast< int >( static_cast< long >( worldWidth) * index / count);
+		int right = worldLeft + static_cast< int >( static_cast< long >( worldWidth) * (index + 1) / count);
+		// The strips are unbounded in the vertical direction
+		return wxRect( left, -std::numeric_limits< int >::max() / 2, right - left, std::numeric_limits< int >::max());
+	}
+	/**
+	 *
+	 */
+	unsigned int Shard::getShardOf( const wxPoint& aPoint) const
+	{
+		std::unique_lock< std::mutex > lock( shardMutex);
+		if (worldWidth == 0 || aPoint.x < worldLeft)
+		{
+			return 0;
+		}
+		long strip = (static_cast< long >( aPoint.x) - worldLeft) * count / worldWidth;
+		return static_cast< unsigned int >( std::min( strip, static_cast< long >( count) - 1));
+	}
+	/**
+	 *
+	 */
+	void Shard::start()
+	{
+		if (!isSharded() || running)
+		{
+			return;
+		}
+
+		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
+		RobotPtr localRobot = robotWorld.getLocalRobot();
+
+		{
+			// The empty world of the application is 500 wide
+			WorldSnapshotPtr world = robotWorld.getSnapshot();
+			int left = 0;
+			int right = 500; // @suppress("Avoid magic numbers")
+			if (!world->walls->empty())
+			{
+				left = std::numeric_limits< int >::max();
+				right = std::numeric_limits< int >::min();
+				for (const WallPtr& wall : *world->walls)
+				{
+					left = std::min( { left, wall->getPoint1().x, wall->getPoint2().x});
+					right = std::max( { right, wall->getPoint1().x, wall->getPoint2().x});
+				}
+			}
+			std::unique_lock< std::mutex > lock( shardMutex);
+			worldLeft = left;
+			worldWidth = std::max( right - left, 1);
+
+			clients.clear();
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				clients.push_back( std::make_unique< Messaging::Client >( "localhost", getPort( i), localRobot));
+			}
+		}
+		partition();
+
+		localRobot->startCommunicating();
+
+		running = true;
+		std::thread newHandoffThread( [this]
+		{
+			try
+			{
+				while (running)
+				{
+					handOffRobots();
+					mirrorRobots();
+					std::this_thread::sleep_for( std::chrono::milliseconds( 100)); // @suppress("Avoid magic numbers")
+				}
+			}
+			catch (std::exception& e)
+			{
+				Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": ") + e.what());
+			}
+			catch (...)
+			{
+				Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": unknown exception"));
+			}
+		});
+		handoffThread.swap( newHandoffThread);
+
+		TRACE_DEVELOP( "Shard " + std::to_string( index) + "/" + std::to_string( count) + " owns x " + std::to_string( getRegion().GetLeft()) + " to " + std::to_string( getRegion().GetRight()) + " on port " + std::to_string( getPort( index)));
+	}
+	/**
+	 *
+	 */
+	void Shard::stop()
+	{
+		running = false;
+		if (handoffThread.joinable() && handoffThread.get_id() != std::this_thread::get_id())
+		{
+			handoffThread.join();
+		}
+	}
+	/**
+	 *
+	 */
+	void Shard::handleHandoffRequest( Messaging::Message& aMessage)
+	{
+		Handoff handoff = Handoff::fromString( aMessage.getBody());
+
+		{
+			// A ghost that is handed off becomes a normal robot
+			std::unique_lock< std::mutex > lock( shardMutex);
+			ghosts.erase( handoff.name);
+		}
+
+		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
+		RobotPtr robot = robotWorld.getRobot( handoff.name);
+		if (robot)
+		{
+			// A retried handoff or a ghost
+			robot->setPosition( handoff.position, true);
+		} else
+		{
+			robot = robotWorld.newRobot( handoff.name, handoff.position, true);
+		}
+		if (handoff.acting && !robot->isActing())
+		{
+			robot->startActing();
+		}
+		TRACE_DEVELOP( "Robot " + handoff.name + " was handed off to shard " + std::to_string( index));
+
+		aMessage.setMessageType( Messaging::HandoffResponse);
+		aMessage.setBody( handoff.name);
+	}
+	/**
+	 *
+	 */
+	void Shard::handleHandoffResponse( const Messaging::Message& aMessage)
+	{
+		{
+			std::unique_lock< std::mutex > lock( shardMutex);
+			if (pendingHandoffs.erase( aMessage.getBody()) == 0)
+			{
+				return;
+			}
+		}
+		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
+		RobotPtr robot = robotWorld.getRobot( aMessage.getBody());
+		if (robot && robot != robotWorld.getLocalRobot())
+		{
+			robotWorld.deleteRobot( robot);
+		}
+	}
+	/**
+	 *
+	 */
+	void Shard::handleGhostRequest( Messaging::Message& aMessage)
+	{
+		GhostUpdate ghostUpdate = GhostUpdate::fromString( aMessage.getBody());
+
+		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
+		std::set< std::string > names;
+		for (const Ghost& ghost : ghostUpdate.ghosts)
+		{
+			names.insert( ghost.name);
+
+			RobotPtr robot = robotWorld.getRobot( ghost.name);
+			if (robot && !isGhost( ghost.name))
+			{
+				// Owned by this shard, or handed off by this shard and not confirmed yet
+				continue;
+			}
+			if (!robot)
+			{
+				robot = robotWorld.newRobot( ghost.name, ghost.position, true);
+				std::unique_lock< std::mutex > lock( shardMutex);
+				ghosts[ghost.name] = ghostUpdate.shard;
+			}
+			robot->setSize( ghost.size, false);
+			robot->setPosition( ghost.position, false);
+			robot->setFront( BoundedVector( ghost.frontX, ghost.frontY), true);
+		}
+
+		// The robots that moved away from the border or were handed off to another shard
+		std::vector< std::string > staleGhosts;
+		{
+			std::unique_lock< std::mutex > lock( shardMutex);
+			for (auto ghost = ghosts.begin(); ghost != ghosts.end();)
+			{
+				if (ghost->second == ghostUpdate.shard && names.find( ghost->first) == names.end())
+				{
+					staleGhosts.push_back( ghost->first);
+					ghost = ghosts.erase( ghost);
+				} else
+				{
+					++ghost;
+				}
+			}
+		}
+		for (const std::string& name : staleGhosts)
+		{
+			RobotPtr robot = robotWorld.getRobot( name);
+			if (robot)
+			{
+				robotWorld.deleteRobot( robot);
+			}
+		}
+
+		aMessage.setMessageType( Messaging::GhostResponse);
+		aMessage.setBody( std::to_string( ghostUpdate.ghosts.size()));
+	}
+	/**
+	 *
+	 */
+	bool Shard::isGhost( const std::string& aName) const
+	{
+		std::unique_lock< std::mutex > lock( shardMutex);
+		return ghosts.find( aName) != ghosts.end();
+	}
+	/**
+	 *
+	 */
+	void Shard::partition()
+	{
+		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
+		RobotPtr localRobot = robotWorld.getLocalRobot();
+
+		std::vector< Base::ObjectId > keepObjects{ localRobot->getObjectId()};
+		WorldSnapshotPtr world = robotWorld.getSnapshot();
+		std::size_t numberOfRobots = 0;
+		for (const RobotPtr& robot : *world->robots)
+		{
+			if (getShardOf( robot->getPosition()) == index)
+			{
+				keepObjects.push_back( robot->getObjectId());
+				++numberOfRobots;
+			}
+		}
+		for (const WayPointPtr& wayPoint : *world->wayPoints)
+		{
+			keepObjects.push_back( wayPoint->getObjectId());
+		}
+		for (const GoalPtr& goal : *world->goals)
+		{
+			keepObjects.push_back( goal->getObjectId());
+		}
+		for (const WallPtr& wall : *world->walls)
+		{
+			keepObjects.push_back( wall->getObjectId());
+		}
+
+		robotWorld.unpopulate( keepObjects, true);
+		TRACE_DEVELOP( "Shard " + std::to_string( index) + " keeps " + std::to_string( numberOfRobots) + " of " + std::to_string( world->robots->size()) + " robots");
+	}
+	/**
+	 *
+	 */
+	void Shard::handOffRobots()
+	{
+		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
+		RobotPtr localRobot = robotWorld.getLocalRobot();
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+		WorldSnapshotPtr world = robotWorld.getSnapshot();
+		for (const RobotPtr& robot : *world->robots)
+		{
+			if (robot == localRobot || isGhost( robot->getName()))
+			{
+				continue;
+			}
+			unsigned int owner = getShardOf( robot->getPosition());
+			if (owner == index)
+			{
+				continue;
+			}
+
+			Handoff handoff{ robot->getName(), robot->getPosition(), robot->isActing()};
+			{
+				std::unique_lock< std::mutex > lock( shardMutex);
+				auto pending = pendingHandoffs.find( handoff.name);
+				if (pending != pendingHandoffs.end())
+				{
+					if (now - pending->second.sent < handoffTimeout)
+					{
+						continue;
+					}
+					// The robot was stopped by the first attempt
+					handoff.acting = pending->second.acting;
+				}
+				pendingHandoffs[handoff.name] = PendingHandoff{ now, handoff.acting};
+			}
+			// The robot is started again by the shard that receives it
+			robot->stopActing();
+			TRACE_DEVELOP( "Handing off robot " + handoff.name + " to shard " + std::to_string( owner));
+			clients[owner]->dispatchMessage( Messaging::Message( Messaging::HandoffRequest, handoff.asString()));
+		}
+	}
+	/**
+	 *
+	 */
+	void Shard::mirrorRobots()
+	{
+		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
+		RobotPtr localRobot = robotWorld.getLocalRobot();
+		wxRect region = getRegion();
+
+		GhostUpdate leftGhosts{ index, {}};
+		GhostUpdate rightGhosts{ index, {}};
+		WorldSnapshotPtr world = robotWorld.getSnapshot();
+		for (const RobotPtr& robot : *world->robots)
+		{
+			if (robot == localRobot || isGhost( robot->getName()))
+			{
+				continue;
+			}
+			// The robots outside the strip are being handed off, the new owner mirrors them
+			RobotState robotState = robot->getState();
+			if (getShardOf( robotState.position) != index)
+			{
+				continue;
+			}
+
+			Ghost ghost{ robot->getName(), robotState.position, robotState.size, robotState.frontX, robotState.frontY};
+			if (index > 0 && robotState.position.x < region.GetLeft() + haloWidth)
+			{
+				leftGhosts.ghosts.push_back( ghost);
+			}
+			if (index + 1 < count && robotState.position.x > region.GetRight() - haloWidth)
+			{
+				rightGhosts.ghosts.push_back( ghost);
+			}
+		}
+
+		// Also when there are no ghosts, so the neighbour removes the ones it has
+		if (index > 0)
+		{
+			clients[index - 1]->dispatchMessage( Messaging::Message( Messaging::GhostRequest, leftGhosts.asString()));
+		}
+		if (index + 1 < count)
+		{
+			clients[index + 1]->dispatchMessage( Messaging::Message( Messaging::GhostRequest, rightGhosts.asString()));
+		}
+	}
+} // namespace Model
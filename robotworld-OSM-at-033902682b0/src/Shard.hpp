@@ -0,0 +1,239 @@
+#ifndef SHARD_HPP_
+#define SHARD_HPP_
+
+#include "Config.hpp"
+
+#include "Widgets.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Messaging
+{
+	class Client;
+	class Message;
+}
+
+namespace Model
+{
+	/**
+	 * Splits the world over N processes on localhost, enabled with the command line argument -shard=index/N.
+	 *
+	 * The bounding box of the walls is divided in N vertical strips, shard i owns strip i. At start the process
+	 * removes the robots outside its strip. The walls, goals and waypoints are kept everywhere: a robot plans its
+	 * route through the whole world, not just through its strip. Shard i listens on port -shard_port + i
+	 * (default 12345 + i).
+	 *
+	 * A robot that leaves the strip is stopped and handed off to the shard that owns its position with a
+	 * HandoffRequest. The receiving shard adds the robot and starts it again if it was acting. The robot is only
+	 * removed when the HandoffResponse arrives, a handoff without response is retried. The local robot is the
+	 * endpoint of the messaging and is never handed off.
+	 *
+	 * The robots within collision range of a border are mirrored to the neighbour on the other side as ghosts.
+	 * Along with the handoffs each shard sends a GhostRequest with the poses of those robots to both neighbours.
+	 * The neighbour adds a ghost for every robot in it, moves the ghosts it already has and removes the ghosts of
+	 * that shard that are no longer in it. A ghost is read-only: it is never started, stepped or handed off, it only
+	 * lets the robots of the neighbour collide with the robots across the border. A robot that is handed off to
+	 * the shard that has its ghost becomes a normal robot there.
+	 *
+	 * All shards should load the same world with -world=file.
+	 */
+	class Shard
+	{
+		public:
+			/**
+			 * The robot that moves from one shard to another
+			 */
+			struct Handoff
+			{
+					/**
+					 *
+					 */
+					std::string asString() const;
+					/**
+					 *
+					 * @throw std::invalid_argument if aString is not a handoff
+					 */
+					static Handoff fromString( const std::string& aString);
+
+					std::string name;
+					wxPoint position;
+					bool acting;
+			};
+			/**
+			 * The pose of a robot near the border that is mirrored to the neighbour
+			 */
+			struct Ghost
+			{
+					std::string name;
+					wxPoint position;
+					wxSize size;
+					double frontX;
+					double frontY;
+			};
+			/**
+			 * All ghosts one shard mirrors to a neighbour
+			 */
+			struct GhostUpdate
+			{
+					/**
+					 * The ASCII representation is suitable for parsing by GhostUpdate::fromString and is used as the
+					 * body of a GhostRequest, one line per ghost.
+					 */
+					std::string asString() const;
+					/**
+					 *
+					 * @throw std::invalid_argument if aString is not a ghost update
+					 */
+					static GhostUpdate fromString( const std::string& aString);
+
+					unsigned int shard;
+					std::vector< Ghost > ghosts;
+			};
+			/**
+			 * Checks -shard and -shard_port. Must be called at startup, before the first getShard, so an invalid
+			 * argument is reported there. The Shard of an invalid argument is not sharded.
+			 *
+			 * @throw std::invalid_argument or std::out_of_range if -shard or -shard_port is invalid
+			 */
+			static void checkArguments();
+			/**
+			 *
+			 */
+			static Shard& getShard();
+			/**
+			 *
+			 * @return true if -shard was given
+			 */
+			bool isSharded() const
+			{
+				return count > 1;
+			}
+			/**
+			 *
+			 */
+			unsigned int getIndex() const
+			{
+				return index;
+			}
+			/**
+			 *
+			 */
+			unsigned int getCount() const
+			{
+				return count;
+			}
+			/**
+			 *
+			 * @return the port shard anIndex listens on
+			 */
+			unsigned short getPort( unsigned int anIndex) const;
+			/**
+			 *
+			 * @return the strip of this shard, empty before start
+			 */
+			wxRect getRegion() const;
+			/**
+			 *
+			 * @return the index of the shard whose strip contains aPoint. Points left or right of the world
+			 * 		   belong to the first or the last shard.
+			 */
+			unsigned int getShardOf( const wxPoint& aPoint) const;
+			/**
+			 * Divides the current world, removes the objects this shard does not own, starts listening and starts
+			 * the thread that hands off the robots that leave the strip
+			 */
+			void start();
+			/**
+			 *
+			 */
+			void stop();
+			/**
+			 * Adds the robot of the handoff to the world
+			 */
+			void handleHandoffRequest( Messaging::Message& aMessage);
+			/**
+			 * Removes the robot that was handed off
+			 */
+			void handleHandoffResponse( const Messaging::Message& aMessage);
+			/**
+			 * Adds, moves and removes the ghosts of the sending shard
+			 */
+			void handleGhostRequest( Messaging::Message& aMessage);
+			/**
+			 *
+			 * @return true if the robot named aName is the ghost of a robot of another shard
+			 */
+			bool isGhost( const std::string& aName) const;
+
+		protected:
+			/**
+			 * Reads -shard and -shard_port, see checkArguments
+			 */
+			Shard();
+			/**
+			 *
+			 */
+			virtual ~Shard();
+			/**
+			 * Removes the robots that are not owned by this shard
+			 */
+			void partition();
+			/**
+			 * Hands off the robots outside the strip
+			 */
+			void handOffRobots();
+			/**
+			 * Sends the robots near the borders of the strip to the neighbours as ghosts
+			 */
+			void mirrorRobots();
+
+		private:
+			/**
+			 * @throw std::invalid_argument or std::out_of_range if -shard or -shard_port is invalid
+			 */
+			static void readArguments(	unsigned int& anIndex,
+										unsigned int& aCount,
+										unsigned short& aBasePort);
+
+			unsigned int index;
+			unsigned int count;
+			unsigned short basePort;
+
+			mutable std::mutex shardMutex;
+			int worldLeft;
+			int worldWidth;
+			/**
+			 * One client per shard, the responses arrive asynchronously
+			 */
+			std::vector< std::unique_ptr< Messaging::Client > > clients;
+			/**
+			 *
+			 */
+			struct PendingHandoff
+			{
+					std::chrono::steady_clock::time_point sent;
+					bool acting;
+			};
+			/**
+			 * The robots that were handed off but not confirmed yet, by name
+			 */
+			std::map< std::string, PendingHandoff > pendingHandoffs;
+			/**
+			 * The ghosts in the world, by name, with the shard that owns the robot
+			 */
+			std::map< std::string, unsigned int > ghosts;
+
+			std::atomic< bool > running;
+			std::thread handoffThread;
+	};
+	//	class Shard
+} // namespace Model
+
+#endif // SHARD_HPP_
@@ -0,0 +1,397 @@
+#include "Simulation.hpp"
+
+#include "Logger.hpp"
+#include "MainApplication.hpp"
+#include "Message.hpp"
+#include "MessageTypes.hpp"
+#include "Recorder.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Trace.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace Model
+{
+	namespace
+	{
+		const std::uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+		const std::uint64_t fnvPrime = 1099511628211ULL;
+
+		/**
+		 * FNV-1a over the bytes of aValue
+		 */
+		template< typename T >
+		std::uint64_t hashValue(	std::uint64_t aHash,
+									const T& aValue)
+		{
+			unsigned char bytes[sizeof(T)];
+			std::memcpy( bytes, &aValue, sizeof(T));
+			for (unsigned char byte : bytes)
+			{
+				aHash = (aHash ^ byte) * fnvPrime;
+			}
+			return aHash;
+		}
+	} // namespace
+
+	/**
+	 *
+	 */
+	std::string Simulation::TickInput::asString() const
+	{
+		std::ostringstream os;
+		// The speed must survive the round trip bit for bit
+		os << tick << " " << std::setprecision( std::numeric_limits< float >::max_digits10) << speed << " " << stopRequested << " " << checksum;
+		return os.str();
+	}
+	/**
+	 *
+	 */
+	/* static */Simulation::TickInput Simulation::TickInput::fromString( const std::string& aString)
+	{
+		TickInput tickInput;
+		std::istringstream is( aString);
+		is >> tickInput.tick >> tickInput.speed >> tickInput.stopRequested >> tickInput.checksum;
+		if (!is)
+		{
+			throw std::invalid_argument( "Invalid tick input: " + aString);
+		}
+		return tickInput;
+	}
+	/**
+	 *
+	 */
+	/* static */Simulation& Simulation::getSimulation()
+	{
+		static Simulation simulation;
+		return simulation;
+	}
+	/**
+	 *
+	 */
+	Simulation::Simulation() :
+								running( false),
+								stopRequested( false),
+								tick( 0),
+								seed( 0),
+								checksum( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	Simulation::~Simulation()
+	{
+		stop();
+	}
+	/**
+	 *
+	 */
+	bool Simulation::isLockstep() const
+	{
+		return Application::MainApplication::isArgGiven( "-lockstep") || Application::MainApplication::isArgGiven( "-benchmark") || Application::MainApplication::isArgGiven( "-capture");
+	}
+	/**
+	 *
+	 */
+	void Simulation::start( std::uint64_t aSeed)
+	{
+		if (running)
+		{
+			return;
+		}
+		if (simulationThread.joinable())
+		{
+			simulationThread.join();
+		}
+
+		if (!scheduler)
+		{
+			scheduler = std::make_unique< Base::TaskScheduler >( getThreadsArgument());
+		}
+
+		tick = 0;
+		seed = aSeed;
+		checksum = calculateChecksum( hashValue( fnvOffsetBasis, seed));
+		stopRequested = false;
+		running = true;
+
+		TRACE_DEVELOP( "Lockstep simulation started with seed " + std::to_string( seed));
+
+		std::thread newSimulationThread( [this]
+		{
+			run();
+		});
+		simulationThread.swap( newSimulationThread);
+	}
+	/**
+	 *
+	 */
+	void Simulation::stop()
+	{
+		running = false;
+		peerInputArrived.notify_all();
+		if (simulationThread.joinable() && simulationThread.get_id() != std::this_thread::get_id())
+		{
+			simulationThread.join();
+		}
+
+		std::unique_lock< std::mutex > lock( peerInputMutex);
+		peerInputs.clear();
+	}
+	/**
+	 *
+	 */
+	void Simulation::requestStop()
+	{
+		stopRequested = true;
+	}
+	/**
+	 *
+	 */
+	void Simulation::handleTickRequest( Messaging::Message& aMessage)
+	{
+		TickInput peerInput = TickInput::fromString( aMessage.getBody());
+		{
+			std::unique_lock< std::mutex > lock( peerInputMutex);
+			peerInputs[peerInput.tick] = peerInput;
+		}
+		peerInputArrived.notify_all();
+
+		aMessage.setMessageType( Messaging::TickResponse);
+		aMessage.setBody( std::to_string( peerInput.tick));
+	}
+	/**
+	 *
+	 */
+	/* static */std::uint64_t Simulation::getSeedArgument()
+	{
+		if (Application::MainApplication::isArgGiven( "-seed"))
+		{
+			return std::stoull( Application::MainApplication::getArg( "-seed").value);
+		}
+		return 0;
+	}
+	/**
+	 *
+	 */
+	/* static */unsigned int Simulation::getThreadsArgument()
+	{
+		if (Application::MainApplication::isArgGiven( "-threads"))
+		{
+			return static_cast< unsigned int >( std::stoul( Application::MainApplication::getArg( "-threads").value));
+		}
+		return std::thread::hardware_concurrency();
+	}
+	/**
+	 *
+	 */
+	/* static */void Simulation::startRobots( Base::TaskScheduler& aScheduler)
+	{
+		WorldSnapshotPtr world = RobotWorld::getRobotWorld().getSnapshot();
+
+		std::vector< Robot* > startingRobots;
+		for (const RobotPtr& robot : *world->robots)
+		{
+			if (robot->isActing() && !robot->isDriving())
+			{
+				robot->beginDriving();
+				startingRobots.push_back( robot.get());
+			}
+		}
+
+		// A search per task, planning a route is by far the most expensive part of a tick
+		std::vector< PathAlgorithm::Path > routes( startingRobots.size());
+		aScheduler.parallelFor( 0, startingRobots.size(), 1, [&startingRobots, &routes](	std::size_t aFirst,
+																						std::size_t aLast)
+		{
+			for (std::size_t i = aFirst; i < aLast; ++i)
+			{
+				routes[i] = startingRobots[i]->planRoute( true);
+			}
+		});
+
+		for (std::size_t i = 0; i < startingRobots.size(); ++i)
+		{
+			startingRobots[i]->applyRoute( routes[i], true);
+			startingRobots[i]->prepareDriving();
+		}
+	}
+	/**
+	 *
+	 */
+	/* static */void Simulation::stepRobots( Base::TaskScheduler& aScheduler)
+	{
+		WorldSnapshotPtr world = RobotWorld::getRobotWorld().getSnapshot();
+
+		std::vector< Robot* > drivingRobots;
+		for (const RobotPtr& robot : *world->robots)
+		{
+			if (robot->isDriving())
+			{
+				drivingRobots.push_back( robot.get());
+			}
+		}
+
+		// Moving and checking a robot is cheap, a replan is expensive and is spawned so it can be stolen
+		Base::TaskScheduler::TaskGroup replans;
+		aScheduler.parallelFor( 0, drivingRobots.size(), 4, [&aScheduler, &drivingRobots, &replans](	std::size_t aFirst,
+																										std::size_t aLast)
+		{
+			for (std::size_t i = aFirst; i < aLast; ++i)
+			{
+				Robot* robot = drivingRobots[i];
+				if (robot->readStep())
+				{
+					aScheduler.spawn( replans, [robot]
+					{
+						robot->replanStep();
+					});
+				}
+			}
+		});
+		aScheduler.wait( replans);
+
+		for (Robot* robot : drivingRobots)
+		{
+			robot->commitStep();
+		}
+	}
+	/**
+	 *
+	 */
+	void Simulation::run()
+	{
+		try
+		{
+			while (running)
+			{
+				TickInput localInput;
+				localInput.tick = tick;
+				localInput.speed = Robot::toRobotSpeed( Application::MainApplication::getSettings().getSpeed());
+				localInput.stopRequested = stopRequested.exchange( false);
+				localInput.checksum = checksum;
+				RobotWorld::getRobotWorld().getLocalRobot()->sendMessage( Messaging::Message( Messaging::TickRequest, localInput.asString()));
+
+				TickInput peerInput;
+				if (!waitForPeerInput( tick, peerInput))
+				{
+					break;
+				}
+				if (peerInput.checksum != checksum)
+				{
+					Application::Logger::log( "Lockstep divergence at tick " + std::to_string( tick) + ": local checksum " + std::to_string( checksum) + ", peer checksum " + std::to_string( peerInput.checksum));
+				}
+
+				executeTick( localInput, peerInput);
+				Recorder::getRecorder().recordTick();
+
+				checksum = calculateChecksum( checksum);
+				++tick;
+
+				// The wall clock only paces the ticks, it has no influence on the state
+				std::this_thread::sleep_for( std::chrono::milliseconds( 100)); // @suppress("Avoid magic numbers")
+			}
+		}
+		catch (std::exception& e)
+		{
+			Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": ") + e.what());
+		}
+		catch (...)
+		{
+			Application::Logger::log( __PRETTY_FUNCTION__ + std::string( ": unknown exception"));
+		}
+		running = false;
+		TRACE_DEVELOP( "Lockstep simulation stopped at tick " + std::to_string( tick));
+	}
+	/**
+	 *
+	 */
+	void Simulation::executeTick(	const TickInput& aLocalInput,
+									const TickInput& aPeerInput)
+	{
+		RobotWorld& robotWorld = RobotWorld::getRobotWorld();
+		RobotPtr localRobot = robotWorld.getLocalRobot();
+		RobotPtr peerRobot = robotWorld.getRobot( "Peer");
+
+		// Robots that were started since the previous tick plan their route first
+		startRobots( *scheduler);
+
+		// Each node owns the speed and the stop requests of its local robot
+		localRobot->setSpeed( aLocalInput.speed, false);
+		if (aLocalInput.stopRequested && localRobot->isActing())
+		{
+			localRobot->stopActing();
+		}
+		if (peerRobot)
+		{
+			peerRobot->setSpeed( aPeerInput.speed, false);
+			if (aPeerInput.stopRequested && peerRobot->isActing())
+			{
+				peerRobot->stopActing();
+			}
+		}
+
+		// The order of the robots is the same on both nodes, see handleStartRequest
+		stepRobots( *scheduler);
+
+		bool acting = false;
+		WorldSnapshotPtr world = robotWorld.getSnapshot();
+		for (const RobotPtr& robot : *world->robots)
+		{
+			acting = acting || robot->isActing();
+		}
+
+		// Both nodes have the same state so both stop at the same tick
+		if (!acting)
+		{
+			running = false;
+		}
+	}
+	/**
+	 *
+	 */
+	bool Simulation::waitForPeerInput(	unsigned long aTick,
+										TickInput& aPeerInput)
+	{
+		std::unique_lock< std::mutex > lock( peerInputMutex);
+		while (running)
+		{
+			auto i = peerInputs.find( aTick);
+			if (i != peerInputs.end())
+			{
+				aPeerInput = i->second;
+				peerInputs.erase( i);
+				return true;
+			}
+			if (peerInputArrived.wait_for( lock, std::chrono::seconds( 1)) == std::cv_status::timeout)
+			{
+				TRACE_DEVELOP( "Waiting for the input of the peer for tick " + std::to_string( aTick));
+			}
+		}
+		return false;
+	}
+	/**
+	 *
+	 */
+	/* static */std::uint64_t Simulation::calculateChecksum( std::uint64_t aPreviousChecksum)
+	{
+		std::uint64_t hash = aPreviousChecksum;
+		WorldSnapshotPtr world = RobotWorld::getRobotWorld().getSnapshot();
+		for (const RobotPtr& robot : *world->robots)
+		{
+			hash = hashValue( hash, robot->getPosition().x);
+			hash = hashValue( hash, robot->getPosition().y);
+			hash = hashValue( hash, robot->getFront().x);
+			hash = hashValue( hash, robot->getFront().y);
+			hash = hashValue( hash, robot->getSpeed());
+			hash = hashValue( hash, robot->isDriving());
+		}
+		return hash;
+	}
+} // namespace Model
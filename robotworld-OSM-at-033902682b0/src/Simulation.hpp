@@ -0,0 +1,205 @@
+#ifndef SIMULATION_HPP_
+#define SIMULATION_HPP_
+
+#include "Config.hpp"
+
+#include "TaskScheduler.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Messaging
+{
+	class Message;
+}
+
+namespace Model
+{
+	/**
+	 * The lockstep simulation, enabled with the command line argument -lockstep.
+	 *
+	 * In lockstep mode the robots are not driven by their own threads but stepped by a single tick loop.
+	 * Before each tick both nodes exchange their inputs for that tick (a TickRequest with the speed of
+	 * their local robot and whether it should stop) and a tick is only executed when the input of the
+	 * peer has arrived. All state changes happen inside a tick in a fixed order and no state depends on
+	 * the wall clock, which is only used to pace the ticks. Given the same world, seed and inputs both
+	 * nodes therefore compute exactly the same states.
+	 *
+	 * Each input also contains the checksum of the state of the sender at the start of the tick, any
+	 * divergence between the nodes is logged with the tick at which it occurred.
+	 */
+	class Simulation
+	{
+		public:
+			/**
+			 * The input of a node for a single tick
+			 */
+			struct TickInput
+			{
+					/**
+					 *
+					 */
+					TickInput() :
+									tick( 0),
+									speed( 0.0),
+									stopRequested( false),
+									checksum( 0)
+					{
+					}
+					/**
+					 * The ASCII representation is suitable for parsing by TickInput::fromString and is used as the body
+					 * of a TickRequest.
+					 */
+					std::string asString() const;
+					/**
+					 *
+					 * @param aString in the same format as TickInput::asString
+					 */
+					static TickInput fromString( const std::string& aString);
+
+					unsigned long tick;
+					float speed;
+					bool stopRequested;
+					std::uint64_t checksum;
+			};
+			/**
+			 *
+			 */
+			static Simulation& getSimulation();
+			/**
+			 *
+			 * @return true if the command line argument -lockstep is given. The benchmarks and the frame capture step
+			 * the robots themselves as well.
+			 */
+			bool isLockstep() const;
+			/**
+			 * Starts the tick loop at tick 0
+			 *
+			 * @param aSeed The seed both nodes agreed upon in the StartRequest
+			 */
+			void start( std::uint64_t aSeed);
+			/**
+			 * Stops the tick loop and forgets any inputs of the peer
+			 */
+			void stop();
+			/**
+			 *
+			 */
+			bool isRunning() const
+			{
+				return running;
+			}
+			/**
+			 *
+			 * @return the number of the tick that is executed next
+			 */
+			unsigned long getTick() const
+			{
+				return tick;
+			}
+			/**
+			 *
+			 */
+			std::uint64_t getSeed() const
+			{
+				return seed;
+			}
+			/**
+			 *
+			 * @return the checksum of the state at the start of the current tick
+			 */
+			std::uint64_t getChecksum() const
+			{
+				return checksum;
+			}
+			/**
+			 * Requests the local robot to stop. The request is sent to the peer as part of the input of the next tick
+			 * so the robot stops at the same tick on both nodes.
+			 */
+			void requestStop();
+			/**
+			 * Stores the input of the peer that is contained in aMessage and sets the TickResponse
+			 */
+			void handleTickRequest( Messaging::Message& aMessage);
+			/**
+			 *
+			 * @return the seed given with -seed=number, 0 otherwise
+			 */
+			static std::uint64_t getSeedArgument();
+			/**
+			 *
+			 * @return the number of threads given with -threads=number, the number of cores otherwise
+			 */
+			static unsigned int getThreadsArgument();
+			/**
+			 * Lets the robots that were started since the previous tick plan their route. The searches run in
+			 * parallel, the routes are applied afterwards in the order of the robots.
+			 *
+			 * @see Robot::planRoute
+			 */
+			static void startRobots( Base::TaskScheduler& aScheduler);
+			/**
+			 * Executes a single step for all robots that are driving. The robots move and check for contact in
+			 * parallel, against the other robots as they were at the start of the step, and every replan is a task of
+			 * its own that idle threads can steal. The results are then committed one robot at a time in the order of
+			 * the robots, so the state after the step does not depend on the number of threads.
+			 *
+			 * @see Robot::readStep
+			 */
+			static void stepRobots( Base::TaskScheduler& aScheduler);
+
+		protected:
+			/**
+			 *
+			 */
+			Simulation();
+			/**
+			 *
+			 */
+			virtual ~Simulation();
+			/**
+			 * The tick loop
+			 */
+			void run();
+			/**
+			 * Executes a single tick with the given inputs
+			 */
+			void executeTick(	const TickInput& aLocalInput,
+								const TickInput& aPeerInput);
+			/**
+			 * Waits for the input of the peer for aTick
+			 *
+			 * @return false if the simulation was stopped while waiting
+			 */
+			bool waitForPeerInput(	unsigned long aTick,
+									TickInput& aPeerInput);
+			/**
+			 *
+			 * @return the checksum of the state of the robots, chained with aPreviousChecksum
+			 */
+			static std::uint64_t calculateChecksum( std::uint64_t aPreviousChecksum);
+
+		private:
+			std::unique_ptr< Base::TaskScheduler > scheduler;
+			std::thread simulationThread;
+			std::atomic< bool > running;
+			std::atomic< bool > stopRequested;
+
+			std::atomic< unsigned long > tick;
+			std::uint64_t seed;
+			std::atomic< std::uint64_t > checksum;
+
+			std::mutex peerInputMutex;
+			std::condition_variable peerInputArrived;
+			std::map< unsigned long, TickInput > peerInputs;
+	};
+	//	class Simulation
+} // namespace Model
+
+#endif // SIMULATION_HPP_
@@ -0,0 +1,504 @@
+#include "SoftwareRenderer.hpp"
+
+#include "MathUtils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace View
+{
+	namespace
+	{
+		/**
+		 * A character of the font, each column is a byte with the top row in the lowest bit
+		 */
+		struct Glyph
+		{
+				char character;
+				unsigned char columns[5];
+		};
+		//	struct Glyph
+
+		const int glyphWidth = 5;
+		const int glyphHeight = 7;
+		/**
+		 * The distance between two characters and between two lines
+		 */
+		const int cellWidth = glyphWidth + 1;
+		const int cellHeight = glyphHeight + 1;
+
+		const Glyph font[] = {	{ '0', { 0x3E, 0x51, 0x49, 0x45, 0x3E}},
+								{ '1', { 0x00, 0x42, 0x7F, 0x40, 0x00}},
+								{ '2', { 0x42, 0x61, 0x51, 0x49, 0x46}},
+								{ '3', { 0x21, 0x41, 0x45, 0x4B, 0x31}},
+								{ '4', { 0x18, 0x14, 0x12, 0x7F, 0x10}},
+								{ '5', { 0x27, 0x45, 0x45, 0x45, 0x39}},
+								{ '6', { 0x3C, 0x4A, 0x49, 0x49, 0x30}},
+								{ '7', { 0x01, 0x71, 0x09, 0x05, 0x03}},
+								{ '8', { 0x36, 0x49, 0x49, 0x49, 0x36}},
+								{ '9', { 0x06, 0x49, 0x49, 0x29, 0x1E}},
+								{ 'A', { 0x7E, 0x11, 0x11, 0x11, 0x7E}},
+								{ 'B', { 0x7F, 0x49, 0x49, 0x49, 0x36}},
+								{ 'C', { 0x3E, 0x41, 0x41, 0x41, 0x22}},
+								{ 'D', { 0x7F, 0x41, 0x41, 0x22, 0x1C}},
+								{ 'E', { 0x7F, 0x49, 0x49, 0x49, 0x41}},
+								{ 'F', { 0x7F, 0x09, 0x09, 0x09, 0x01}},
+								{ 'G', { 0x3E, 0x41, 0x49, 0x49, 0x7A}},
+								{ 'H', { 0x7F, 0x08, 0x08, 0x08, 0x7F}},
+								{ 'I', { 0x00, 0x41, 0x7F, 0x41, 0x00}},
+								{ 'J', { 0x20, 0x40, 0x41, 0x3F, 0x01}},
+								{ 'K', { 0x7F, 0x08, 0x14, 0x22, 0x41}},
+								{ 'L', { 0x7F, 0x40, 0x40, 0x40, 0x40}},
+								{ 'M', { 0x7F, 0x02, 0x0C, 0x02, 0x7F}},
+								{ 'N', { 0x7F, 0x04, 0x08, 0x10, 0x7F}},
+								{ 'O', { 0x3E, 0x41, 0x41, 0x41, 0x3E}},
+								{ 'P', { 0x7F, 0x09, 0x09, 0x09, 0x06}},
+								{ 'Q', { 0x3E, 0x41, 0x51, 0x21, 0x5E}},
+								{ 'R', { 0x7F, 0x09, 0x19, 0x29, 0x46}},
+								{ 'S', { 0x46, 0x49, 0x49, 0x49, 0x31}},
+								{ 'T', { 0x01, 0x01, 0x7F, 0x01, 0x01}},
+								{ 'U', { 0x3F, 0x40, 0x40, 0x40, 0x3F}},
+								{ 'V', { 0x1F, 0x20, 0x40, 0x20, 0x1F}},
+								{ 'W', { 0x3F, 0x40, 0x38, 0x40, 0x3F}},
+								{ 'X', { 0x63, 0x14, 0x08, 0x14, 0x63}},
+								{ 'Y', { 0x07, 0x08, 0x70, 0x08, 0x07}},
+								{ 'Z', { 0x61, 0x51, 0x49, 0x45, 0x43}},
+								{ '-', { 0x08, 0x08, 0x08, 0x08, 0x08}},
+								{ '_', { 0x40, 0x40, 0x40, 0x40, 0x40}},
+								{ '+', { 0x08, 0x08, 0x3E, 0x08, 0x08}},
+								{ '=', { 0x14, 0x14, 0x14, 0x14, 0x14}},
+								{ '.', { 0x00, 0x60, 0x60, 0x00, 0x00}},
+								{ ',', { 0x00, 0x50, 0x30, 0x00, 0x00}},
+								{ ':', { 0x00, 0x36, 0x36, 0x00, 0x00}},
+								{ '/', { 0x20, 0x10, 0x08, 0x04, 0x02}},
+								{ '(', { 0x00, 0x1C, 0x22, 0x41, 0x00}},
+								{ ')', { 0x00, 0x41, 0x22, 0x1C, 0x00}},
+								{ '#', { 0x14, 0x7F, 0x14, 0x7F, 0x14}}};
+		/**
+		 *
+		 * @return the glyph of aCharacter, nullptr for a space or a character that is not in the font
+		 */
+		const Glyph* findGlyph( char aCharacter)
+		{
+			char character = static_cast< char >( std::toupper( static_cast< unsigned char >( aCharacter)));
+			for (const Glyph& glyph : font)
+			{
+				if (glyph.character == character)
+				{
+					return &glyph;
+				}
+			}
+			return nullptr;
+		}
+		/**
+		 * Clips the segment from aBegin to anEnd to the rectangle from aLeft, aTop to aRight, aBottom inclusive
+		 * (Liang-Barsky). A segment that is completely inside is not changed.
+		 *
+		 * @return false if the segment misses the rectangle
+		 */
+		bool clipLine(	double aLeft,
+						double aTop,
+						double aRight,
+						double aBottom,
+						wxPoint& aBegin,
+						wxPoint& anEnd)
+		{
+			double x = aBegin.x;
+			double y = aBegin.y;
+			double dx = static_cast< double >( anEnd.x) - x;
+			double dy = static_cast< double >( anEnd.y) - y;
+			const double directions[] = { -dx, dx, -dy, dy};
+			const double distances[] = { x - aLeft, aRight - x, y - aTop, aBottom - y};
+
+			double first = 0.0;
+			double last = 1.0;
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				if (directions[i] == 0.0)
+				{
+					// Parallel to this edge, either completely outside or irrelevant
+					if (distances[i] < 0.0)
+					{
+						return false;
+					}
+					continue;
+				}
+				double t = distances[i] / directions[i];
+				if (directions[i] < 0.0)
+				{
+					first = std::max( first, t);
+				} else
+				{
+					last = std::min( last, t);
+				}
+				if (first > last)
+				{
+					return false;
+				}
+			}
+
+			if (last < 1.0)
+			{
+				anEnd = wxPoint( static_cast< int >( std::lround( x + last * dx)), static_cast< int >( std::lround( y + last * dy)));
+			}
+			if (first > 0.0)
+			{
+				aBegin = wxPoint( static_cast< int >( std::lround( x + first * dx)), static_cast< int >( std::lround( y + first * dy)));
+			}
+			return true;
+		}
+	} // namespace
+
+	/**
+	 *
+	 */
+	SoftwareRenderer::SoftwareRenderer(	int aWidth,
+										int aHeight) :
+								width( std::max( aWidth, 0)),
+								height( std::max( aHeight, 0)),
+								pixels( static_cast< std::size_t >( width) * static_cast< std::size_t >( height) * 3, 255),
+								penPixel{ { 0, 0, 0}},
+								penWidth( 1),
+								brushPixel{ { 255, 255, 255}}
+	{
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::clear( const Colour& aColour)
+	{
+		Pixel pixel = toPixel( aColour);
+		for (std::size_t i = 0; i < pixels.size(); i += 3)
+		{
+			std::copy( pixel.begin(), pixel.end(), pixels.begin() + static_cast< long >( i));
+		}
+	}
+	/**
+	 *
+	 */
+	std::string SoftwareRenderer::asPpm() const
+	{
+		std::ostringstream os;
+		os << "P6\n" << width << " " << height << "\n255\n";
+		os.write( reinterpret_cast< const char* >( pixels.data()), static_cast< std::streamsize >( pixels.size()));
+		return os.str();
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::setPen(	const Colour& aColour,
+									int aWidth)
+	{
+		penPixel = toPixel( aColour);
+		penWidth = std::max( aWidth, 1);
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::setBrush( const Colour& aColour)
+	{
+		brushPixel = toPixel( aColour);
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::drawPoint( const wxPoint& aPoint)
+	{
+		stampPen( aPoint.x, aPoint.y);
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::drawLine(	const wxPoint& aBegin,
+										const wxPoint& anEnd)
+	{
+		// Only the part that can touch the image is walked, which also keeps the error term of Bresenham small
+		wxPoint begin = aBegin;
+		wxPoint end = anEnd;
+		if (!clipLine( -penWidth, -penWidth, width - 1 + penWidth, height - 1 + penWidth, begin, end))
+		{
+			return;
+		}
+
+		// Bresenham
+		int x = begin.x;
+		int y = begin.y;
+		int dx = std::abs( end.x - begin.x);
+		int dy = -std::abs( end.y - begin.y);
+		int stepX = begin.x < end.x ? 1 : -1;
+		int stepY = begin.y < end.y ? 1 : -1;
+		int error = dx + dy;
+		while (true)
+		{
+			stampPen( x, y);
+			if (x == end.x && y == end.y)
+			{
+				break;
+			}
+			int doubleError = 2 * error;
+			if (doubleError >= dy)
+			{
+				error += dy;
+				x += stepX;
+			}
+			if (doubleError <= dx)
+			{
+				error += dx;
+				y += stepY;
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::drawLines(	std::size_t aNumberOfPoints,
+										const wxPoint aPoints[])
+	{
+		if (aNumberOfPoints == 1)
+		{
+			drawPoint( aPoints[0]);
+		}
+		for (std::size_t i = 1; i < aNumberOfPoints; ++i)
+		{
+			drawLine( aPoints[i - 1], aPoints[i]);
+		}
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::drawPolygon(	std::size_t aNumberOfPoints,
+										const wxPoint aPoints[])
+	{
+		if (aNumberOfPoints == 0)
+		{
+			return;
+		}
+
+		int top = aPoints[0].y;
+		int bottom = aPoints[0].y;
+		for (std::size_t i = 1; i < aNumberOfPoints; ++i)
+		{
+			top = std::min( top, aPoints[i].y);
+			bottom = std::max( bottom, aPoints[i].y);
+		}
+		top = std::max( top, 0);
+		bottom = std::min( bottom, height - 1);
+
+		// The inside is sampled in the middle of each row
+		std::vector< double > crossings;
+		for (int y = top; y <= bottom; ++y)
+		{
+			double sampleY = y + 0.5;
+			crossings.clear();
+			for (std::size_t i = 0; i < aNumberOfPoints; ++i)
+			{
+				const wxPoint& begin = aPoints[i];
+				const wxPoint& end = aPoints[(i + 1) % aNumberOfPoints];
+				if ((begin.y <= sampleY) != (end.y <= sampleY))
+				{
+					crossings.push_back( begin.x + (sampleY - begin.y) * (end.x - begin.x) / (end.y - begin.y));
+				}
+			}
+			std::sort( crossings.begin(), crossings.end());
+			for (std::size_t i = 0; i + 1 < crossings.size(); i += 2)
+			{
+				fillSpan( static_cast< int >( std::ceil( crossings[i] - 0.5)), static_cast< int >( std::floor( crossings[i + 1] - 0.5)), y, brushPixel);
+			}
+		}
+
+		drawLines( aNumberOfPoints, aPoints);
+		drawLine( aPoints[aNumberOfPoints - 1], aPoints[0]);
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::drawRectangle( const wxRect& aRectangle)
+	{
+		if (aRectangle.width <= 0 || aRectangle.height <= 0)
+		{
+			return;
+		}
+		int top = std::max( aRectangle.y, 0);
+		int bottom = static_cast< int >( std::min( static_cast< long long >( aRectangle.y) + aRectangle.height - 1, static_cast< long long >( height) - 1));
+		for (int y = top; y <= bottom; ++y)
+		{
+			fillSpan( aRectangle.x, aRectangle.x + aRectangle.width - 1, y, brushPixel);
+		}
+
+		const wxPoint corners[] = {	aRectangle.GetTopLeft(),
+									aRectangle.GetTopRight(),
+									aRectangle.GetBottomRight(),
+									aRectangle.GetBottomLeft(),
+									aRectangle.GetTopLeft()};
+		drawLines( 5, corners);
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::drawCircle(	const wxPoint& aCentre,
+										int aRadius)
+	{
+		// A circle whose bounding box, including the pen, misses the image is not drawn at all
+		long long reach = static_cast< long long >( aRadius) + penWidth;
+		if (aRadius < 0 ||
+			aCentre.x + reach < 0 || aCentre.x - reach >= width ||
+			aCentre.y + reach < 0 || aCentre.y - reach >= height)
+		{
+			return;
+		}
+
+		int firstRow = static_cast< int >( std::max( -static_cast< long long >( aRadius), -static_cast< long long >( aCentre.y)));
+		int lastRow = static_cast< int >( std::min( static_cast< long long >( aRadius), static_cast< long long >( height) - 1 - aCentre.y));
+		for (int dy = firstRow; dy <= lastRow; ++dy)
+		{
+			int dx = static_cast< int >( std::sqrt( static_cast< double >( aRadius) * aRadius - static_cast< double >( dy) * dy));
+			fillSpan( aCentre.x - dx, aCentre.x + dx, aCentre.y + dy, brushPixel);
+		}
+
+		// Midpoint circle, one octant mirrored to the other seven
+		int x = aRadius;
+		int y = 0;
+		int error = 1 - aRadius;
+		while (x >= y)
+		{
+			const wxPoint octants[] = {	wxPoint( x, y),
+										wxPoint( y, x),
+										wxPoint( -y, x),
+										wxPoint( -x, y),
+										wxPoint( -x, -y),
+										wxPoint( -y, -x),
+										wxPoint( y, -x),
+										wxPoint( x, -y)};
+			for (const wxPoint& octant : octants)
+			{
+				stampPen( aCentre.x + octant.x, aCentre.y + octant.y);
+			}
+			++y;
+			if (error < 0)
+			{
+				error += 2 * y + 1;
+			} else
+			{
+				--x;
+				error += 2 * (y - x) + 1;
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::drawText(	const std::string& aText,
+										const wxPoint& aTopLeft)
+	{
+		drawGlyphs( aText, aTopLeft, 1.0, 0.0);
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::drawRotatedText(	const std::string& aText,
+											const wxPoint& aTopLeft,
+											double anAngle)
+	{
+		double radians = anAngle / 180.0 * Utils::PI;
+		drawGlyphs( aText, aTopLeft, std::cos( radians), std::sin( radians));
+	}
+	/**
+	 *
+	 */
+	wxSize SoftwareRenderer::getTextExtent( const std::string& aText) const
+	{
+		return wxSize( static_cast< int >( aText.size()) * cellWidth, cellHeight);
+	}
+	/**
+	 *
+	 */
+	/* static */SoftwareRenderer::Pixel SoftwareRenderer::toPixel( const Colour& aColour)
+	{
+		return Pixel{ { aColour.red, aColour.green, aColour.blue}};
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::setPixel(	int x,
+										int y,
+										const Pixel& aPixel)
+	{
+		if (x < 0 || y < 0 || x >= width || y >= height)
+		{
+			return;
+		}
+		std::size_t offset = (static_cast< std::size_t >( y) * static_cast< std::size_t >( width) + static_cast< std::size_t >( x)) * 3;
+		pixels[offset] = aPixel[0];
+		pixels[offset + 1] = aPixel[1];
+		pixels[offset + 2] = aPixel[2];
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::fillSpan(	int aLeft,
+										int aRight,
+										int y,
+										const Pixel& aPixel)
+	{
+		if (y < 0 || y >= height)
+		{
+			return;
+		}
+		aLeft = std::max( aLeft, 0);
+		aRight = std::min( aRight, width - 1);
+		for (int x = aLeft; x <= aRight; ++x)
+		{
+			setPixel( x, y, aPixel);
+		}
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::stampPen(	int x,
+										int y)
+	{
+		int first = -(penWidth - 1) / 2;
+		int last = penWidth / 2;
+		for (int dy = first; dy <= last; ++dy)
+		{
+			fillSpan( x + first, x + last, y + dy, penPixel);
+		}
+	}
+	/**
+	 *
+	 */
+	void SoftwareRenderer::drawGlyphs(	const std::string& aText,
+										const wxPoint& aTopLeft,
+										double aCos,
+										double aSin)
+	{
+		const Pixel black{ { 0, 0, 0}};
+		for (std::size_t i = 0; i < aText.size(); ++i)
+		{
+			const Glyph* glyph = findGlyph( aText[i]);
+			if (glyph == nullptr)
+			{
+				continue;
+			}
+			for (int column = 0; column < glyphWidth; ++column)
+			{
+				for (int row = 0; row < glyphHeight; ++row)
+				{
+					if ((glyph->columns[column] & (1 << row)) == 0)
+					{
+						continue;
+					}
+					// Counter clockwise on the screen, where y points down
+					double dx = static_cast< double >( static_cast< int >( i) * cellWidth + column);
+					double dy = static_cast< double >( row);
+					setPixel(	aTopLeft.x + static_cast< int >( std::lround( dx * aCos + dy * aSin)),
+								aTopLeft.y + static_cast< int >( std::lround( dy * aCos - dx * aSin)),
+								black);
+				}
+			}
+		}
+	}
+} // namespace View
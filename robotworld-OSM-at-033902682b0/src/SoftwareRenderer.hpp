@@ -0,0 +1,171 @@
+#ifndef SOFTWARERENDERER_HPP_
+#define SOFTWARERENDERER_HPP_
+
+#include "Config.hpp"
+
+#include "Renderer.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace View
+{
+	/**
+	 * Draws in a 24 bit RGB image in memory without wxDC, so frames can be made without a display.
+	 *
+	 * Figures are not anti-aliased. Text is drawn in black in a built in 5x7 pixel font that only has digits,
+	 * capitals and some punctuation, small letters are drawn as capitals.
+	 */
+	class SoftwareRenderer : public Renderer
+	{
+		public:
+			/**
+			 *
+			 */
+			SoftwareRenderer(	int aWidth,
+								int aHeight);
+			/**
+			 *
+			 */
+			virtual ~SoftwareRenderer() = default;
+			/**
+			 *
+			 */
+			int getWidth() const
+			{
+				return width;
+			}
+			/**
+			 *
+			 */
+			int getHeight() const
+			{
+				return height;
+			}
+			/**
+			 *
+			 * @return the rows of the image from top to bottom, 3 bytes per pixel in the order red, green, blue
+			 */
+			const std::vector< unsigned char >& getPixels() const
+			{
+				return pixels;
+			}
+			/**
+			 * Fills the whole image with aColour
+			 */
+			void clear( const Colour& aColour);
+			/**
+			 *
+			 * @return the image as a binary PPM (P6) file
+			 */
+			std::string asPpm() const;
+			/**
+			 * @name Renderer functions
+			 */
+			//@{
+			/**
+			 *
+			 */
+			virtual void setPen(	const Colour& aColour,
+									int aWidth) override;
+			/**
+			 *
+			 */
+			virtual void setBrush( const Colour& aColour) override;
+			/**
+			 *
+			 */
+			virtual void drawPoint( const wxPoint& aPoint) override;
+			/**
+			 *
+			 */
+			virtual void drawLine(	const wxPoint& aBegin,
+									const wxPoint& anEnd) override;
+			/**
+			 *
+			 */
+			virtual void drawLines(	std::size_t aNumberOfPoints,
+									const wxPoint aPoints[]) override;
+			/**
+			 * The inside is filled with the odd-even rule, as a wxDC does by default
+			 */
+			virtual void drawPolygon(	std::size_t aNumberOfPoints,
+										const wxPoint aPoints[]) override;
+			/**
+			 *
+			 */
+			virtual void drawRectangle( const wxRect& aRectangle) override;
+			/**
+			 *
+			 */
+			virtual void drawCircle(	const wxPoint& aCentre,
+										int aRadius) override;
+			/**
+			 *
+			 */
+			virtual void drawText(	const std::string& aText,
+									const wxPoint& aTopLeft) override;
+			/**
+			 *
+			 */
+			virtual void drawRotatedText(	const std::string& aText,
+											const wxPoint& aTopLeft,
+											double anAngle) override;
+			/**
+			 *
+			 */
+			virtual wxSize getTextExtent( const std::string& aText) const override;
+			/**
+			 * Always 1, the image has the size of the world
+			 */
+			virtual double getScale() const override
+			{
+				return 1.0;
+			}
+			//@}
+
+		private:
+			typedef std::array< unsigned char, 3 > Pixel;
+			/**
+			 *
+			 */
+			static Pixel toPixel( const Colour& aColour);
+			/**
+			 * Sets a single pixel, pixels outside the image are ignored
+			 */
+			void setPixel(	int x,
+							int y,
+							const Pixel& aPixel);
+			/**
+			 * Sets the pixels of a row from left to right inclusive
+			 */
+			void fillSpan(	int aLeft,
+							int aRight,
+							int y,
+							const Pixel& aPixel);
+			/**
+			 * Sets a square of the width of the pen around aPoint
+			 */
+			void stampPen(	int x,
+							int y);
+			/**
+			 * Draws the lit pixels of aText, rotated around aTopLeft
+			 */
+			void drawGlyphs(	const std::string& aText,
+								const wxPoint& aTopLeft,
+								double aCos,
+								double aSin);
+
+			int width;
+			int height;
+			std::vector< unsigned char > pixels;
+
+			Pixel penPixel;
+			int penWidth;
+			Pixel brushPixel;
+	};
+	//	class SoftwareRenderer
+} // namespace View
+
+#endif // SOFTWARERENDERER_HPP_
@@ -0,0 +1,260 @@
+#ifndef SPATIALGRID_HPP_
+#define SPATIALGRID_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+#include "Size.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Utils
+{
+	/**
+	 * A uniform grid that maps the bounding boxes of objects to the cells they overlap. Querying a rectangle
+	 * only visits the cells under that rectangle, so the cost of a query is proportional to the number of
+	 * objects near the rectangle instead of the total number of objects.
+	 *
+	 * The grid is sparse: only blocks of blockSize * blockSize cells that contain objects take memory, so there are
+	 * no bounds on the coordinates.
+	 *
+	 * Copies of a grid share their blocks until one of the copies changes a block, which then gets its own copy of
+	 * that block. Copying a grid therefore costs a pointer per block and changing a copy costs a copy of the
+	 * changed blocks only, whatever the number of objects. A copy may be read by other threads while the original
+	 * is changed, but a single grid must not be read and changed at the same time.
+	 *
+	 * @tparam Key The type that identifies an object, typically a (non-owning) pointer. It must be equality and
+	 * less-than comparable.
+	 */
+	template< typename Key >
+	class SpatialGrid
+	{
+		public:
+			/**
+			 * The width and height of a block in cells
+			 */
+			static const int blockSize = 8;
+			/**
+			 *
+			 * @param aCellSize The width and height of a cell in pixels
+			 */
+			explicit SpatialGrid( int aCellSize = 32) :
+								cellSize( aCellSize)
+			{
+			}
+			/**
+			 *
+			 */
+			int getCellSize() const
+			{
+				return cellSize;
+			}
+			/**
+			 * Adds aKey to all cells that overlap aBoundingBox
+			 */
+			void insert(	const Key& aKey,
+							const wxRect& aBoundingBox)
+			{
+				forEachCell( aBoundingBox, [this, &aKey](int aColumn, int aRow)
+				{
+					Block& block = getWritableBlock( getBlockKey( aColumn, aRow));
+					block.cells[getCellIndex( aColumn, aRow)].push_back( aKey);
+					++block.size;
+				});
+				++size;
+			}
+			/**
+			 * Removes aKey from all cells that overlap aBoundingBox, which must be the bounding box aKey was inserted with
+			 *
+			 * @return true if aKey was found, false otherwise
+			 */
+			bool remove(	const Key& aKey,
+							const wxRect& aBoundingBox)
+			{
+				bool found = false;
+				forEachCell( aBoundingBox, [this, &aKey, &found](int aColumn, int aRow)
+				{
+					std::int64_t blockKey = getBlockKey( aColumn, aRow);
+					auto block = blocks.find( blockKey);
+					if (block == blocks.end())
+					{
+						return;
+					}
+					const std::vector< Key >& keys = block->second->cells[getCellIndex( aColumn, aRow)];
+					if (std::find( keys.begin(), keys.end(), aKey) == keys.end())
+					{
+						return;
+					}
+					Block& writableBlock = getWritableBlock( blockKey);
+					std::vector< Key >& writableKeys = writableBlock.cells[getCellIndex( aColumn, aRow)];
+					auto i = std::find( writableKeys.begin(), writableKeys.end(), aKey);
+					*i = writableKeys.back();
+					writableKeys.pop_back();
+					found = true;
+					if (--writableBlock.size == 0)
+					{
+						blocks.erase( blockKey);
+					}
+				});
+				if (found)
+				{
+					--size;
+				}
+				return found;
+			}
+			/**
+			 * Moves aKey from anOldBoundingBox to aNewBoundingBox. Nothing happens if aKey was not in the grid.
+			 *
+			 * @return true if aKey was found, false otherwise
+			 */
+			bool move(	const Key& aKey,
+						const wxRect& anOldBoundingBox,
+						const wxRect& aNewBoundingBox)
+			{
+				if (remove( aKey, anOldBoundingBox))
+				{
+					insert( aKey, aNewBoundingBox);
+					return true;
+				}
+				return false;
+			}
+			/**
+			 *
+			 */
+			void clear()
+			{
+				blocks.clear();
+				size = 0;
+			}
+			/**
+			 *
+			 * @return the number of keys in the grid
+			 */
+			std::size_t getSize() const
+			{
+				return size;
+			}
+			/**
+			 * Appends all keys whose cells overlap aBoundingBox to aResult, each key only once. The result is a
+			 * superset of the keys whose bounding box actually intersects aBoundingBox, the caller does the exact test.
+			 */
+			void query(	const wxRect& aBoundingBox,
+						std::vector< Key >& aResult) const
+			{
+				std::size_t first = aResult.size();
+				forEachCell( aBoundingBox, [this, &aResult](int aColumn, int aRow)
+				{
+					auto block = blocks.find( getBlockKey( aColumn, aRow));
+					if (block != blocks.end())
+					{
+						const std::vector< Key >& keys = block->second->cells[getCellIndex( aColumn, aRow)];
+						aResult.insert( aResult.end(), keys.begin(), keys.end());
+					}
+				});
+				// Objects that span multiple cells are found multiple times
+				std::sort( aResult.begin() + first, aResult.end());
+				aResult.erase( std::unique( aResult.begin() + first, aResult.end()), aResult.end());
+			}
+			/**
+			 *
+			 */
+			std::vector< Key > query( const wxRect& aBoundingBox) const
+			{
+				std::vector< Key > result;
+				query( aBoundingBox, result);
+				return result;
+			}
+
+		private:
+			/**
+			 * The cells of a block in row major order
+			 */
+			struct Block
+			{
+					std::array< std::vector< Key >, blockSize * blockSize > cells;
+					/**
+					 * The number of keys in all cells
+					 */
+					std::size_t size = 0;
+			};
+			/**
+			 * Floor division so that negative coordinates end up in their own cells and blocks
+			 */
+			static int floorDivide(	int aNumerator,
+									int aDenominator)
+			{
+				return aNumerator >= 0 ? aNumerator / aDenominator : -((-aNumerator - 1) / aDenominator) - 1;
+			}
+			/**
+			 *
+			 */
+			static std::int64_t getBlockKey(	int aColumn,
+												int aRow)
+			{
+				// The row and column are shifted unsigned, shifting a negative row is undefined
+				std::uint32_t column = static_cast< std::uint32_t >( floorDivide( aColumn, blockSize));
+				std::uint32_t row = static_cast< std::uint32_t >( floorDivide( aRow, blockSize));
+				return static_cast< std::int64_t >( (static_cast< std::uint64_t >( row) << 32) | column);
+			}
+			/**
+			 *
+			 */
+			static std::size_t getCellIndex(	int aColumn,
+												int aRow)
+			{
+				return static_cast< std::size_t >( (aRow - floorDivide( aRow, blockSize) * blockSize) * blockSize + aColumn - floorDivide( aColumn, blockSize) * blockSize);
+			}
+			/**
+			 *
+			 * @return the block with aBlockKey, created if it does not exist and copied if it is shared with another grid
+			 */
+			Block& getWritableBlock( std::int64_t aBlockKey)
+			{
+				std::shared_ptr< Block >& block = blocks[aBlockKey];
+				if (!block)
+				{
+					block = std::make_shared< Block >();
+				} else if (block.use_count() > 1)
+				{
+					block = std::make_shared< Block >( *block);
+				} else
+				{
+					// Another grid that shared the block may just have released it, see its last reads before writing
+					std::atomic_thread_fence( std::memory_order_acquire);
+				}
+				return *block;
+			}
+			/**
+			 * Calls aFunction with the column and row of every cell that overlaps aBoundingBox
+			 */
+			template< typename Function >
+			void forEachCell(	const wxRect& aBoundingBox,
+								const Function& aFunction) const
+			{
+				int left = floorDivide( aBoundingBox.x, cellSize);
+				int top = floorDivide( aBoundingBox.y, cellSize);
+				int right = floorDivide( aBoundingBox.x + std::max( aBoundingBox.width - 1, 0), cellSize);
+				int bottom = floorDivide( aBoundingBox.y + std::max( aBoundingBox.height - 1, 0), cellSize);
+				for (int row = top; row <= bottom; ++row)
+				{
+					for (int column = left; column <= right; ++column)
+					{
+						aFunction( column, row);
+					}
+				}
+			}
+
+			int cellSize;
+			std::size_t size = 0;
+			std::unordered_map< std::int64_t, std::shared_ptr< Block > > blocks;
+	};
+	//	class SpatialGrid
+} // namespace Utils
+
+#endif // SPATIALGRID_HPP_
@@ -0,0 +1,184 @@
+#include "TaskScheduler.hpp"
+
+#include <algorithm>
+
+namespace Base
+{
+	namespace
+	{
+		/**
+		 * The scheduler and deque of the current thread if it is a worker thread
+		 */
+		thread_local const TaskScheduler* currentScheduler = nullptr;
+		thread_local std::size_t currentWorker = 0;
+	} // namespace
+
+	/**
+	 *
+	 */
+	TaskScheduler::TaskScheduler( unsigned int aNumberOfThreads /*= std::thread::hardware_concurrency()*/) :
+								stopping( false),
+								queued( 0)
+	{
+		std::size_t numberOfThreads = std::max( aNumberOfThreads, 1U);
+		for (std::size_t i = 0; i < numberOfThreads; ++i)
+		{
+			workers.push_back( std::make_unique< Worker >());
+		}
+		for (std::size_t i = 1; i < numberOfThreads; ++i)
+		{
+			threads.push_back( std::thread( [this, i]
+			{
+				work( i);
+			}));
+		}
+	}
+	/**
+	 *
+	 */
+	TaskScheduler::~TaskScheduler()
+	{
+		{
+			std::unique_lock< std::mutex > lock( sleepMutex);
+			stopping = true;
+		}
+		workAvailable.notify_all();
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+	/**
+	 *
+	 */
+	void TaskScheduler::spawn(	TaskGroup& aGroup,
+								const Task& aTask)
+	{
+		++aGroup.pending;
+
+		Worker& worker = *workers[getCurrentWorker()];
+		{
+			std::unique_lock< std::mutex > lock( worker.dequeMutex);
+			worker.deque.push_back( WorkItem{ aTask, &aGroup});
+		}
+		++queued;
+
+		// Taking the lock guarantees that a worker that is about to sleep sees the new task
+		{
+			std::unique_lock< std::mutex > lock( sleepMutex);
+		}
+		workAvailable.notify_one();
+	}
+	/**
+	 *
+	 */
+	void TaskScheduler::wait( TaskGroup& aGroup)
+	{
+		std::size_t worker = getCurrentWorker();
+		while (aGroup.pending > 0)
+		{
+			if (!executeTask( worker))
+			{
+				// The remaining tasks of the group are running on other threads, sleep until one of them finishes
+				// the group or spawns a task this thread can help with
+				std::unique_lock< std::mutex > lock( sleepMutex);
+				workAvailable.wait( lock, [this, &aGroup]
+				{
+					return aGroup.pending == 0 || queued > 0;
+				});
+			}
+		}
+
+		std::unique_lock< std::mutex > lock( aGroup.exceptionMutex);
+		if (aGroup.exception)
+		{
+			std::exception_ptr exception = aGroup.exception;
+			aGroup.exception = nullptr;
+			std::rethrow_exception( exception);
+		}
+	}
+	/**
+	 *
+	 */
+	std::size_t TaskScheduler::getCurrentWorker() const
+	{
+		return currentScheduler == this ? currentWorker : 0;
+	}
+	/**
+	 *
+	 */
+	bool TaskScheduler::executeTask( std::size_t aWorker)
+	{
+		WorkItem workItem{ nullptr, nullptr};
+
+		// Newest first from the own deque
+		{
+			Worker& worker = *workers[aWorker];
+			std::unique_lock< std::mutex > lock( worker.dequeMutex);
+			if (!worker.deque.empty())
+			{
+				workItem = std::move( worker.deque.back());
+				worker.deque.pop_back();
+			}
+		}
+		// Oldest first from the others
+		for (std::size_t i = 1; !workItem.group && i < workers.size(); ++i)
+		{
+			Worker& victim = *workers[(aWorker + i) % workers.size()];
+			std::unique_lock< std::mutex > lock( victim.dequeMutex);
+			if (!victim.deque.empty())
+			{
+				workItem = std::move( victim.deque.front());
+				victim.deque.pop_front();
+			}
+		}
+		if (!workItem.group)
+		{
+			return false;
+		}
+		--queued;
+
+		try
+		{
+			workItem.task();
+		}
+		catch (...)
+		{
+			std::unique_lock< std::mutex > lock( workItem.group->exceptionMutex);
+			if (!workItem.group->exception)
+			{
+				workItem.group->exception = std::current_exception();
+			}
+		}
+		if (--workItem.group->pending == 0)
+		{
+			// The group may be destroyed as soon as its waiter sees this, so only the scheduler is used from here on.
+			// Taking the lock guarantees that a waiter that is about to sleep sees the finished group.
+			{
+				std::unique_lock< std::mutex > lock( sleepMutex);
+			}
+			workAvailable.notify_all();
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	void TaskScheduler::work( std::size_t aWorker)
+	{
+		currentScheduler = this;
+		currentWorker = aWorker;
+
+		while (!stopping)
+		{
+			if (!executeTask( aWorker))
+			{
+				std::unique_lock< std::mutex > lock( sleepMutex);
+				workAvailable.wait( lock, [this]
+				{
+					return stopping || queued > 0;
+				});
+			}
+		}
+	}
+} // namespace Base
@@ -0,0 +1,169 @@
+#ifndef TASKSCHEDULER_HPP_
+#define TASKSCHEDULER_HPP_
+
+#include "Config.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Base
+{
+	/**
+	 * A work-stealing task scheduler.
+	 *
+	 * Every worker thread has its own deque of tasks. A worker pushes the tasks it spawns to the back of its own
+	 * deque and takes its next task from the back as well, so related tasks stay on the same core. A worker that
+	 * runs out of tasks steals the oldest task from the front of the deque of another worker, which is typically
+	 * the largest piece of remaining work. Threads that are not workers, e.g. the simulation thread, share one
+	 * extra deque.
+	 *
+	 * A thread that waits for a TaskGroup executes tasks while it waits, so tasks may spawn and wait for
+	 * subtasks without blocking a worker.
+	 */
+	class TaskScheduler
+	{
+		public:
+			typedef std::function< void() > Task;
+			/**
+			 * Tracks the completion of a group of tasks, see TaskScheduler::wait
+			 */
+			class TaskGroup
+			{
+				public:
+					TaskGroup() :
+									pending( 0)
+					{
+					}
+					TaskGroup( const TaskGroup&) = delete;
+					TaskGroup& operator=( const TaskGroup&) = delete;
+
+				private:
+					friend class TaskScheduler;
+
+					std::atomic< std::size_t > pending;
+					std::mutex exceptionMutex;
+					std::exception_ptr exception;
+			};
+			/**
+			 *
+			 * @param aNumberOfThreads The number of threads that execute tasks, including the thread that waits.
+			 * 						   The scheduler starts aNumberOfThreads - 1 worker threads.
+			 */
+			explicit TaskScheduler( unsigned int aNumberOfThreads = std::thread::hardware_concurrency());
+			/**
+			 * Waits for the running tasks and stops the worker threads. Tasks that did not start are discarded.
+			 */
+			~TaskScheduler();
+			/**
+			 *
+			 */
+			unsigned int getNumberOfThreads() const
+			{
+				return static_cast< unsigned int >( threads.size()) + 1;
+			}
+			/**
+			 * Schedules aTask as part of aGroup
+			 */
+			void spawn(	TaskGroup& aGroup,
+						const Task& aTask);
+			/**
+			 * Executes tasks until all tasks of aGroup are finished. If a task of aGroup threw an exception the first
+			 * exception is rethrown.
+			 */
+			void wait( TaskGroup& aGroup);
+			/**
+			 * Calls aFunction( first, last) for consecutive ranges of [aBegin, anEnd) in parallel. The range is split
+			 * in halves as long as it is larger than aGrainSize, each half is a task that can be stolen.
+			 */
+			template< typename Function >
+			void parallelFor(	std::size_t aBegin,
+								std::size_t anEnd,
+								std::size_t aGrainSize,
+								const Function& aFunction)
+			{
+				TaskGroup group;
+				splitRange( group, aBegin, anEnd, std::max( aGrainSize, static_cast< std::size_t >( 1)), aFunction);
+				wait( group);
+			}
+
+		private:
+			/**
+			 *
+			 */
+			struct WorkItem
+			{
+					Task task;
+					TaskGroup* group;
+			};
+			/**
+			 *
+			 */
+			struct Worker
+			{
+					std::mutex dequeMutex;
+					std::deque< WorkItem > deque;
+			};
+			/**
+			 *
+			 */
+			template< typename Function >
+			void splitRange(	TaskGroup& aGroup,
+								std::size_t aBegin,
+								std::size_t anEnd,
+								std::size_t aGrainSize,
+								const Function& aFunction)
+			{
+				while (anEnd - aBegin > aGrainSize)
+				{
+					std::size_t middle = aBegin + (anEnd - aBegin) / 2;
+					spawn( aGroup, [this, &aGroup, middle, anEnd, aGrainSize, &aFunction]
+					{
+						splitRange( aGroup, middle, anEnd, aGrainSize, aFunction);
+					});
+					anEnd = middle;
+				}
+				if (aBegin < anEnd)
+				{
+					aFunction( aBegin, anEnd);
+				}
+			}
+			/**
+			 *
+			 * @return the index of the deque of the calling thread
+			 */
+			std::size_t getCurrentWorker() const;
+			/**
+			 * Takes a task from the back of the own deque or steals one from the front of another deque and executes it
+			 *
+			 * @return false if there was no task
+			 */
+			bool executeTask( std::size_t aWorker);
+			/**
+			 * The loop of a worker thread
+			 */
+			void work( std::size_t aWorker);
+
+			/**
+			 * Deque 0 is shared by the threads that are not workers, worker thread n uses deque n
+			 */
+			std::vector< std::unique_ptr< Worker > > workers;
+			std::vector< std::thread > threads;
+
+			std::atomic< bool > stopping;
+			std::atomic< std::size_t > queued;
+			std::mutex sleepMutex;
+			std::condition_variable workAvailable;
+	};
+	//	class TaskScheduler
+} // namespace Base
+
+#endif // TASKSCHEDULER_HPP_
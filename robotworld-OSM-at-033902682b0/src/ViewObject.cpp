@@ -20,6 +20,14 @@ namespace View
 			handleNotificationsFor(*modelObject);
 		}
 	}
+	/**
+	 *
+	 */
+	ViewObject::~ViewObject()
+	{
+		// Normally the owner already did this, but a Notifier must never keep a destroyed Observer
+		stopObserving();
+	}
 	/**
 	 *
 	 */
@@ -41,6 +49,16 @@ namespace View
 	{
 		rebindModelObject(aModelObject);
 	}
+	/**
+	 *
+	 */
+	void ViewObject::stopObserving()
+	{
+		if(modelObject)
+		{
+			stopHandlingNotificationsFor(*modelObject);
+		}
+	}
 	/**
 	 * This function will call ModelObject::addReference.
 	 * It will stop handling the notifications for the old object,
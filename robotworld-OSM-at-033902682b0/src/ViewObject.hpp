@@ -27,6 +27,10 @@ namespace View
 			 * ModelObject constructor
 			 */
 			explicit ViewObject(Model::ModelObjectPtr aModelObject);
+			/**
+			 * Stops observing the ModelObject, see stopObserving
+			 */
+			virtual ~ViewObject();
 			//@}
 
 			/**
@@ -48,6 +52,14 @@ namespace View
 			 */
 			void setModelObject(Model::ModelObjectPtr aModelObject) ;
 			//@}
+			/**
+			 * Stops observing the ModelObject and waits for a notification that is being delivered to this ViewObject.
+			 *
+			 * The owner must call this before it releases the ViewObject: the destructor of ViewObject runs after the
+			 * destructors of the derived classes, a notification that is delivered by the NotificationDispatcher
+			 * in the meantime would reach a partly destroyed object.
+			 */
+			void stopObserving();
 		protected:
 			/**
 			 * @name ViewObject implementation
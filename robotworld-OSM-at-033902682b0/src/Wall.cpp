@@ -1,6 +1,7 @@
 #include "Wall.hpp"
 
 #include "Logger.hpp"
+#include "RobotWorld.hpp"
 #include "Shape2DUtils.hpp"
 
 #include <sstream>
@@ -22,10 +23,12 @@ namespace Model
 	void Wall::setPoint1(	const wxPoint& aPoint1,
 							bool aNotifyObservers /*= true*/)
 	{
+		wxRect oldBoundingBox = getBoundingBox();
 		point1 = aPoint1;
+		RobotWorld::getRobotWorld().updateWallIndex( this, oldBoundingBox);
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers( Base::Notification::PositionChanged);
 		}
 	}
 	/**
@@ -34,12 +37,22 @@ namespace Model
 	void Wall::setPoint2(	const wxPoint& aPoint2,
 							bool aNotifyObservers /*= true*/)
 	{
+		wxRect oldBoundingBox = getBoundingBox();
 		point2 = aPoint2;
+		RobotWorld::getRobotWorld().updateWallIndex( this, oldBoundingBox);
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers( Base::Notification::PositionChanged);
 		}
 	}
+	/**
+	 *
+	 */
+	wxRect Wall::getBoundingBox() const
+	{
+		const wxPoint points[] = { point1, point2};
+		return Utils::Shape2DUtils::getBoundingBox( points, 2);
+	}
 	/**
 	 *
 	 */
@@ -46,6 +46,11 @@ namespace Model
 			 */
 			void setPoint2( const wxPoint& aPoint2,
 							bool aNotifyObservers = true);
+			/**
+			 *
+			 * @return the smallest rectangle that contains both points
+			 */
+			wxRect getBoundingBox() const;
 			/**
 			 * @name Debug functions
 			 */
@@ -94,17 +94,17 @@ namespace View
 	/**
 	 *
 	 */
-	void WallShape::draw( wxDC& dc)
+	void WallShape::draw( Renderer& renderer)
 	{
 		if (isSelected())
 		{
-			dc.SetPen( wxPen(  "RED", getLineWidth(), wxPENSTYLE_SOLID));
+			renderer.setPen( "RED", getLineWidth());
 		} else
 		{
-			dc.SetPen( wxPen(  "BLACK", getLineWidth(), wxPENSTYLE_SOLID));
+			renderer.setPen( "BLACK", getLineWidth());
 		}
 
-		dc.DrawLine( getNode1()->getCentre().x, getNode1()->getCentre().y, getNode2()->getCentre().x, getNode2()->getCentre().y);
+		renderer.drawLine( getNode1()->getCentre(), getNode2()->getCentre());
 	}
 	/**
 	 *
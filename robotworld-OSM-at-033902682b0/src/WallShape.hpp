@@ -63,7 +63,7 @@ namespace View
 			/**
 			 *
 			 */
-			virtual void draw( wxDC& dc) override;
+			virtual void draw( Renderer& renderer) override;
 			/**
 			 *
 			 * @param aPoint
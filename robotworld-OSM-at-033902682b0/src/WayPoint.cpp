@@ -1,6 +1,7 @@
 #include "WayPoint.hpp"
 
 #include "Logger.hpp"
+#include "RobotWorld.hpp"
 
 #include <sstream>
 
@@ -28,10 +29,12 @@ namespace Model
 	void WayPoint::setName( const std::string& aName,
 							bool aNotifyObservers /*= true*/)
 	{
+		std::string oldName = name;
 		name = aName;
+		RobotWorld::getRobotWorld().updateNameIndex( getObjectId(), oldName);
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers( Base::Notification::AttributesChanged);
 		}
 	}
 	/**
@@ -50,7 +53,7 @@ wxSize WayPoint::getSize() const
 		size = aSize;
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers( Base::Notification::AttributesChanged);
 		}
 	}
 	/**
@@ -60,9 +63,10 @@ wxSize WayPoint::getSize() const
 								bool aNotifyObservers /*= true*/)
 	{
 		position = aPosition;
+		RobotWorld::getRobotWorld().getChangeJournal().record( Change::EntityMoved, getEntity(), getObjectId());
 		if (aNotifyObservers == true)
 		{
-			notifyObservers();
+			notifyObservers( Base::Notification::PositionChanged);
 		}
 	}
 	/**
@@ -3,6 +3,7 @@
 
 #include "Config.hpp"
 
+#include "ChangeJournal.hpp"
 #include "ModelObject.hpp"
 #include "Point.hpp"
 #include "Region.hpp"
@@ -57,6 +58,14 @@ namespace Model
 			 */
 			void setPosition(	const wxPoint& aPosition,
 								bool aNotifyObservers = true);
+			/**
+			 *
+			 * @return the kind of object in the ChangeJournal
+			 */
+			virtual Change::Entity getEntity() const
+			{
+				return Change::WayPointEntity;
+			}
 			/**
 			 *
 			 */
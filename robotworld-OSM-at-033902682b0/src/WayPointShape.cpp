@@ -32,17 +32,17 @@ namespace View
 	/**
 	 *
 	 */
-	void WayPointShape::handleNotification()
+	void WayPointShape::handleNotification( const Base::Notification& UNUSEDPARAM(aNotification))
 	{
 		Application::Logger::log( __PRETTY_FUNCTION__);
 	}
 	/**
 	 *
 	 */
-	void WayPointShape::draw( wxDC& dc)
+	void WayPointShape::draw( Renderer& renderer)
 	{
 		// The minimum size of the RectangleShape is the size of the title
-		titleSize = dc.GetTextExtent( title);
+		titleSize = renderer.getTextExtent( title);
 		if (size.x < (titleSize.x + 2 * spacing + 2 * borderWidth))
 		{
 			size.x = titleSize.x + 2 * spacing + 2 * borderWidth;
@@ -58,21 +58,21 @@ namespace View
 		}
 
 		// Draws a rectangle with the given top left corner, and with the given size.
-		dc.SetBrush( *wxWHITE_BRUSH);
+		renderer.setBrush( Colour( "WHITE"));
 		if (isSelected())
 		{
-			dc.SetPen( wxPen( getSelectionColour(), borderWidth, wxPENSTYLE_SOLID));
+			renderer.setPen( getSelectionColour(), borderWidth);
 		} else
 		{
-			dc.SetPen( wxPen( getNormalColour(), borderWidth, wxPENSTYLE_SOLID));
+			renderer.setPen( getNormalColour(), borderWidth);
 		}
 
 		int x = centre.x - (size.x / 2);
 		int y = centre.y - (size.y / 2);
-		dc.DrawRectangle( x, y, size.x, size.y);
+		renderer.drawRectangle( wxRect( x, y, size.x, size.y));
 
-		dc.SetPen( wxPen(  "BLACK", borderWidth, wxPENSTYLE_SOLID));
-		dc.DrawText( title, centre.x - titleSize.x / 2, y + spacing + borderWidth);
+		renderer.setPen( "BLACK", borderWidth);
+		renderer.drawText( title, wxPoint( centre.x - titleSize.x / 2, y + spacing + borderWidth));
 	}
 	/**
 	 *
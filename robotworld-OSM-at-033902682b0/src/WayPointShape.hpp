@@ -34,21 +34,21 @@ namespace View
 			/**
 			 *
 			 */
-			virtual wxColour getNormalColour() const  override
+			virtual Colour getNormalColour() const  override
 			{
 				return "BLUE";
 			}
 			/**
 			 *
 			 */
-			virtual wxColour getSelectionColour() const  override
+			virtual Colour getSelectionColour() const  override
 			{
 				return "BLUE";
 			}
 			/**
 			 *
 			 */
-			virtual wxColour getActivationColour() const  override
+			virtual Colour getActivationColour() const  override
 			{
 				return "BLACK";
 			}
@@ -61,7 +61,7 @@ namespace View
 			 * A Notifier will call this function if this Observer will handle the notifications of that
 			 * Notifier. It is the responsibility of the Observer to filter any events it is interested in.
 			 */
-			virtual void handleNotification()  override;
+			virtual void handleNotification( const Base::Notification& aNotification) override;
 			//@}
 			/**
 			 * @name Pure virtual abstract Shape functions
@@ -70,7 +70,7 @@ namespace View
 			/**
 			 *
 			 */
-			virtual void draw( wxDC& dc) override;
+			virtual void draw( Renderer& renderer) override;
 			/**
 			 *
 			 */
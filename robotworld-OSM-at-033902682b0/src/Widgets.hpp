@@ -14,6 +14,7 @@
 #include <wx/defs.h>
 #include <wx/dnd.h>
 #include <wx/event.h>
+#include <wx/filedlg.h>
 #include <wx/font.h>
 #include <wx/frame.h>
 #include <wx/gbsizer.h>
@@ -0,0 +1,97 @@
+#include "WorldBuilder.hpp"
+
+#include "Goal.hpp"
+#include "MemoryPool.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Wall.hpp"
+#include "WayPoint.hpp"
+
+namespace Model
+{
+	/**
+	 *
+	 */
+	void WorldBuilder::reserve(	std::size_t aNumberOfRobots,
+								std::size_t aNumberOfWayPoints,
+								std::size_t aNumberOfGoals,
+								std::size_t aNumberOfWalls)
+	{
+		robots.reserve( aNumberOfRobots);
+		wayPoints.reserve( aNumberOfWayPoints);
+		goals.reserve( aNumberOfGoals);
+		walls.reserve( aNumberOfWalls);
+	}
+	/**
+	 *
+	 */
+	RobotPtr WorldBuilder::addRobot(	const std::string& aName,
+										const wxPoint& aPosition)
+	{
+		robots.push_back( std::allocate_shared< Robot >( Base::PoolAllocator< Robot >(), aName, aPosition));
+		return robots.back();
+	}
+	/**
+	 *
+	 */
+	WayPointPtr WorldBuilder::addWayPoint(	const std::string& aName,
+											const wxPoint& aPosition)
+	{
+		wayPoints.push_back( std::allocate_shared< WayPoint >( Base::PoolAllocator< WayPoint >(), aName, aPosition));
+		return wayPoints.back();
+	}
+	/**
+	 *
+	 */
+	GoalPtr WorldBuilder::addGoal(	const std::string& aName,
+									const wxPoint& aPosition)
+	{
+		goals.push_back( std::allocate_shared< Goal >( Base::PoolAllocator< Goal >(), aName, aPosition));
+		return goals.back();
+	}
+	/**
+	 *
+	 */
+	WallPtr WorldBuilder::addWall(	const wxPoint& aPoint1,
+									const wxPoint& aPoint2)
+	{
+		walls.push_back( std::allocate_shared< Wall >( Base::PoolAllocator< Wall >(), aPoint1, aPoint2));
+		return walls.back();
+	}
+	/**
+	 *
+	 */
+	void WorldBuilder::moveRobot(	const RobotPtr& aRobot,
+									const wxPoint& aPosition)
+	{
+		robotMoves.emplace_back( aRobot, aPosition);
+	}
+	/**
+	 *
+	 */
+	void WorldBuilder::commit( bool aNotifyObservers /*= true*/)
+	{
+		RobotWorld::getRobotWorld().commit( *this, aNotifyObservers);
+		clear();
+	}
+	/**
+	 *
+	 */
+	void WorldBuilder::replace(	const std::vector< Base::ObjectId >& aKeepObjects,
+								bool aNotifyObservers /*= true*/)
+	{
+		RobotWorld::getRobotWorld().replace( *this, aKeepObjects, aNotifyObservers);
+		clear();
+	}
+	/**
+	 *
+	 */
+	void WorldBuilder::clear()
+	{
+		robots.clear();
+		wayPoints.clear();
+		goals.clear();
+		walls.clear();
+		robotMoves.clear();
+	}
+} // namespace Model
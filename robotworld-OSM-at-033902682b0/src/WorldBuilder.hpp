@@ -0,0 +1,154 @@
+#ifndef WORLDBUILDER_HPP_
+#define WORLDBUILDER_HPP_
+
+#include "Config.hpp"
+
+#include "ObjectId.hpp"
+#include "Widgets.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Model
+{
+	class Robot;
+	typedef std::shared_ptr<Robot> RobotPtr;
+
+	class WayPoint;
+	typedef std::shared_ptr<WayPoint> WayPointPtr;
+
+	class Goal;
+	typedef std::shared_ptr<Goal> GoalPtr;
+
+	class Wall;
+	typedef std::shared_ptr<Wall> WallPtr;
+
+	/**
+	 * Collects the objects of a (large) world and adds them to RobotWorld in one go.
+	 *
+	 * The objects are created when they are added to the builder but they only become part of the world at commit.
+	 * The commit reserves the vectors once, builds the wall index and the lookup maps in one pass, publishes a single
+	 * snapshot and notifies the observers of RobotWorld at most once. Adding objects one by one with RobotWorld::new*
+	 * does all of that per object.
+	 *
+	 * The objects should not be changed between adding them and the commit.
+	 */
+	class WorldBuilder
+	{
+		public:
+			/**
+			 *
+			 */
+			WorldBuilder() = default;
+			/**
+			 *
+			 */
+			WorldBuilder( const WorldBuilder&) = delete;
+			/**
+			 *
+			 */
+			WorldBuilder& operator=( const WorldBuilder&) = delete;
+			/**
+			 *
+			 */
+			~WorldBuilder() = default;
+			/**
+			 * Reserves room for the given number of objects in the builder
+			 */
+			void reserve(	std::size_t aNumberOfRobots,
+							std::size_t aNumberOfWayPoints,
+							std::size_t aNumberOfGoals,
+							std::size_t aNumberOfWalls);
+			/**
+			 *
+			 */
+			RobotPtr addRobot(	const std::string& aName,
+								const wxPoint& aPosition);
+			/**
+			 *
+			 */
+			WayPointPtr addWayPoint(	const std::string& aName,
+										const wxPoint& aPosition);
+			/**
+			 *
+			 */
+			GoalPtr addGoal(	const std::string& aName,
+								const wxPoint& aPosition);
+			/**
+			 *
+			 */
+			WallPtr addWall(	const wxPoint& aPoint1,
+								const wxPoint& aPoint2);
+			/**
+			 * Moves aRobot, which is already part of the world, to aPosition at commit
+			 */
+			void moveRobot(	const RobotPtr& aRobot,
+							const wxPoint& aPosition);
+			/**
+			 * Adds all objects to RobotWorld and empties the builder
+			 *
+			 * @param aNotifyObservers If true the observers of RobotWorld are notified once
+			 */
+			void commit( bool aNotifyObservers = true);
+			/**
+			 * Replaces all objects of RobotWorld except aKeepObjects with the objects of the builder and empties the
+			 * builder. Readers never see the world in between.
+			 *
+			 * @param aNotifyObservers If true the observers of RobotWorld are notified once
+			 */
+			void replace(	const std::vector< Base::ObjectId >& aKeepObjects,
+							bool aNotifyObservers = true);
+			/**
+			 *
+			 */
+			const std::vector< RobotPtr >& getRobots() const
+			{
+				return robots;
+			}
+			/**
+			 *
+			 */
+			const std::vector< WayPointPtr >& getWayPoints() const
+			{
+				return wayPoints;
+			}
+			/**
+			 *
+			 */
+			const std::vector< GoalPtr >& getGoals() const
+			{
+				return goals;
+			}
+			/**
+			 *
+			 */
+			const std::vector< WallPtr >& getWalls() const
+			{
+				return walls;
+			}
+			/**
+			 *
+			 */
+			const std::vector< std::pair< RobotPtr, wxPoint > >& getRobotMoves() const
+			{
+				return robotMoves;
+			}
+			/**
+			 * Empties the builder without adding the objects to RobotWorld
+			 */
+			void clear();
+
+		private:
+			std::vector< RobotPtr > robots;
+			std::vector< WayPointPtr > wayPoints;
+			std::vector< GoalPtr > goals;
+			std::vector< WallPtr > walls;
+			std::vector< std::pair< RobotPtr, wxPoint > > robotMoves;
+	};
+	//	class WorldBuilder
+} // namespace Model
+
+#endif // WORLDBUILDER_HPP_
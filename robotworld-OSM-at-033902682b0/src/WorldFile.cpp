@@ -0,0 +1,353 @@
+#include "WorldFile.hpp"
+
+#include "Goal.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Wall.hpp"
+#include "WayPoint.hpp"
+#include "WorldBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace Model
+{
+	namespace
+	{
+		/**
+		 *
+		 */
+		const char magic[4] = { 'R', 'W', 'W', 'F' };
+		/**
+		 *
+		 */
+		std::uint64_t alignSection( std::uint64_t anOffset)
+		{
+			return (anOffset + 7) & ~static_cast< std::uint64_t >( 7);
+		}
+		/**
+		 *
+		 */
+		bool isValidSection(	std::uint64_t anOffset,
+								std::uint64_t aSize,
+								std::size_t aFileSize,
+								std::uint64_t anAlignment = 8)
+		{
+			return anOffset % anAlignment == 0 && anOffset <= aFileSize && aSize <= aFileSize - anOffset;
+		}
+		/**
+		 *
+		 */
+		template< typename T >
+		void append(	std::string& aBuffer,
+						const T& aRecord)
+		{
+			aBuffer.append( reinterpret_cast< const char* >( &aRecord), sizeof(T));
+		}
+		/**
+		 *
+		 */
+		void appendNamedPoints(	std::string& aBuffer,
+								std::string& aNames,
+								const std::string& aName,
+								const wxPoint& aPosition)
+		{
+			WorldFile::NamedPointRecord record{ aPosition.x, aPosition.y, static_cast< std::uint32_t >( aNames.size()), static_cast< std::uint32_t >( aName.size())};
+			append( aBuffer, record);
+			aNames.append( aName);
+		}
+		/**
+		 * Marks the cells a wall runs through and computes the distance of the other cells to the nearest marked
+		 * cell with a two pass 3-4 chamfer distance transform
+		 */
+		std::vector< std::uint16_t > computeClearance(	const std::vector< WallPtr >& aWalls,
+														const WorldFile::ClearanceGrid& aGrid)
+		{
+			const std::uint32_t unknown = std::numeric_limits< std::uint32_t >::max() / 2;
+			std::vector< std::uint32_t > distances( static_cast< std::size_t >( aGrid.columns) * aGrid.rows, unknown);
+
+			for (const WallPtr& wall : aWalls)
+			{
+				const wxPoint& point1 = wall->getPoint1();
+				const wxPoint& point2 = wall->getPoint2();
+				double length = std::hypot( point2.x - point1.x, point2.y - point1.y);
+				// Half a cell per step so no cell on the wall is skipped
+				long steps = static_cast< long >( std::ceil( 2.0 * length / aGrid.cellSize));
+				for (long step = 0; step <= steps; ++step)
+				{
+					double fraction = steps == 0 ? 0.0 : static_cast< double >( step) / static_cast< double >( steps);
+					long column = static_cast< long >( std::floor( (point1.x + fraction * (point2.x - point1.x) - aGrid.x) / aGrid.cellSize));
+					long row = static_cast< long >( std::floor( (point1.y + fraction * (point2.y - point1.y) - aGrid.y) / aGrid.cellSize));
+					if (column >= 0 && row >= 0 && column < static_cast< long >( aGrid.columns) && row < static_cast< long >( aGrid.rows))
+					{
+						distances[static_cast< std::size_t >( row) * aGrid.columns + static_cast< std::size_t >( column)] = 0;
+					}
+				}
+			}
+
+			auto relax = [&distances, &aGrid](	std::size_t anIndex,
+												long aColumn,
+												long aRow,
+												std::uint32_t aWeight)
+			{
+				if (aColumn >= 0 && aRow >= 0 && aColumn < static_cast< long >( aGrid.columns) && aRow < static_cast< long >( aGrid.rows))
+				{
+					std::uint32_t distance = distances[static_cast< std::size_t >( aRow) * aGrid.columns + static_cast< std::size_t >( aColumn)] + aWeight;
+					distances[anIndex] = std::min( distances[anIndex], distance);
+				}
+			};
+			for (long row = 0; row < static_cast< long >( aGrid.rows); ++row)
+			{
+				for (long column = 0; column < static_cast< long >( aGrid.columns); ++column)
+				{
+					std::size_t index = static_cast< std::size_t >( row) * aGrid.columns + static_cast< std::size_t >( column);
+					relax( index, column - 1, row, 3);
+					relax( index, column - 1, row - 1, 4);
+					relax( index, column, row - 1, 3);
+					relax( index, column + 1, row - 1, 4);
+				}
+			}
+			for (long row = static_cast< long >( aGrid.rows) - 1; row >= 0; --row)
+			{
+				for (long column = static_cast< long >( aGrid.columns) - 1; column >= 0; --column)
+				{
+					std::size_t index = static_cast< std::size_t >( row) * aGrid.columns + static_cast< std::size_t >( column);
+					relax( index, column + 1, row, 3);
+					relax( index, column + 1, row + 1, 4);
+					relax( index, column, row + 1, 3);
+					relax( index, column - 1, row + 1, 4);
+				}
+			}
+
+			std::vector< std::uint16_t > clearance( distances.size());
+			for (std::size_t i = 0; i < distances.size(); ++i)
+			{
+				// The chamfer distance is 3 per cell
+				std::uint64_t pixels = static_cast< std::uint64_t >( distances[i]) * aGrid.cellSize / 3;
+				clearance[i] = static_cast< std::uint16_t >( std::min( pixels, static_cast< std::uint64_t >( WorldFile::maxClearance)));
+			}
+			return clearance;
+		}
+	} // namespace
+
+	/**
+	 *
+	 */
+	WorldFile::WorldFile( const std::string& aFileName) :
+								file( aFileName.c_str(), boost::interprocess::read_only),
+								region( file, boost::interprocess::read_only),
+								data( static_cast< const unsigned char* >( region.get_address())),
+								size( region.get_size()),
+								header( reinterpret_cast< const Header* >( data))
+	{
+		if (size < sizeof(Header) || std::memcmp( header->magic, magic, sizeof(magic)) != 0)
+		{
+			throw std::runtime_error( aFileName + " is not a world file");
+		}
+		if (header->version != version)
+		{
+			throw std::runtime_error( aFileName + " has an unsupported world file version");
+		}
+		if (!isValidSection( header->robotOffset, static_cast< std::uint64_t >( header->robotCount) * sizeof(NamedPointRecord), size)
+		        || !isValidSection( header->wayPointOffset, static_cast< std::uint64_t >( header->wayPointCount) * sizeof(NamedPointRecord), size)
+		        || !isValidSection( header->goalOffset, static_cast< std::uint64_t >( header->goalCount) * sizeof(NamedPointRecord), size)
+		        || !isValidSection( header->wallOffset, static_cast< std::uint64_t >( header->wallCount) * sizeof(WallRecord), size)
+		        || !isValidSection( header->nameOffset, header->nameSize, size, 1))
+		{
+			throw std::runtime_error( aFileName + " has an invalid section");
+		}
+		// The names are checked once so apply cannot fail halfway
+		auto isValidName = [this](const NamedPointRecord& aRecord)
+		{
+			return static_cast< std::uint64_t >( aRecord.nameOffset) + aRecord.nameLength <= header->nameSize;
+		};
+		if (!std::all_of( getRobots(), getRobots() + header->robotCount, isValidName)
+		        || !std::all_of( getWayPoints(), getWayPoints() + header->wayPointCount, isValidName)
+		        || !std::all_of( getGoals(), getGoals() + header->goalCount, isValidName))
+		{
+			throw std::runtime_error( aFileName + " has a name outside the names section");
+		}
+		if (hasClearanceGrid())
+		{
+			if (!isValidSection( header->clearanceOffset, sizeof(ClearanceGrid), size))
+			{
+				throw std::runtime_error( aFileName + " has an invalid clearance grid");
+			}
+			const ClearanceGrid& grid = *getSection< ClearanceGrid >( header->clearanceOffset);
+			std::uint64_t gridSize = static_cast< std::uint64_t >( grid.columns) * grid.rows * sizeof(std::uint16_t);
+			if (grid.cellSize == 0 || !isValidSection( header->clearanceOffset + sizeof(ClearanceGrid), gridSize, size))
+			{
+				throw std::runtime_error( aFileName + " has an invalid clearance grid");
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	std::string WorldFile::getName( const NamedPointRecord& aRecord) const
+	{
+		return std::string( reinterpret_cast< const char* >( data + header->nameOffset + aRecord.nameOffset), aRecord.nameLength);
+	}
+	/**
+	 *
+	 */
+	std::uint16_t WorldFile::getClearance( const wxPoint& aPoint) const
+	{
+		if (!hasClearanceGrid())
+		{
+			return maxClearance;
+		}
+		const ClearanceGrid& grid = *getSection< ClearanceGrid >( header->clearanceOffset);
+		long column = static_cast< long >( std::floor( static_cast< double >( aPoint.x - grid.x) / grid.cellSize));
+		long row = static_cast< long >( std::floor( static_cast< double >( aPoint.y - grid.y) / grid.cellSize));
+		if (column < 0 || row < 0 || column >= static_cast< long >( grid.columns) || row >= static_cast< long >( grid.rows))
+		{
+			return maxClearance;
+		}
+		const std::uint16_t* clearance = getSection< std::uint16_t >( header->clearanceOffset + sizeof(ClearanceGrid));
+		return clearance[static_cast< std::size_t >( row) * grid.columns + static_cast< std::size_t >( column)];
+	}
+	/**
+	 *
+	 */
+	void WorldFile::apply( bool aNotifyObservers /*= true*/) const
+	{
+		RobotPtr localRobot = RobotWorld::getRobotWorld().getLocalRobot();
+
+		WorldBuilder worldBuilder;
+		worldBuilder.reserve( header->robotCount, header->wayPointCount, header->goalCount, header->wallCount);
+
+		const NamedPointRecord* robots = getRobots();
+		for (std::uint32_t i = 0; i < header->robotCount; ++i)
+		{
+			std::string name = getName( robots[i]);
+			if (name == localRobot->getName())
+			{
+				worldBuilder.moveRobot( localRobot, wxPoint( robots[i].x, robots[i].y));
+			} else
+			{
+				worldBuilder.addRobot( name, wxPoint( robots[i].x, robots[i].y));
+			}
+		}
+		const NamedPointRecord* wayPoints = getWayPoints();
+		for (std::uint32_t i = 0; i < header->wayPointCount; ++i)
+		{
+			worldBuilder.addWayPoint( getName( wayPoints[i]), wxPoint( wayPoints[i].x, wayPoints[i].y));
+		}
+		const NamedPointRecord* goals = getGoals();
+		for (std::uint32_t i = 0; i < header->goalCount; ++i)
+		{
+			worldBuilder.addGoal( getName( goals[i]), wxPoint( goals[i].x, goals[i].y));
+		}
+		const WallRecord* walls = getWalls();
+		for (std::uint32_t i = 0; i < header->wallCount; ++i)
+		{
+			worldBuilder.addWall( wxPoint( walls[i].x1, walls[i].y1), wxPoint( walls[i].x2, walls[i].y2));
+		}
+
+		worldBuilder.replace( std::vector< Base::ObjectId >{ localRobot->getObjectId()}, aNotifyObservers);
+	}
+	/**
+	 *
+	 */
+	/* static */bool WorldFile::isWorldFile( const std::string& aFileName)
+	{
+		char fileMagic[sizeof(magic)] = {};
+		std::ifstream stream( aFileName, std::ios::binary);
+		stream.read( fileMagic, sizeof(fileMagic));
+		return stream && std::memcmp( fileMagic, magic, sizeof(magic)) == 0;
+	}
+	/**
+	 *
+	 */
+	/* static */void WorldFile::load(	const std::string& aFileName,
+										bool aNotifyObservers /*= true*/)
+	{
+		WorldFile worldFile( aFileName);
+		worldFile.apply( aNotifyObservers);
+	}
+	/**
+	 *
+	 */
+	/* static */void WorldFile::save(	const std::string& aFileName,
+										unsigned int aClearanceCellSize /*= 0*/)
+	{
+		WorldSnapshotPtr world = RobotWorld::getRobotWorld().getSnapshot();
+
+		Header header{};
+		std::memcpy( header.magic, magic, sizeof(magic));
+		header.version = version;
+		header.robotCount = static_cast< std::uint32_t >( world->robots->size());
+		header.wayPointCount = static_cast< std::uint32_t >( world->wayPoints->size());
+		header.goalCount = static_cast< std::uint32_t >( world->goals->size());
+		header.wallCount = static_cast< std::uint32_t >( world->walls->size());
+
+		std::string buffer( sizeof(Header), '\0');
+		std::string names;
+
+		header.robotOffset = buffer.size();
+		for (const RobotPtr& robot : *world->robots)
+		{
+			appendNamedPoints( buffer, names, robot->getName(), robot->getPosition());
+		}
+		header.wayPointOffset = buffer.size();
+		for (const WayPointPtr& wayPoint : *world->wayPoints)
+		{
+			appendNamedPoints( buffer, names, wayPoint->getName(), wayPoint->getPosition());
+		}
+		header.goalOffset = buffer.size();
+		for (const GoalPtr& goal : *world->goals)
+		{
+			appendNamedPoints( buffer, names, goal->getName(), goal->getPosition());
+		}
+		header.wallOffset = buffer.size();
+		for (const WallPtr& wall : *world->walls)
+		{
+			append( buffer, WallRecord{ wall->getPoint1().x, wall->getPoint1().y, wall->getPoint2().x, wall->getPoint2().y});
+		}
+		header.nameOffset = buffer.size();
+		header.nameSize = names.size();
+		buffer.append( names);
+		buffer.resize( alignSection( buffer.size()), '\0');
+
+		if (aClearanceCellSize > 0 && !world->walls->empty())
+		{
+			wxPoint topLeft = (*world->walls)[0]->getPoint1();
+			wxPoint bottomRight = topLeft;
+			for (const WallPtr& wall : *world->walls)
+			{
+				for (const wxPoint& point : { wall->getPoint1(), wall->getPoint2()})
+				{
+					topLeft = wxPoint( std::min( topLeft.x, point.x), std::min( topLeft.y, point.y));
+					bottomRight = wxPoint( std::max( bottomRight.x, point.x), std::max( bottomRight.y, point.y));
+				}
+			}
+			// One cell of margin around the walls
+			int cellSize = static_cast< int >( aClearanceCellSize);
+			ClearanceGrid grid{ topLeft.x - cellSize, topLeft.y - cellSize, aClearanceCellSize,
+			                    static_cast< std::uint32_t >( (bottomRight.x - topLeft.x) / cellSize + 3),
+			                    static_cast< std::uint32_t >( (bottomRight.y - topLeft.y) / cellSize + 3), 0};
+			std::vector< std::uint16_t > clearance = computeClearance( *world->walls, grid);
+
+			header.clearanceOffset = buffer.size();
+			append( buffer, grid);
+			buffer.append( reinterpret_cast< const char* >( clearance.data()), clearance.size() * sizeof(std::uint16_t));
+			buffer.resize( alignSection( buffer.size()), '\0');
+		}
+
+		std::memcpy( &buffer[0], &header, sizeof(Header));
+
+		std::ofstream stream( aFileName, std::ios::binary | std::ios::trunc);
+		stream.write( buffer.data(), static_cast< std::streamsize >( buffer.size()));
+		if (!stream)
+		{
+			throw std::runtime_error( "Could not write world file " + aFileName);
+		}
+	}
+} // namespace Model
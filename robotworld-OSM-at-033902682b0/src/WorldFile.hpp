@@ -0,0 +1,215 @@
+#ifndef WORLDFILE_HPP_
+#define WORLDFILE_HPP_
+
+#include "Config.hpp"
+
+#include "Widgets.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace Model
+{
+	/**
+	 * A world in a versioned binary file that is memory-mapped when it is opened.
+	 *
+	 * The file starts with a fixed size header followed by the sections the header points to:
+	 *
+	 *		header		: "RWWF" version robotCount wayPointCount goalCount wallCount
+	 *					  robotOffset wayPointOffset goalOffset wallOffset nameOffset nameSize clearanceOffset
+	 *		robots		: robotCount NamedPointRecord
+	 *		wayPoints	: wayPointCount NamedPointRecord
+	 *		goals		: goalCount NamedPointRecord
+	 *		walls		: wallCount WallRecord
+	 *		names		: nameSize bytes, the names of the robots, waypoints and goals without terminators
+	 *		clearance	: ClearanceGrid { columns * rows 16 bit clearances }, only if clearanceOffset is not 0
+	 *
+	 * All sections are 8 byte aligned and the records are stored in the native (little endian) byte order, so the
+	 * arrays are used in place without parsing. A file that was written with another byte order has an unknown
+	 * version.
+	 *
+	 * The clearance grid holds for every cell the approximate distance in pixels from the centre of the cell to the
+	 * nearest wall, 0 for cells a wall runs through.
+	 */
+	class WorldFile
+	{
+		public:
+			/**
+			 *
+			 */
+			struct Header
+			{
+					char magic[4];
+					std::uint32_t version;
+					std::uint32_t robotCount;
+					std::uint32_t wayPointCount;
+					std::uint32_t goalCount;
+					std::uint32_t wallCount;
+					std::uint64_t robotOffset;
+					std::uint64_t wayPointOffset;
+					std::uint64_t goalOffset;
+					std::uint64_t wallOffset;
+					std::uint64_t nameOffset;
+					std::uint64_t nameSize;
+					std::uint64_t clearanceOffset;
+			};
+			/**
+			 * A robot, waypoint or goal, the name is at nameOffset in the names section
+			 */
+			struct NamedPointRecord
+			{
+					std::int32_t x;
+					std::int32_t y;
+					std::uint32_t nameOffset;
+					std::uint32_t nameLength;
+			};
+			/**
+			 *
+			 */
+			struct WallRecord
+			{
+					std::int32_t x1;
+					std::int32_t y1;
+					std::int32_t x2;
+					std::int32_t y2;
+			};
+			/**
+			 * The grid covers the rectangle of columns * cellSize by rows * cellSize pixels at (x, y)
+			 */
+			struct ClearanceGrid
+			{
+					std::int32_t x;
+					std::int32_t y;
+					std::uint32_t cellSize;
+					std::uint32_t columns;
+					std::uint32_t rows;
+					std::uint32_t reserved;
+			};
+
+			static_assert( sizeof(Header) == 80 && std::is_standard_layout< Header >::value, "Unexpected layout of WorldFile::Header");
+			static_assert( sizeof(NamedPointRecord) == 16 && sizeof(WallRecord) == 16 && sizeof(ClearanceGrid) == 24, "Unexpected layout of the WorldFile records");
+
+			static const std::uint32_t version = 1;
+			/**
+			 * The clearance of a cell that is not covered by the grid or that is further away from the walls than can be stored
+			 */
+			static const std::uint16_t maxClearance = 0xFFFF;
+			/**
+			 * Maps and validates the file
+			 *
+			 * @throw std::runtime_error if the file is not a valid world file
+			 */
+			explicit WorldFile( const std::string& aFileName);
+			/**
+			 *
+			 */
+			WorldFile( const WorldFile&) = delete;
+			/**
+			 *
+			 */
+			WorldFile& operator=( const WorldFile&) = delete;
+			/**
+			 *
+			 */
+			~WorldFile() = default;
+			/**
+			 *
+			 */
+			const Header& getHeader() const
+			{
+				return *header;
+			}
+			/**
+			 *
+			 */
+			const NamedPointRecord* getRobots() const
+			{
+				return getSection< NamedPointRecord >( header->robotOffset);
+			}
+			/**
+			 *
+			 */
+			const NamedPointRecord* getWayPoints() const
+			{
+				return getSection< NamedPointRecord >( header->wayPointOffset);
+			}
+			/**
+			 *
+			 */
+			const NamedPointRecord* getGoals() const
+			{
+				return getSection< NamedPointRecord >( header->goalOffset);
+			}
+			/**
+			 *
+			 */
+			const WallRecord* getWalls() const
+			{
+				return getSection< WallRecord >( header->wallOffset);
+			}
+			/**
+			 *
+			 */
+			std::string getName( const NamedPointRecord& aRecord) const;
+			/**
+			 *
+			 */
+			bool hasClearanceGrid() const
+			{
+				return header->clearanceOffset != 0;
+			}
+			/**
+			 *
+			 * @return the clearance of the cell that contains aPoint or maxClearance if there is no grid or the grid does not contain aPoint
+			 */
+			std::uint16_t getClearance( const wxPoint& aPoint) const;
+			/**
+			 * Replaces the objects of RobotWorld with the objects in the file. The local robot is kept and moved to the
+			 * position of the robot with the same name if the file has one. Readers see the old world until the new
+			 * one is complete.
+			 */
+			void apply( bool aNotifyObservers = true) const;
+			/**
+			 *
+			 * @return true if aFileName starts with the magic of a world file
+			 */
+			static bool isWorldFile( const std::string& aFileName);
+			/**
+			 * Opens aFileName and applies it to RobotWorld
+			 */
+			static void load(	const std::string& aFileName,
+								bool aNotifyObservers = true);
+			/**
+			 * Writes the current snapshot of RobotWorld to aFileName
+			 *
+			 * @param aClearanceCellSize The cell size of the clearance grid in pixels, no grid is written if it is 0
+			 * @throw std::runtime_error if the file could not be written
+			 */
+			static void save(	const std::string& aFileName,
+								unsigned int aClearanceCellSize = 0);
+
+		private:
+			/**
+			 *
+			 */
+			template< typename T >
+			const T* getSection( std::uint64_t anOffset) const
+			{
+				return reinterpret_cast< const T* >( data + anOffset);
+			}
+
+			boost::interprocess::file_mapping file;
+			boost::interprocess::mapped_region region;
+			const unsigned char* data;
+			std::size_t size;
+			const Header* header;
+	};
+	//	class WorldFile
+} // namespace Model
+
+#endif // WORLDFILE_HPP_
@@ -0,0 +1,425 @@
+#include "WorldTextFile.hpp"
+
+#include "Goal.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Wall.hpp"
+#include "WayPoint.hpp"
+#include "WorldBuilder.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Model
+{
+	namespace
+	{
+		/**
+		 * The size of the read and write buffers, a line must fit in it
+		 */
+		const std::size_t bufferSize = 64 * 1024;
+		/**
+		 * Closes the file descriptor when it goes out of scope
+		 */
+		class FileDescriptor
+		{
+			public:
+				FileDescriptor(	const std::string& aFileName,
+								int aFlags) :
+									fileDescriptor( ::open( aFileName.c_str(), aFlags, 0644))
+				{
+					if (fileDescriptor < 0)
+					{
+						throw std::runtime_error( "Could not open " + aFileName + ": " + std::strerror( errno));
+					}
+				}
+				~FileDescriptor()
+				{
+					::close( fileDescriptor);
+				}
+				FileDescriptor( const FileDescriptor&) = delete;
+				FileDescriptor& operator=( const FileDescriptor&) = delete;
+
+				int get() const
+				{
+					return fileDescriptor;
+				}
+
+			private:
+				int fileDescriptor;
+		};
+		/**
+		 * Parses the fields of one line in place
+		 */
+		class LineParser
+		{
+			public:
+				LineParser(	const char* aBegin,
+							const char* anEnd,
+							unsigned long aLineNumber) :
+								current( aBegin),
+								end( anEnd),
+								lineNumber( aLineNumber)
+				{
+					// Lines written on Windows
+					if (end != current && *(end - 1) == '\r')
+					{
+						--end;
+					}
+				}
+				/**
+				 *
+				 * @return the next word, empty at the end of the line
+				 */
+				std::pair< const char*, std::size_t > getWord()
+				{
+					skipSpaces();
+					const char* begin = current;
+					while (current != end && *current != ' ' && *current != '\t')
+					{
+						++current;
+					}
+					return std::make_pair( begin, static_cast< std::size_t >( current - begin));
+				}
+				/**
+				 *
+				 */
+				int getNumber()
+				{
+					skipSpaces();
+					int number = 0;
+					std::from_chars_result result = std::from_chars( current, end, number);
+					if (result.ec != std::errc() || (result.ptr != end && *result.ptr != ' ' && *result.ptr != '\t'))
+					{
+						fail( "a number was expected");
+					}
+					current = result.ptr;
+					return number;
+				}
+				/**
+				 *
+				 */
+				wxPoint getPoint()
+				{
+					int x = getNumber();
+					int y = getNumber();
+					return wxPoint( x, y);
+				}
+				/**
+				 *
+				 * @return the rest of the line without the surrounding spaces
+				 */
+				std::string getName()
+				{
+					skipSpaces();
+					const char* last = end;
+					while (last != current && (*(last - 1) == ' ' || *(last - 1) == '\t'))
+					{
+						--last;
+					}
+					if (last == current)
+					{
+						fail( "a name was expected");
+					}
+					std::string name( current, static_cast< std::size_t >( last - current));
+					current = end;
+					return name;
+				}
+				/**
+				 *
+				 */
+				void expectEnd()
+				{
+					skipSpaces();
+					if (current != end)
+					{
+						fail( "unexpected text at the end of the line");
+					}
+				}
+				/**
+				 *
+				 */
+				[[noreturn]] void fail( const std::string& aMessage) const
+				{
+					throw std::runtime_error( "Line " + std::to_string( lineNumber) + ": " + aMessage);
+				}
+
+			private:
+				void skipSpaces()
+				{
+					while (current != end && (*current == ' ' || *current == '\t'))
+					{
+						++current;
+					}
+				}
+
+				const char* current;
+				const char* end;
+				unsigned long lineNumber;
+		};
+		/**
+		 * Formats the lines into a fixed size buffer that is written to the file descriptor whenever it is full
+		 */
+		class LineWriter
+		{
+			public:
+				explicit LineWriter( int aFileDescriptor) :
+								fileDescriptor( aFileDescriptor),
+								buffer( bufferSize),
+								size( 0)
+				{
+				}
+				/**
+				 *
+				 */
+				LineWriter& operator<<( const char* aText)
+				{
+					append( aText, std::strlen( aText));
+					return *this;
+				}
+				/**
+				 *
+				 */
+				LineWriter& operator<<( const std::string& aText)
+				{
+					append( aText.data(), aText.size());
+					return *this;
+				}
+				/**
+				 *
+				 */
+				LineWriter& operator<<( int aNumber)
+				{
+					// Room for the longest int
+					if (buffer.size() - size < 16)
+					{
+						flush();
+					}
+					std::to_chars_result result = std::to_chars( buffer.data() + size, buffer.data() + buffer.size(), aNumber);
+					size = static_cast< std::size_t >( result.ptr - buffer.data());
+					return *this;
+				}
+				/**
+				 *
+				 */
+				LineWriter& operator<<( const wxPoint& aPoint)
+				{
+					return *this << aPoint.x << " " << aPoint.y;
+				}
+				/**
+				 *
+				 */
+				void flush()
+				{
+					const char* data = buffer.data();
+					while (size > 0)
+					{
+						ssize_t written = ::write( fileDescriptor, data, size);
+						if (written < 0)
+						{
+							if (errno == EINTR)
+							{
+								continue;
+							}
+							throw std::runtime_error( std::string( "Could not write the world: ") + std::strerror( errno));
+						}
+						data += written;
+						size -= static_cast< std::size_t >( written);
+					}
+				}
+
+			private:
+				void append(	const char* aText,
+								std::size_t aLength)
+				{
+					while (aLength > 0)
+					{
+						if (size == buffer.size())
+						{
+							flush();
+						}
+						std::size_t length = std::min( aLength, buffer.size() - size);
+						std::memcpy( buffer.data() + size, aText, length);
+						size += length;
+						aText += length;
+						aLength -= length;
+					}
+				}
+
+				int fileDescriptor;
+				std::vector< char > buffer;
+				std::size_t size;
+		};
+		/**
+		 *
+		 */
+		bool isWord(	const std::pair< const char*, std::size_t >& aWord,
+						const char* aKeyword)
+		{
+			return aWord.second == std::strlen( aKeyword) && std::memcmp( aWord.first, aKeyword, aWord.second) == 0;
+		}
+	} // namespace
+
+	/**
+	 *
+	 */
+	/* static */void WorldTextFile::read(	int aFileDescriptor,
+											WorldBuilder& aWorldBuilder,
+											const RobotPtr& aLocalRobot /*= nullptr*/)
+	{
+		std::vector< char > buffer( bufferSize);
+		std::size_t size = 0;
+		unsigned long lineNumber = 0;
+		bool endOfFile = false;
+		bool localRobotFound = false;
+		wxPoint localRobotPosition;
+
+		auto parseLine = [&](	const char* aBegin,
+								const char* anEnd)
+		{
+			LineParser parser( aBegin, anEnd, ++lineNumber);
+			std::pair< const char*, std::size_t > keyword = parser.getWord();
+			if (keyword.second == 0 || *keyword.first == '#')
+			{
+				return;
+			}
+			if (isWord( keyword, "wall"))
+			{
+				wxPoint point1 = parser.getPoint();
+				wxPoint point2 = parser.getPoint();
+				parser.expectEnd();
+				aWorldBuilder.addWall( point1, point2);
+			} else if (isWord( keyword, "robot"))
+			{
+				wxPoint position = parser.getPoint();
+				std::string name = parser.getName();
+				if (aLocalRobot && name == aLocalRobot->getName())
+				{
+					localRobotFound = true;
+					localRobotPosition = position;
+				} else
+				{
+					aWorldBuilder.addRobot( name, position);
+				}
+			} else if (isWord( keyword, "waypoint"))
+			{
+				wxPoint position = parser.getPoint();
+				aWorldBuilder.addWayPoint( parser.getName(), position);
+			} else if (isWord( keyword, "goal"))
+			{
+				wxPoint position = parser.getPoint();
+				aWorldBuilder.addGoal( parser.getName(), position);
+			} else
+			{
+				parser.fail( "unknown object " + std::string( keyword.first, keyword.second));
+			}
+		};
+
+		while (!endOfFile)
+		{
+			ssize_t bytesRead = ::read( aFileDescriptor, buffer.data() + size, buffer.size() - size);
+			if (bytesRead < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				throw std::runtime_error( std::string( "Could not read the world: ") + std::strerror( errno));
+			}
+			endOfFile = bytesRead == 0;
+			size += static_cast< std::size_t >( bytesRead);
+
+			// Parse the complete lines and move the incomplete last line to the front of the buffer
+			const char* begin = buffer.data();
+			const char* end = buffer.data() + size;
+			for (const char* newLine = std::find( begin, end, '\n'); newLine != end; newLine = std::find( begin, end, '\n'))
+			{
+				parseLine( begin, newLine);
+				begin = newLine + 1;
+			}
+			if (endOfFile && begin != end)
+			{
+				// The last line does not end with a new line
+				parseLine( begin, end);
+				begin = end;
+			}
+			size = static_cast< std::size_t >( end - begin);
+			if (size == buffer.size())
+			{
+				throw std::runtime_error( "Line " + std::to_string( lineNumber + 1) + ": the line is too long");
+			}
+			std::memmove( buffer.data(), begin, size);
+		}
+
+		if (localRobotFound)
+		{
+			aWorldBuilder.moveRobot( aLocalRobot, localRobotPosition);
+		}
+	}
+	/**
+	 *
+	 */
+	/* static */void WorldTextFile::write( int aFileDescriptor)
+	{
+		WorldSnapshotPtr world = RobotWorld::getRobotWorld().getSnapshot();
+
+		LineWriter writer( aFileDescriptor);
+		writer << "# RobotWorld\n";
+		for (const RobotPtr& robot : *world->robots)
+		{
+			writer << "robot " << robot->getPosition() << " " << robot->getName() << "\n";
+		}
+		for (const WayPointPtr& wayPoint : *world->wayPoints)
+		{
+			writer << "waypoint " << wayPoint->getPosition() << " " << wayPoint->getName() << "\n";
+		}
+		for (const GoalPtr& goal : *world->goals)
+		{
+			writer << "goal " << goal->getPosition() << " " << goal->getName() << "\n";
+		}
+		for (const WallPtr& wall : *world->walls)
+		{
+			writer << "wall " << wall->getPoint1() << " " << wall->getPoint2() << "\n";
+		}
+		writer.flush();
+	}
+	/**
+	 *
+	 */
+	/* static */void WorldTextFile::load(	const std::string& aFileName,
+											bool aNotifyObservers /*= true*/)
+	{
+		RobotPtr localRobot = RobotWorld::getRobotWorld().getLocalRobot();
+
+		WorldBuilder worldBuilder;
+		{
+			FileDescriptor file( aFileName, O_RDONLY);
+			try
+			{
+				read( file.get(), worldBuilder, localRobot);
+			}
+			catch (std::runtime_error& e)
+			{
+				throw std::runtime_error( aFileName + ": " + e.what());
+			}
+		}
+
+		worldBuilder.replace( std::vector< Base::ObjectId >{ localRobot->getObjectId()}, aNotifyObservers);
+	}
+	/**
+	 *
+	 */
+	/* static */void WorldTextFile::save( const std::string& aFileName)
+	{
+		FileDescriptor file( aFileName, O_WRONLY | O_CREAT | O_TRUNC);
+		write( file.get());
+	}
+} // namespace Model
@@ -0,0 +1,65 @@
+#ifndef WORLDTEXTFILE_HPP_
+#define WORLDTEXTFILE_HPP_
+
+#include "Config.hpp"
+
+#include <memory>
+#include <string>
+
+namespace Model
+{
+	class Robot;
+	typedef std::shared_ptr<Robot> RobotPtr;
+
+	class WorldBuilder;
+
+	/**
+	 * A human-editable world in a text file with one object per line:
+	 *
+	 *		robot x y name
+	 *		waypoint x y name
+	 *		goal x y name
+	 *		wall x1 y1 x2 y2
+	 *
+	 * The name is the rest of the line. Empty lines and lines that start with '#' are ignored.
+	 *
+	 * The file is read and written through a fixed size buffer so the memory that is used does not depend on the
+	 * size of the world: the reader parses the lines in the buffer in place and feeds the objects to a WorldBuilder,
+	 * the writer formats the objects of a snapshot into the buffer and writes it whenever it is full.
+	 */
+	class WorldTextFile
+	{
+		public:
+			/**
+			 * Reads the objects from aFileDescriptor until the end of the file and adds them to aWorldBuilder. A robot
+			 * with the name of aLocalRobot is not added, aWorldBuilder moves aLocalRobot to its position at commit.
+			 *
+			 * @throw std::runtime_error if a line is invalid or the file could not be read
+			 */
+			static void read(	int aFileDescriptor,
+								WorldBuilder& aWorldBuilder,
+								const RobotPtr& aLocalRobot = nullptr);
+			/**
+			 * Writes the current snapshot of RobotWorld to aFileDescriptor
+			 *
+			 * @throw std::runtime_error if the file could not be written
+			 */
+			static void write( int aFileDescriptor);
+			/**
+			 * Replaces the objects of RobotWorld with the objects in aFileName in a single change. The local robot is
+			 * kept. RobotWorld is not changed if the file is invalid.
+			 *
+			 * @throw std::runtime_error if the file could not be read or is invalid
+			 */
+			static void load(	const std::string& aFileName,
+								bool aNotifyObservers = true);
+			/**
+			 *
+			 * @throw std::runtime_error if the file could not be written
+			 */
+			static void save( const std::string& aFileName);
+	};
+	//	class WorldTextFile
+} // namespace Model
+
+#endif // WORLDTEXTFILE_HPP_
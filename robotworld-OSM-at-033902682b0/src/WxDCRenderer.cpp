@@ -0,0 +1,116 @@
+#include "WxDCRenderer.hpp"
+
+#include <algorithm>
+
+namespace View
+{
+	/**
+	 *
+	 */
+	WxDCRenderer::WxDCRenderer( wxDC& aDC) :
+								dc( aDC)
+	{
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::setPen(	const Colour& aColour,
+								int aWidth)
+	{
+		dc.SetPen( wxPen( toWxColour( aColour), aWidth, wxPENSTYLE_SOLID));
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::setBrush( const Colour& aColour)
+	{
+		dc.SetBrush( wxBrush( toWxColour( aColour)));
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::drawPoint( const wxPoint& aPoint)
+	{
+		dc.DrawPoint( aPoint);
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::drawLine(	const wxPoint& aBegin,
+									const wxPoint& anEnd)
+	{
+		dc.DrawLine( aBegin, anEnd);
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::drawLines(	std::size_t aNumberOfPoints,
+									const wxPoint aPoints[])
+	{
+		// A wxDC draws nothing for a single point
+		if (aNumberOfPoints == 1)
+		{
+			dc.DrawPoint( aPoints[0]);
+		} else
+		{
+			dc.DrawLines( static_cast< int >( aNumberOfPoints), aPoints);
+		}
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::drawPolygon(	std::size_t aNumberOfPoints,
+									const wxPoint aPoints[])
+	{
+		dc.DrawPolygon( static_cast< int >( aNumberOfPoints), aPoints);
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::drawRectangle( const wxRect& aRectangle)
+	{
+		dc.DrawRectangle( aRectangle.x, aRectangle.y, aRectangle.width, aRectangle.height);
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::drawCircle(	const wxPoint& aCentre,
+									int aRadius)
+	{
+		dc.DrawCircle( aCentre, aRadius);
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::drawText(	const std::string& aText,
+									const wxPoint& aTopLeft)
+	{
+		dc.DrawText( aText, aTopLeft.x, aTopLeft.y);
+	}
+	/**
+	 *
+	 */
+	void WxDCRenderer::drawRotatedText(	const std::string& aText,
+										const wxPoint& aTopLeft,
+										double anAngle)
+	{
+		dc.DrawRotatedText( aText, aTopLeft.x, aTopLeft.y, anAngle);
+	}
+	/**
+	 *
+	 */
+	wxSize WxDCRenderer::getTextExtent( const std::string& aText) const
+	{
+		return dc.GetTextExtent( aText);
+	}
+	/**
+	 *
+	 */
+	double WxDCRenderer::getScale() const
+	{
+		double scaleX = 1.0;
+		double scaleY = 1.0;
+		dc.GetUserScale( &scaleX, &scaleY);
+		return std::min( scaleX, scaleY);
+	}
+} // namespace View
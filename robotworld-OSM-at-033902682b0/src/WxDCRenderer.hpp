@@ -0,0 +1,108 @@
+#ifndef WXDCRENDERER_HPP_
+#define WXDCRENDERER_HPP_
+
+#include "Config.hpp"
+
+#include "Renderer.hpp"
+#include "Widgets.hpp"
+
+namespace View
+{
+	/**
+	 * Draws on a wxDC, i.e. on the screen or in a wxBitmap
+	 */
+	class WxDCRenderer : public Renderer
+	{
+		public:
+			/**
+			 *
+			 */
+			explicit WxDCRenderer( wxDC& aDC);
+			/**
+			 *
+			 */
+			virtual ~WxDCRenderer() = default;
+			/**
+			 * For the shapes that draw something the Renderer has no command for
+			 */
+			wxDC& getDC() const
+			{
+				return dc;
+			}
+			/**
+			 * @name Renderer functions
+			 */
+			//@{
+			/**
+			 *
+			 */
+			virtual void setPen(	const Colour& aColour,
+									int aWidth) override;
+			/**
+			 *
+			 */
+			virtual void setBrush( const Colour& aColour) override;
+			/**
+			 *
+			 */
+			virtual void drawPoint( const wxPoint& aPoint) override;
+			/**
+			 *
+			 */
+			virtual void drawLine(	const wxPoint& aBegin,
+									const wxPoint& anEnd) override;
+			/**
+			 *
+			 */
+			virtual void drawLines(	std::size_t aNumberOfPoints,
+									const wxPoint aPoints[]) override;
+			/**
+			 *
+			 */
+			virtual void drawPolygon(	std::size_t aNumberOfPoints,
+										const wxPoint aPoints[]) override;
+			/**
+			 *
+			 */
+			virtual void drawRectangle( const wxRect& aRectangle) override;
+			/**
+			 *
+			 */
+			virtual void drawCircle(	const wxPoint& aCentre,
+										int aRadius) override;
+			/**
+			 *
+			 */
+			virtual void drawText(	const std::string& aText,
+									const wxPoint& aTopLeft) override;
+			/**
+			 *
+			 */
+			virtual void drawRotatedText(	const std::string& aText,
+											const wxPoint& aTopLeft,
+											double anAngle) override;
+			/**
+			 *
+			 */
+			virtual wxSize getTextExtent( const std::string& aText) const override;
+			/**
+			 * The smallest of the horizontal and the vertical user scale of the wxDC
+			 */
+			virtual double getScale() const override;
+			//@}
+
+			/**
+			 *
+			 */
+			static wxColour toWxColour( const Colour& aColour)
+			{
+				return wxColour( aColour.red, aColour.green, aColour.blue);
+			}
+
+		private:
+			wxDC& dc;
+	};
+	//	class WxDCRenderer
+} // namespace View
+
+#endif // WXDCRENDERER_HPP_
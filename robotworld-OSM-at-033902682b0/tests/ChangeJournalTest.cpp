@@ -0,0 +1,168 @@
+#include "Config.hpp"
+
+#include "ChangeJournal.hpp"
+#include "Goal.hpp"
+#include "RobotWorld.hpp"
+#include "WayPoint.hpp"
+#include "WorldFixture.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( ChangeJournalTest)
+
+BOOST_AUTO_TEST_CASE( RecordInOrder)
+{
+	Model::ChangeJournal journal( 8);
+	BOOST_CHECK_EQUAL( journal.getLastSequence(), 0U);
+
+	Base::ObjectId robot = Base::ObjectId::newObjectId();
+	Base::ObjectId wall = Base::ObjectId::newObjectId();
+	BOOST_CHECK_EQUAL( journal.record( Model::Change::EntityAdded, Model::Change::RobotEntity, robot), 1U);
+	BOOST_CHECK_EQUAL( journal.record( Model::Change::EntityAdded, Model::Change::WallEntity, wall), 2U);
+	BOOST_CHECK_EQUAL( journal.record( Model::Change::EntityRemoved, Model::Change::WallEntity, wall), 3U);
+	BOOST_CHECK_EQUAL( journal.getLastSequence(), 3U);
+
+	std::vector< Model::Change > changes;
+	BOOST_REQUIRE( journal.getChangesSince( 0, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 3U);
+	BOOST_CHECK( changes[0].type == Model::Change::EntityAdded && changes[0].entity == Model::Change::RobotEntity && changes[0].objectId == robot);
+	BOOST_CHECK( changes[2].type == Model::Change::EntityRemoved && changes[2].entity == Model::Change::WallEntity && changes[2].objectId == wall);
+
+	changes.clear();
+	BOOST_REQUIRE( journal.getChangesSince( 2, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 1U);
+	BOOST_CHECK_EQUAL( changes[0].sequence, 3U);
+
+	changes.clear();
+	BOOST_REQUIRE( journal.getChangesSince( 3, changes));
+	BOOST_CHECK( changes.empty());
+}
+
+BOOST_AUTO_TEST_CASE( MergeMoves)
+{
+	Model::ChangeJournal journal( 8);
+	Base::ObjectId robot1 = Base::ObjectId::newObjectId();
+	Base::ObjectId robot2 = Base::ObjectId::newObjectId();
+
+	journal.record( Model::Change::EntityAdded, Model::Change::RobotEntity, robot1);
+	journal.record( Model::Change::EntityMoved, Model::Change::RobotEntity, robot1);
+	journal.record( Model::Change::EntityMoved, Model::Change::RobotEntity, robot2);
+	std::uint64_t lastMove = journal.record( Model::Change::EntityMoved, Model::Change::RobotEntity, robot1);
+	BOOST_CHECK_EQUAL( lastMove, 4U);
+
+	// The two moves of robot1 are one change with the sequence number of the last move, at the back
+	std::vector< Model::Change > changes;
+	BOOST_REQUIRE( journal.getChangesSince( 0, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 3U);
+	BOOST_CHECK( changes[0].type == Model::Change::EntityAdded);
+	BOOST_CHECK( changes[1].objectId == robot2 && changes[1].sequence == 3U);
+	BOOST_CHECK( changes[2].objectId == robot1 && changes[2].sequence == 4U);
+
+	// An observer that saw the first move sees the merged move again
+	changes.clear();
+	BOOST_REQUIRE( journal.getChangesSince( 2, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 2U);
+	BOOST_CHECK( changes[1].objectId == robot1);
+
+	changes.clear();
+	BOOST_REQUIRE( journal.getChangesSince( 3, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 1U);
+	BOOST_CHECK( changes[0].objectId == robot1);
+}
+
+BOOST_AUTO_TEST_CASE( NoMergeAcrossRemoval)
+{
+	Model::ChangeJournal journal( 8);
+	Base::ObjectId robot = Base::ObjectId::newObjectId();
+
+	journal.record( Model::Change::EntityMoved, Model::Change::RobotEntity, robot);
+	journal.record( Model::Change::EntityRemoved, Model::Change::RobotEntity, robot);
+	journal.record( Model::Change::EntityAdded, Model::Change::RobotEntity, robot);
+	journal.record( Model::Change::EntityMoved, Model::Change::RobotEntity, robot);
+
+	std::vector< Model::Change > changes;
+	BOOST_REQUIRE( journal.getChangesSince( 0, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 4U);
+	BOOST_CHECK( changes[0].type == Model::Change::EntityMoved);
+	BOOST_CHECK( changes[1].type == Model::Change::EntityRemoved);
+	BOOST_CHECK( changes[2].type == Model::Change::EntityAdded);
+	BOOST_CHECK( changes[3].type == Model::Change::EntityMoved);
+}
+
+BOOST_AUTO_TEST_CASE( Overflow)
+{
+	Model::ChangeJournal journal( 4);
+	for (int i = 0; i < 6; ++i)
+	{
+		journal.record( Model::Change::EntityAdded, Model::Change::WallEntity, Base::ObjectId::newObjectId());
+	}
+	BOOST_CHECK_EQUAL( journal.getLastSequence(), 6U);
+
+	// Changes 1 and 2 were dropped
+	std::vector< Model::Change > changes( 1);
+	BOOST_CHECK( !journal.getChangesSince( 0, changes));
+	BOOST_CHECK( !journal.getChangesSince( 1, changes));
+	BOOST_CHECK_EQUAL( changes.size(), 1U);
+
+	changes.clear();
+	BOOST_REQUIRE( journal.getChangesSince( 2, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 4U);
+	BOOST_CHECK_EQUAL( changes.front().sequence, 3U);
+	BOOST_CHECK_EQUAL( changes.back().sequence, 6U);
+}
+
+BOOST_AUTO_TEST_CASE( MovesDoNotOverflow)
+{
+	Model::ChangeJournal journal( 4);
+	Base::ObjectId robot = Base::ObjectId::newObjectId();
+	Base::ObjectId wall = Base::ObjectId::newObjectId();
+	journal.record( Model::Change::EntityAdded, Model::Change::WallEntity, wall);
+	for (int i = 0; i < 100; ++i)
+	{
+		journal.record( Model::Change::EntityMoved, Model::Change::RobotEntity, robot);
+	}
+
+	std::vector< Model::Change > changes;
+	BOOST_REQUIRE( journal.getChangesSince( 0, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 2U);
+	BOOST_CHECK( changes[0].objectId == wall);
+	BOOST_CHECK( changes[1].objectId == robot && changes[1].sequence == 101U);
+}
+
+BOOST_AUTO_TEST_CASE( OverflowDropsMergedMove)
+{
+	Model::ChangeJournal journal( 2);
+	Base::ObjectId robot = Base::ObjectId::newObjectId();
+	journal.record( Model::Change::EntityMoved, Model::Change::RobotEntity, robot);
+	journal.record( Model::Change::EntityAdded, Model::Change::WallEntity, Base::ObjectId::newObjectId());
+	journal.record( Model::Change::EntityAdded, Model::Change::WallEntity, Base::ObjectId::newObjectId());
+
+	// The dropped move can not be merged with, the next move is a new change
+	journal.record( Model::Change::EntityMoved, Model::Change::RobotEntity, robot);
+	std::vector< Model::Change > changes;
+	BOOST_CHECK( !journal.getChangesSince( 1, changes));
+	BOOST_REQUIRE( journal.getChangesSince( 2, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 2U);
+	BOOST_CHECK( changes[1].objectId == robot && changes[1].sequence == 4U);
+}
+
+BOOST_FIXTURE_TEST_CASE( RecordGoalEntity, WorldFixture)
+{
+	Model::WayPointPtr wayPoint = robotWorld.newWayPoint( "WayPoint", wxPoint( 10, 10), false);
+	Model::GoalPtr goal = robotWorld.newGoal( "Goal", wxPoint( 20, 20), false);
+
+	std::uint64_t sequence = robotWorld.getChangeJournal().getLastSequence();
+	wayPoint->setPosition( wxPoint( 30, 30), false);
+	goal->setPosition( wxPoint( 40, 40), false);
+
+	std::vector< Model::Change > changes;
+	BOOST_REQUIRE( robotWorld.getChangeJournal().getChangesSince( sequence, changes));
+	BOOST_REQUIRE_EQUAL( changes.size(), 2U);
+	BOOST_CHECK( changes[0].objectId == wayPoint->getObjectId() && changes[0].entity == Model::Change::WayPointEntity);
+	BOOST_CHECK( changes[1].objectId == goal->getObjectId() && changes[1].entity == Model::Change::GoalEntity);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
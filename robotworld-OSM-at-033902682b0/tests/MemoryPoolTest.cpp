@@ -0,0 +1,70 @@
+#include "Config.hpp"
+
+#include "MemoryPool.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( MemoryPoolTest)
+
+BOOST_AUTO_TEST_CASE( FreedBlocksAreReused)
+{
+	Base::MemoryPool pool( 24, 8);
+	void* first = pool.allocate();
+	void* second = pool.allocate();
+	void* third = pool.allocate();
+	BOOST_CHECK_EQUAL( pool.getNumberOfBlocks(), 3U);
+
+	// Last freed, first reused
+	pool.deallocate( second);
+	pool.deallocate( first);
+	BOOST_CHECK_EQUAL( pool.getNumberOfBlocks(), 1U);
+	BOOST_CHECK( pool.allocate() == first);
+	BOOST_CHECK( pool.allocate() == second);
+
+	pool.deallocate( first);
+	pool.deallocate( second);
+	pool.deallocate( third);
+	BOOST_CHECK_EQUAL( pool.getNumberOfBlocks(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE( EmptyPoolStartsAgain)
+{
+	Base::MemoryPool pool( 16, 8);
+	std::vector< void* > blocks;
+	for (std::size_t i = 0; i < Base::MemoryPool::blocksPerSlab + 1; ++i)
+	{
+		blocks.push_back( pool.allocate());
+	}
+	BOOST_CHECK_EQUAL( pool.getNumberOfSlabs(), 2U);
+
+	// Blocks of one population are next to each other
+	BOOST_CHECK_EQUAL( static_cast< unsigned char* >( blocks[1]) - static_cast< unsigned char* >( blocks[0]), 16);
+	BOOST_CHECK_EQUAL( std::set< void* >( blocks.begin(), blocks.end()).size(), blocks.size());
+
+	for (void* block : blocks)
+	{
+		pool.deallocate( block);
+	}
+	// The slabs are kept and the next population starts at the first block
+	BOOST_CHECK( pool.allocate() == blocks[0]);
+	BOOST_CHECK( pool.allocate() == blocks[1]);
+	BOOST_CHECK_EQUAL( pool.getNumberOfSlabs(), 2U);
+}
+
+BOOST_AUTO_TEST_CASE( Alignment)
+{
+	Base::MemoryPool pool( 3, 4);
+	void* first = pool.allocate();
+	void* second = pool.allocate();
+	BOOST_CHECK_EQUAL( reinterpret_cast< std::uintptr_t >( second) % alignof(void*), 0U);
+	BOOST_CHECK_GE( static_cast< unsigned char* >( second) - static_cast< unsigned char* >( first), static_cast< std::ptrdiff_t >( sizeof(void*)));
+	pool.deallocate( first);
+	pool.deallocate( second);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
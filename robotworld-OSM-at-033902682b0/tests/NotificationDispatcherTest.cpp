@@ -0,0 +1,134 @@
+#include "Config.hpp"
+
+#include "NotificationDispatcher.hpp"
+#include "Notifier.hpp"
+#include "Observer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+	/**
+	 * Counts the deliveries and collects their topics
+	 */
+	struct CountingObserver : public Base::Observer
+	{
+			virtual void handleNotification( const Base::Notification& aNotification) override
+			{
+				topics |= aNotification.getTopics();
+				++deliveries;
+			}
+			/**
+			 *
+			 * @return true if there were aDeliveries deliveries within a few seconds
+			 */
+			bool waitFor( int aDeliveries) const
+			{
+				for (int i = 0; i < 500 && deliveries < aDeliveries; ++i)
+				{
+					std::this_thread::sleep_for( std::chrono::milliseconds( 10));
+				}
+				return deliveries == aDeliveries;
+			}
+
+			std::atomic< int > deliveries{ 0};
+			std::atomic< Base::Notification::TopicMask > topics{ Base::Notification::NoTopics};
+	};
+
+	/**
+	 * Runs the dispatcher at 4 deliveries per second, so the notifications after a delivery are coalesced for 250 ms
+	 */
+	struct NotificationDispatcherFixture
+	{
+			NotificationDispatcherFixture()
+			{
+				Base::NotificationDispatcher::getNotificationDispatcher().start( 4);
+			}
+			~NotificationDispatcherFixture()
+			{
+				Base::NotificationDispatcher::getNotificationDispatcher().stop();
+				notifier.removeAllObservers();
+			}
+
+			Base::Notifier notifier;
+			CountingObserver observer;
+	};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE( NotificationDispatcherTest, NotificationDispatcherFixture)
+
+BOOST_AUTO_TEST_CASE( Coalescing)
+{
+	notifier.addObserver( observer);
+	notifier.notifyObservers( 1);
+	BOOST_REQUIRE( observer.waitFor( 1));
+
+	// The next delivery is at least 250 ms after the first one
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		notifier.notifyObservers( 1U << (i % 4));
+	}
+	BOOST_REQUIRE( observer.waitFor( 2));
+	BOOST_CHECK_EQUAL( observer.topics.load(), 15U);
+}
+
+BOOST_AUTO_TEST_CASE( SubscribedTopicsOnly)
+{
+	notifier.addObserver( observer, 2);
+	notifier.notifyObservers( 1);
+	notifier.notifyObservers( 6);
+	Base::NotificationDispatcher::getNotificationDispatcher().stop();
+	BOOST_CHECK_EQUAL( observer.deliveries.load(), 1);
+	BOOST_CHECK_EQUAL( observer.topics.load(), 2U);
+}
+
+BOOST_AUTO_TEST_CASE( RemoveCancels)
+{
+	notifier.addObserver( observer);
+	notifier.notifyObservers( 1);
+	BOOST_REQUIRE( observer.waitFor( 1));
+
+	// Still pending because of the rate when the observer is removed
+	notifier.notifyObservers( 2);
+	notifier.removeObserver( observer);
+	Base::NotificationDispatcher::getNotificationDispatcher().stop();
+	BOOST_CHECK_EQUAL( observer.deliveries.load(), 1);
+	BOOST_CHECK_EQUAL( observer.topics.load(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE( ReAddedObserverIsNotCancelled)
+{
+	notifier.addObserver( observer);
+	notifier.notifyObservers( 1);
+	BOOST_REQUIRE( observer.waitFor( 1));
+
+	notifier.notifyObservers( 2);
+	notifier.removeObserver( observer);
+	notifier.addObserver( observer);
+	notifier.notifyObservers( 4);
+	Base::NotificationDispatcher::getNotificationDispatcher().stop();
+	BOOST_CHECK_EQUAL( observer.deliveries.load(), 2);
+	BOOST_CHECK_EQUAL( observer.topics.load(), 5U);
+}
+
+BOOST_AUTO_TEST_CASE( StopDelivers)
+{
+	notifier.addObserver( observer);
+	notifier.notifyObservers( 1);
+	BOOST_REQUIRE( observer.waitFor( 1));
+
+	notifier.notifyObservers( 2);
+	Base::NotificationDispatcher::getNotificationDispatcher().stop();
+	BOOST_CHECK_EQUAL( observer.deliveries.load(), 2);
+
+	// Without the dispatcher the notifications are delivered synchronously
+	notifier.notifyObservers( 4);
+	BOOST_CHECK_EQUAL( observer.deliveries.load(), 3);
+	BOOST_CHECK_EQUAL( observer.topics.load(), 7U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,56 @@
+#include "Config.hpp"
+
+#include "ObjectId.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE( ObjectIdTest)
+
+BOOST_AUTO_TEST_CASE( StringRoundTrip)
+{
+	Base::ObjectId objectId = Base::ObjectId::newObjectId();
+	BOOST_CHECK( !objectId.isNull());
+	BOOST_CHECK( Base::ObjectId( objectId.toString()) == objectId);
+
+	// Both parts survive, including the highest bits of the counter
+	Base::ObjectId largest( 0xABCD000000000000ULL | 0xFFFFFFFFFFFFULL);
+	BOOST_CHECK_EQUAL( largest.toString(), "abcd-ffffffffffff");
+	BOOST_CHECK( Base::ObjectId( largest.toString()) == largest);
+	BOOST_CHECK_EQUAL( largest.getNamespace(), 0xABCDU);
+
+	Base::ObjectId other;
+	other.fromString( objectId.toString());
+	BOOST_CHECK( other == objectId);
+}
+
+BOOST_AUTO_TEST_CASE( NullObjectId)
+{
+	Base::ObjectId objectId;
+	BOOST_CHECK( objectId.isNull());
+	BOOST_CHECK_EQUAL( objectId.asString(), "");
+	BOOST_CHECK( Base::ObjectId( objectId.toString()) == objectId);
+}
+
+BOOST_AUTO_TEST_CASE( InvalidStrings)
+{
+	BOOST_CHECK_THROW( Base::ObjectId( ""), std::invalid_argument);
+	BOOST_CHECK_THROW( Base::ObjectId( "abcd"), std::invalid_argument);
+	BOOST_CHECK_THROW( Base::ObjectId( "abcd-12x"), std::invalid_argument);
+	BOOST_CHECK_THROW( Base::ObjectId( "abcd-000000000001 "), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( Namespace)
+{
+	Base::ObjectId::setObjectIdNamespace( "node");
+	Base::ObjectId objectId = Base::ObjectId::newObjectId();
+	Base::ObjectId::setObjectIdNamespace( "");
+
+	BOOST_CHECK_NE( objectId.getNamespace(), 0U);
+	BOOST_CHECK_EQUAL( Base::ObjectId::newObjectId().getNamespace(), 0U);
+	BOOST_CHECK( Base::ObjectId( objectId.toString()) == objectId);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,126 @@
+#include "Config.hpp"
+
+#include "Recorder.hpp"
+#include "Replay.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "WorldFixture.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <string>
+
+namespace
+{
+	/**
+	 * Records 10 ticks of two robots with a keyframe every 4 ticks. Robot 1 moves one pixel to the right per tick and
+	 * gets a path at tick 5, Robot 2 does not move.
+	 */
+	struct RecorderFixture : public WorldFixture
+	{
+			RecorderFixture() :
+								fileName( (std::filesystem::temp_directory_path() / "robotworld-test.rwr").string())
+			{
+				Model::RobotPtr robot1 = robotWorld.newRobot( "Robot 1", wxPoint( 10, 20), false);
+				Model::RobotPtr robot2 = robotWorld.newRobot( "Robot 2", wxPoint( 300, 400), false);
+
+				Model::Recorder& recorder = Model::Recorder::getRecorder();
+				recorder.open( fileName, 4);
+				for (int tick = 0; tick < 10; ++tick)
+				{
+					robot1->setPosition( wxPoint( 10 + tick, 20), false);
+					if (tick == 5)
+					{
+						robot1->setPath( PathAlgorithm::Path{ PathAlgorithm::Vertex( 15, 20), PathAlgorithm::Vertex( 16, 21)}, false);
+						recorder.recordPath( *robot1, false);
+					}
+					recorder.recordTick();
+				}
+				recorder.close();
+			}
+			~RecorderFixture()
+			{
+				Model::Replay::getReplay().close();
+				std::filesystem::remove( fileName);
+			}
+			/**
+			 *
+			 * @return the replayed state of the robot named aName
+			 */
+			const Model::Replay::RobotState* getState( const std::string& aName) const
+			{
+				for (const Model::Replay::RobotState& robotState : Model::Replay::getReplay().getRobotStates())
+				{
+					if (robotState.name == aName)
+					{
+						return &robotState;
+					}
+				}
+				return nullptr;
+			}
+
+			std::string fileName;
+	};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE( RecorderTest, RecorderFixture)
+
+BOOST_AUTO_TEST_CASE( RoundTrip)
+{
+	Model::Replay& replay = Model::Replay::getReplay();
+	replay.open( fileName);
+	BOOST_CHECK_EQUAL( replay.getTickCount(), 10U);
+
+	replay.seek( 0);
+	for (unsigned long tick = 0; tick < 10; ++tick)
+	{
+		BOOST_CHECK_EQUAL( replay.getTick(), tick);
+		BOOST_REQUIRE( getState( "Robot 1"));
+		BOOST_CHECK( getState( "Robot 1")->position == wxPoint( 10 + static_cast< int >( tick), 20));
+		BOOST_REQUIRE( getState( "Robot 2"));
+		BOOST_CHECK( getState( "Robot 2")->position == wxPoint( 300, 400));
+		BOOST_CHECK_EQUAL( replay.next(), tick < 9);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Seek)
+{
+	Model::Replay& replay = Model::Replay::getReplay();
+	replay.open( fileName);
+
+	// Between keyframes, backwards and past the end
+	replay.seek( 7);
+	BOOST_CHECK_EQUAL( replay.getTick(), 7U);
+	BOOST_REQUIRE( getState( "Robot 1"));
+	BOOST_CHECK( getState( "Robot 1")->position == wxPoint( 17, 20));
+
+	replay.seek( 2);
+	BOOST_CHECK_EQUAL( replay.getTick(), 2U);
+	BOOST_REQUIRE( getState( "Robot 1"));
+	BOOST_CHECK( getState( "Robot 1")->position == wxPoint( 12, 20));
+	BOOST_CHECK( getState( "Robot 1")->path.empty());
+
+	replay.seek( 100);
+	BOOST_CHECK_EQUAL( replay.getTick(), 9U);
+	BOOST_REQUIRE( getState( "Robot 1"));
+	BOOST_CHECK( getState( "Robot 1")->position == wxPoint( 19, 20));
+}
+
+BOOST_AUTO_TEST_CASE( SeekRestoresPath)
+{
+	Model::Replay& replay = Model::Replay::getReplay();
+	replay.open( fileName);
+
+	// Tick 8 is a keyframe after the path was recorded
+	for (unsigned long tick : { 5UL, 6UL, 8UL, 9UL})
+	{
+		replay.seek( tick);
+		BOOST_REQUIRE( getState( "Robot 1"));
+		const PathAlgorithm::Path& path = getState( "Robot 1")->path;
+		BOOST_REQUIRE_EQUAL( path.size(), 2U);
+		BOOST_CHECK( path[1].asPoint() == wxPoint( 16, 21));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
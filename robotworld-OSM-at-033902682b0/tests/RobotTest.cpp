@@ -0,0 +1,71 @@
+#include "Config.hpp"
+
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Wall.hpp"
+#include "WorldFixture.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	/**
+	 * A 20 x 20 robot at (50, 50) with a straight path to the right, one vertex per pixel
+	 */
+	struct RobotFixture : public WorldFixture
+	{
+			RobotFixture() :
+								robot( robotWorld.newRobot( "Robot", wxPoint( 50, 50), false))
+			{
+				robot->setSize( wxSize( 20, 20), false);
+				robot->setFront( Model::BoundedVector( 1.0, 0.0), false);
+				PathAlgorithm::Path path;
+				for (int x = 50; x <= 250; ++x)
+				{
+					path.push_back( PathAlgorithm::Vertex( x, 50));
+				}
+				robot->beginDriving();
+				robot->setPath( path, false);
+				robot->prepareDriving();
+			}
+
+			Model::RobotPtr robot;
+	};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE( RobotTest, RobotFixture)
+
+BOOST_AUTO_TEST_CASE( Step)
+{
+	robot->setSpeed( 10, false);
+	BOOST_CHECK( robot->step());
+	BOOST_CHECK( robot->getPosition() == wxPoint( 60, 50));
+	BOOST_CHECK( robot->getState().position == wxPoint( 60, 50));
+}
+
+BOOST_AUTO_TEST_CASE( NoTunnelling)
+{
+	// A single step of 100 vertices would jump over the thin wall
+	robotWorld.newWall( wxPoint( 100, 0), wxPoint( 100, 100), false);
+	robot->setSpeed( 100, false);
+
+	BOOST_CHECK( !robot->step());
+	BOOST_CHECK( !robot->isDriving());
+	// Time of impact: stopped at the last vertex before the contact
+	BOOST_CHECK_GT( robot->getPosition().x, 80);
+	BOOST_CHECK_LT( robot->getPosition().x, 100);
+	BOOST_CHECK( robot->getState().position == robot->getPosition());
+}
+
+BOOST_AUTO_TEST_CASE( ParallelPhases)
+{
+	// The read phase publishes nothing, the commit phase publishes the step
+	robot->setSpeed( 10, false);
+	BOOST_CHECK( !robot->readStep());
+	BOOST_CHECK( robot->getPosition() == wxPoint( 60, 50));
+	BOOST_CHECK( robot->getState().position == wxPoint( 50, 50));
+	BOOST_CHECK( robot->commitStep());
+	BOOST_CHECK( robot->getState().position == wxPoint( 60, 50));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
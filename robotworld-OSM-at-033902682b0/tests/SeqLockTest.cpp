@@ -0,0 +1,76 @@
+#include "Config.hpp"
+
+#include "SeqLock.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/**
+	 * Larger than a word, so a torn read would mix the words of different values
+	 */
+	struct Value
+	{
+			std::uint64_t first;
+			std::uint64_t second;
+			std::uint64_t third;
+	};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( SeqLockTest)
+
+BOOST_AUTO_TEST_CASE( StoreAndLoad)
+{
+	Base::SeqLock< Value > seqLock( Value{ 1, 2, 3});
+	BOOST_CHECK_EQUAL( seqLock.getVersion(), 1U);
+	BOOST_CHECK_EQUAL( seqLock.load().third, 3U);
+
+	seqLock.store( Value{ 4, 5, 6});
+	Value value = seqLock.load();
+	BOOST_CHECK_EQUAL( seqLock.getVersion(), 2U);
+	BOOST_CHECK( value.first == 4 && value.second == 5 && value.third == 6);
+}
+
+BOOST_AUTO_TEST_CASE( NoTornReads)
+{
+	Base::SeqLock< Value > seqLock( Value{ 0, 0, 0});
+	std::atomic< bool > writing{ true};
+	std::atomic< unsigned long > tornReads{ 0};
+
+	// Every stored value has three equal words
+	std::vector< std::thread > readers;
+	for (int i = 0; i < 3; ++i)
+	{
+		readers.push_back( std::thread( [&seqLock, &writing, &tornReads]
+		{
+			while (writing)
+			{
+				Value value = seqLock.load();
+				if (value.first != value.second || value.second != value.third)
+				{
+					++tornReads;
+				}
+			}
+		}));
+	}
+	for (std::uint64_t i = 1; i <= 100000; ++i)
+	{
+		seqLock.store( Value{ i, i, i});
+	}
+	writing = false;
+	for (std::thread& reader : readers)
+	{
+		reader.join();
+	}
+
+	BOOST_CHECK_EQUAL( tornReads.load(), 0U);
+	BOOST_CHECK_EQUAL( seqLock.load().third, 100000U);
+	BOOST_CHECK_EQUAL( seqLock.getVersion(), 100001U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
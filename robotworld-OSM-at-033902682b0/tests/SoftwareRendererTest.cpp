@@ -0,0 +1,127 @@
+#include "Config.hpp"
+
+#include "SoftwareRenderer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <climits>
+#include <cstddef>
+
+namespace
+{
+	/**
+	 * A 20 x 10 white image with a black pen of 1 pixel and a red brush
+	 */
+	struct SoftwareRendererFixture
+	{
+			SoftwareRendererFixture() :
+								renderer( 20, 10)
+			{
+				renderer.setPen( View::Colour( 0, 0, 0), 1);
+				renderer.setBrush( View::Colour( 255, 0, 0));
+			}
+			/**
+			 *
+			 * @return the red, green and blue of a pixel as 0xRRGGBB
+			 */
+			unsigned long getPixel(	int x,
+									int y) const
+			{
+				std::size_t offset = (static_cast< std::size_t >( y) * 20 + static_cast< std::size_t >( x)) * 3;
+				const std::vector< unsigned char >& pixels = renderer.getPixels();
+				return (static_cast< unsigned long >( pixels[offset]) << 16) | (static_cast< unsigned long >( pixels[offset + 1]) << 8) | pixels[offset + 2];
+			}
+			/**
+			 *
+			 * @return the number of pixels that are not white
+			 */
+			std::size_t countPainted() const
+			{
+				std::size_t painted = 0;
+				for (int y = 0; y < 10; ++y)
+				{
+					for (int x = 0; x < 20; ++x)
+					{
+						painted += getPixel( x, y) != 0xFFFFFF ? 1 : 0;
+					}
+				}
+				return painted;
+			}
+
+			View::SoftwareRenderer renderer;
+	};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE( SoftwareRendererTest, SoftwareRendererFixture)
+
+BOOST_AUTO_TEST_CASE( Line)
+{
+	renderer.drawLine( wxPoint( 2, 3), wxPoint( 6, 3));
+	BOOST_CHECK_EQUAL( countPainted(), 5U);
+	BOOST_CHECK_EQUAL( getPixel( 2, 3), 0x000000UL);
+	BOOST_CHECK_EQUAL( getPixel( 6, 3), 0x000000UL);
+	BOOST_CHECK_EQUAL( getPixel( 7, 3), 0xFFFFFFUL);
+
+	renderer.drawLine( wxPoint( 0, 0), wxPoint( 4, 4));
+	for (int i = 0; i <= 4; ++i)
+	{
+		BOOST_CHECK_EQUAL( getPixel( i, i), 0x000000UL);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( ClippedLines)
+{
+	// Far outside on both ends, without clipping these would walk billions of pixels and overflow the error term
+	renderer.drawLine( wxPoint( INT_MIN / 2, 5), wxPoint( INT_MAX / 2, 5));
+	BOOST_CHECK_EQUAL( countPainted(), 20U);
+	BOOST_CHECK_EQUAL( getPixel( 0, 5), 0x000000UL);
+	BOOST_CHECK_EQUAL( getPixel( 19, 5), 0x000000UL);
+
+	renderer.drawLine( wxPoint( -1000000000, -1000000000), wxPoint( 1000000000, 1000000000));
+	for (int i = 0; i < 10; ++i)
+	{
+		BOOST_CHECK_EQUAL( getPixel( i, i), 0x000000UL);
+	}
+	BOOST_CHECK_EQUAL( countPainted(), 29U);
+
+	// Completely outside
+	renderer.drawLine( wxPoint( -100, -100), wxPoint( 100, -50));
+	BOOST_CHECK_EQUAL( countPainted(), 29U);
+}
+
+BOOST_AUTO_TEST_CASE( Rectangle)
+{
+	renderer.drawRectangle( wxRect( 2, 2, 4, 3));
+	BOOST_CHECK_EQUAL( countPainted(), 12U);
+	BOOST_CHECK_EQUAL( getPixel( 2, 2), 0x000000UL);
+	BOOST_CHECK_EQUAL( getPixel( 5, 4), 0x000000UL);
+	BOOST_CHECK_EQUAL( getPixel( 3, 3), 0xFF0000UL);
+	BOOST_CHECK_EQUAL( getPixel( 6, 3), 0xFFFFFFUL);
+
+	// A huge rectangle only fills the image
+	renderer.drawRectangle( wxRect( -1000000, -1000000, 2000000, 2000000));
+	BOOST_CHECK_EQUAL( countPainted(), 200U);
+	BOOST_CHECK_EQUAL( getPixel( 10, 5), 0xFF0000UL);
+}
+
+BOOST_AUTO_TEST_CASE( Circle)
+{
+	renderer.drawCircle( wxPoint( 10, 5), 3);
+	BOOST_CHECK_EQUAL( getPixel( 10, 5), 0xFF0000UL);
+	BOOST_CHECK_EQUAL( getPixel( 13, 5), 0x000000UL);
+	BOOST_CHECK_EQUAL( getPixel( 10, 2), 0x000000UL);
+	BOOST_CHECK_EQUAL( getPixel( 14, 5), 0xFFFFFFUL);
+
+	// Culled, the bounding box misses the image
+	std::size_t painted = countPainted();
+	renderer.drawCircle( wxPoint( 100, 100), 50);
+	renderer.drawCircle( wxPoint( -10, 5), 8);
+	BOOST_CHECK_EQUAL( countPainted(), painted);
+
+	// Partly visible
+	renderer.drawCircle( wxPoint( -2, 5), 3);
+	BOOST_CHECK_EQUAL( getPixel( 0, 5), 0xFF0000UL);
+	BOOST_CHECK_EQUAL( getPixel( 1, 5), 0x000000UL);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
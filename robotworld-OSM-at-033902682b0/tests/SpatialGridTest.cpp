@@ -0,0 +1,111 @@
+#include "Config.hpp"
+
+#include "SpatialGrid.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( SpatialGridTest)
+
+BOOST_AUTO_TEST_CASE( InsertAndQuery)
+{
+	Utils::SpatialGrid< int > grid( 10);
+	grid.insert( 1, wxRect( 0, 0, 5, 5));
+	grid.insert( 2, wxRect( 25, 25, 10, 10));
+	BOOST_CHECK_EQUAL( grid.getSize(), 2U);
+
+	BOOST_CHECK( grid.query( wxRect( 1, 1, 2, 2)) == std::vector< int >{ 1});
+	BOOST_CHECK( grid.query( wxRect( 30, 30, 1, 1)) == std::vector< int >{ 2});
+	BOOST_CHECK( grid.query( wxRect( 0, 0, 40, 40)) == (std::vector< int >{ 1, 2}));
+	BOOST_CHECK( grid.query( wxRect( 100, 100, 10, 10)).empty());
+}
+
+BOOST_AUTO_TEST_CASE( QueryIsCellGranular)
+{
+	// The query returns the keys of the overlapped cells, the caller does the exact test
+	Utils::SpatialGrid< int > grid( 10);
+	grid.insert( 1, wxRect( 0, 0, 2, 2));
+	BOOST_CHECK( grid.query( wxRect( 8, 8, 1, 1)) == std::vector< int >{ 1});
+	// The right and bottom edges are exclusive
+	BOOST_CHECK( grid.query( wxRect( 10, 0, 5, 5)).empty());
+	grid.insert( 2, wxRect( 0, 0, 10, 10));
+	BOOST_CHECK( grid.query( wxRect( 10, 10, 5, 5)).empty());
+}
+
+BOOST_AUTO_TEST_CASE( KeysSpanningCellsAreReturnedOnce)
+{
+	Utils::SpatialGrid< int > grid( 10);
+	grid.insert( 1, wxRect( 0, 0, 100, 100));
+	std::vector< int > result{ 7};
+	grid.query( wxRect( 0, 0, 100, 100), result);
+	BOOST_CHECK( result == (std::vector< int >{ 7, 1}));
+}
+
+BOOST_AUTO_TEST_CASE( NegativeCoordinates)
+{
+	Utils::SpatialGrid< int > grid( 10);
+	grid.insert( 1, wxRect( -5, -5, 2, 2));
+	grid.insert( 2, wxRect( 0, 0, 2, 2));
+	BOOST_CHECK( grid.query( wxRect( -10, -10, 5, 5)) == std::vector< int >{ 1});
+	BOOST_CHECK( grid.query( wxRect( 0, 0, 5, 5)) == std::vector< int >{ 2});
+	BOOST_CHECK( grid.query( wxRect( -1, -1, 2, 2)) == (std::vector< int >{ 1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE( Move)
+{
+	Utils::SpatialGrid< int > grid( 10);
+	wxRect oldBoundingBox( 0, 0, 5, 5);
+	wxRect newBoundingBox( 50, 50, 15, 15);
+	grid.insert( 1, oldBoundingBox);
+
+	BOOST_CHECK( grid.move( 1, oldBoundingBox, newBoundingBox));
+	BOOST_CHECK_EQUAL( grid.getSize(), 1U);
+	BOOST_CHECK( grid.query( oldBoundingBox).empty());
+	BOOST_CHECK( grid.query( wxRect( 60, 60, 1, 1)) == std::vector< int >{ 1});
+
+	// A key that is not in the grid is not added by a move
+	BOOST_CHECK( !grid.move( 2, oldBoundingBox, newBoundingBox));
+	BOOST_CHECK_EQUAL( grid.getSize(), 1U);
+	BOOST_CHECK( grid.query( newBoundingBox) == std::vector< int >{ 1});
+}
+
+BOOST_AUTO_TEST_CASE( RemoveAndClear)
+{
+	Utils::SpatialGrid< int > grid( 10);
+	grid.insert( 1, wxRect( 0, 0, 30, 30));
+	grid.insert( 2, wxRect( 0, 0, 30, 30));
+
+	BOOST_CHECK( grid.remove( 1, wxRect( 0, 0, 30, 30)));
+	BOOST_CHECK( !grid.remove( 1, wxRect( 0, 0, 30, 30)));
+	BOOST_CHECK_EQUAL( grid.getSize(), 1U);
+	BOOST_CHECK( grid.query( wxRect( 0, 0, 30, 30)) == std::vector< int >{ 2});
+
+	grid.clear();
+	BOOST_CHECK_EQUAL( grid.getSize(), 0U);
+	BOOST_CHECK( grid.query( wxRect( 0, 0, 30, 30)).empty());
+}
+
+BOOST_AUTO_TEST_CASE( CopiesAreIndependent)
+{
+	Utils::SpatialGrid< int > grid( 10);
+	grid.insert( 1, wxRect( 0, 0, 5, 5));
+	grid.insert( 2, wxRect( 500, 500, 5, 5));
+
+	const Utils::SpatialGrid< int > copy( grid);
+	grid.move( 1, wxRect( 0, 0, 5, 5), wxRect( 20, 20, 5, 5));
+	grid.remove( 2, wxRect( 500, 500, 5, 5));
+	grid.insert( 3, wxRect( 0, 0, 5, 5));
+
+	BOOST_CHECK_EQUAL( copy.getSize(), 2U);
+	BOOST_CHECK( copy.query( wxRect( 0, 0, 5, 5)) == std::vector< int >{ 1});
+	BOOST_CHECK( copy.query( wxRect( 20, 20, 5, 5)).empty());
+	BOOST_CHECK( copy.query( wxRect( 500, 500, 5, 5)) == std::vector< int >{ 2});
+
+	BOOST_CHECK_EQUAL( grid.getSize(), 2U);
+	BOOST_CHECK( grid.query( wxRect( 0, 0, 5, 5)) == std::vector< int >{ 3});
+	BOOST_CHECK( grid.query( wxRect( 20, 20, 5, 5)) == std::vector< int >{ 1});
+	BOOST_CHECK( grid.query( wxRect( 500, 500, 5, 5)).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
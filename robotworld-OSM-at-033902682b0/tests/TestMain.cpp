@@ -0,0 +1,7 @@
+#include "Config.hpp"
+
+// \file
+// The unit tests of RobotWorld, the other files of this directory only add their test suites
+
+#define BOOST_TEST_MODULE RobotWorld
+#include <boost/test/included/unit_test.hpp>
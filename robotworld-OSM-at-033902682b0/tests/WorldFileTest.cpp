@@ -0,0 +1,189 @@
+#include "Config.hpp"
+
+#include "Goal.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Wall.hpp"
+#include "WayPoint.hpp"
+#include "WorldFile.hpp"
+#include "WorldFixture.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	/**
+	 * Saves a small world to a temporary file and empties the world again when the test ends
+	 */
+	struct WorldFileFixture : public WorldFixture
+	{
+			WorldFileFixture() :
+								fileName( (std::filesystem::temp_directory_path() / "robotworld-test.rww").string())
+			{
+				robotWorld.newRobot( "Robot", wxPoint( 10, 20), false);
+				robotWorld.newWayPoint( "WayPoint", wxPoint( 30, 40), false);
+				robotWorld.newGoal( "Goal", wxPoint( 50, 60), false);
+				robotWorld.newWall( wxPoint( 0, 0), wxPoint( 100, 0), false);
+				robotWorld.newWall( wxPoint( 100, 0), wxPoint( 100, 100), false);
+				Model::WorldFile::save( fileName, 10);
+			}
+			~WorldFileFixture()
+			{
+				std::filesystem::remove( fileName);
+			}
+			/**
+			 *
+			 */
+			Model::WorldFile::Header readHeader() const
+			{
+				Model::WorldFile::Header header{};
+				std::ifstream stream( fileName, std::ios::binary);
+				stream.read( reinterpret_cast< char* >( &header), sizeof(header));
+				return header;
+			}
+			/**
+			 *
+			 */
+			void writeHeader( const Model::WorldFile::Header& aHeader) const
+			{
+				std::fstream stream( fileName, std::ios::binary | std::ios::in | std::ios::out);
+				stream.write( reinterpret_cast< const char* >( &aHeader), sizeof(aHeader));
+			}
+
+			std::string fileName;
+	};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE( WorldFileTest, WorldFileFixture)
+
+BOOST_AUTO_TEST_CASE( RoundTrip)
+{
+	BOOST_REQUIRE( Model::WorldFile::isWorldFile( fileName));
+
+	robotWorld.unpopulate( false);
+	Model::WorldFile::load( fileName, false);
+
+	Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
+	Model::RobotPtr robot = world->getRobot( "Robot");
+	BOOST_REQUIRE( robot);
+	BOOST_CHECK( robot->getPosition() == wxPoint( 10, 20));
+	Model::WayPointPtr wayPoint = world->getWayPoint( "WayPoint");
+	BOOST_REQUIRE( wayPoint);
+	BOOST_CHECK( wayPoint->getPosition() == wxPoint( 30, 40));
+	Model::GoalPtr goal = world->getGoal( "Goal");
+	BOOST_REQUIRE( goal);
+	BOOST_CHECK( goal->getPosition() == wxPoint( 50, 60));
+	BOOST_REQUIRE_EQUAL( world->walls->size(), 2U);
+	BOOST_CHECK( (*world->walls)[0]->getPoint1() == wxPoint( 0, 0));
+	BOOST_CHECK( (*world->walls)[1]->getPoint2() == wxPoint( 100, 100));
+}
+
+BOOST_AUTO_TEST_CASE( LoadIsOneVersion)
+{
+	// Loading over the populated world replaces it without an empty version in between
+	Model::WorldSnapshotPtr before = robotWorld.getSnapshot();
+	Model::WorldFile::load( fileName, false);
+
+	Model::WorldSnapshotPtr after = robotWorld.getSnapshot();
+	BOOST_CHECK_EQUAL( after->version, before->version + 1);
+	BOOST_CHECK_EQUAL( after->walls->size(), 2U);
+	BOOST_CHECK( after->getRobot( "Robot"));
+	BOOST_CHECK( after->getRobot( "Robot") != before->getRobot( "Robot"));
+}
+
+BOOST_AUTO_TEST_CASE( ClearanceGrid)
+{
+	Model::WorldFile worldFile( fileName);
+	BOOST_REQUIRE( worldFile.hasClearanceGrid());
+	BOOST_CHECK_EQUAL( worldFile.getClearance( wxPoint( 50, 0)), 0);
+	BOOST_CHECK_GT( worldFile.getClearance( wxPoint( 50, 50)), 0);
+	BOOST_CHECK_EQUAL( worldFile.getClearance( wxPoint( 10000, 10000)), static_cast< std::uint16_t >( Model::WorldFile::maxClearance));
+}
+
+BOOST_AUTO_TEST_CASE( TruncatedHeader)
+{
+	std::filesystem::resize_file( fileName, sizeof(Model::WorldFile::Header) - 1);
+	BOOST_CHECK_THROW( Model::WorldFile worldFile( fileName), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( TruncatedSections)
+{
+	Model::WorldFile::Header header = readHeader();
+	std::filesystem::resize_file( fileName, header.wallOffset + sizeof(Model::WorldFile::WallRecord));
+	BOOST_CHECK_THROW( Model::WorldFile worldFile( fileName), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( EmptyFile)
+{
+	std::filesystem::resize_file( fileName, 0);
+	BOOST_CHECK( !Model::WorldFile::isWorldFile( fileName));
+	BOOST_CHECK_THROW( Model::WorldFile worldFile( fileName), std::exception);
+}
+
+BOOST_AUTO_TEST_CASE( CorruptMagic)
+{
+	Model::WorldFile::Header header = readHeader();
+	header.magic[0] = 'X';
+	writeHeader( header);
+	BOOST_CHECK( !Model::WorldFile::isWorldFile( fileName));
+	BOOST_CHECK_THROW( Model::WorldFile worldFile( fileName), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( UnsupportedVersion)
+{
+	Model::WorldFile::Header header = readHeader();
+	header.version = Model::WorldFile::version + 1;
+	writeHeader( header);
+	BOOST_CHECK_THROW( Model::WorldFile worldFile( fileName), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( CorruptCounts)
+{
+	Model::WorldFile::Header header = readHeader();
+	header.wallCount = 0xFFFFFFFF;
+	writeHeader( header);
+	BOOST_CHECK_THROW( Model::WorldFile worldFile( fileName), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( CorruptOffsets)
+{
+	const Model::WorldFile::Header original = readHeader();
+
+	Model::WorldFile::Header header = original;
+	header.robotOffset += 1;
+	writeHeader( header);
+	BOOST_CHECK_THROW( Model::WorldFile worldFile( fileName), std::runtime_error);
+
+	header = original;
+	header.nameSize = 0;
+	writeHeader( header);
+	BOOST_CHECK_THROW( Model::WorldFile worldFile( fileName), std::runtime_error);
+
+	header = original;
+	header.clearanceOffset = std::filesystem::file_size( fileName);
+	writeHeader( header);
+	BOOST_CHECK_THROW( Model::WorldFile worldFile( fileName), std::runtime_error);
+
+	writeHeader( original);
+	BOOST_CHECK_NO_THROW( Model::WorldFile worldFile( fileName));
+}
+
+BOOST_AUTO_TEST_CASE( InvalidFileKeepsWorld)
+{
+	Model::WorldFile::Header header = readHeader();
+	header.version = 0;
+	writeHeader( header);
+
+	std::size_t numberOfWalls = robotWorld.getSnapshot()->walls->size();
+	BOOST_CHECK_THROW( Model::WorldFile::load( fileName, false), std::runtime_error);
+	BOOST_CHECK_EQUAL( robotWorld.getSnapshot()->walls->size(), numberOfWalls);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,29 @@
+#ifndef WORLDFIXTURE_HPP_
+#define WORLDFIXTURE_HPP_
+
+#include "Config.hpp"
+
+#include "RobotWorld.hpp"
+
+/**
+ * Starts a test with an empty RobotWorld and empties it again when the test ends
+ */
+struct WorldFixture
+{
+		WorldFixture() :
+							robotWorld( Model::RobotWorld::getRobotWorld())
+		{
+			// The application always has a local robot, unpopulate moves it out of the way
+			robotWorld.getLocalRobot();
+			robotWorld.unpopulate( false);
+		}
+		~WorldFixture()
+		{
+			robotWorld.unpopulate( false);
+		}
+
+		Model::RobotWorld& robotWorld;
+};
+//	struct WorldFixture
+
+#endif // WORLDFIXTURE_HPP_
@@ -0,0 +1,79 @@
+#include "Config.hpp"
+
+#include "RobotWorld.hpp"
+#include "Wall.hpp"
+#include "WorldFixture.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE( WorldSnapshotTest, WorldFixture)
+
+BOOST_AUTO_TEST_CASE( SnapshotIsImmutable)
+{
+	Model::WorldSnapshotPtr before = robotWorld.getSnapshot();
+	Model::WallPtr wall = robotWorld.newWall( wxPoint( 0, 0), wxPoint( 100, 0), false);
+	Model::WorldSnapshotPtr after = robotWorld.getSnapshot();
+
+	BOOST_CHECK_GT( after->version, before->version);
+	BOOST_CHECK( before->walls->empty());
+	BOOST_CHECK( before->getWalls( wxRect( 0, -10, 200, 20)).empty());
+	BOOST_REQUIRE_EQUAL( after->walls->size(), 1U);
+	BOOST_CHECK( after->getWall( wall->getObjectId()) == wall);
+
+	// Only the walls changed, the other vectors are shared
+	BOOST_CHECK( after->robots == before->robots);
+	BOOST_CHECK( after->goals == before->goals);
+
+	// Without changes there is no new version
+	BOOST_CHECK( robotWorld.getSnapshot() == after);
+}
+
+BOOST_AUTO_TEST_CASE( WallMoveSharesWalls)
+{
+	Model::WallPtr wall = robotWorld.newWall( wxPoint( 0, 0), wxPoint( 100, 0), false);
+	Model::WorldSnapshotPtr before = robotWorld.getSnapshot();
+	wall->setPoint2( wxPoint( 0, 1000), false);
+	Model::WorldSnapshotPtr after = robotWorld.getSnapshot();
+
+	BOOST_CHECK( after->walls == before->walls);
+	BOOST_CHECK( after->wallIndex != before->wallIndex);
+	BOOST_CHECK( before->wallIndex->query( wxRect( 0, 500, 10, 10)).empty());
+	BOOST_CHECK_EQUAL( after->getWalls( wxRect( 0, 500, 10, 10)).size(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE( Batch)
+{
+	Model::WorldSnapshotPtr before = robotWorld.getSnapshot();
+	{
+		Model::RobotWorld::Batch batch( robotWorld);
+		robotWorld.newWall( wxPoint( 0, 0), wxPoint( 100, 0), false);
+		robotWorld.newGoal( "Goal", wxPoint( 10, 10), false);
+		BOOST_CHECK( robotWorld.getSnapshot() == before);
+	}
+	Model::WorldSnapshotPtr after = robotWorld.getSnapshot();
+	BOOST_CHECK_EQUAL( after->version, before->version + 1);
+	BOOST_CHECK_EQUAL( after->walls->size(), 1U);
+	BOOST_CHECK( after->getGoal( "Goal"));
+}
+
+BOOST_AUTO_TEST_CASE( WallIndex)
+{
+	Model::WallPtr horizontal = robotWorld.newWall( wxPoint( 0, 0), wxPoint( 1000, 0), false);
+	Model::WallPtr vertical = robotWorld.newWall( wxPoint( 2000, 0), wxPoint( 2000, 1000), false);
+	Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
+
+	std::vector< Model::Wall* > walls = world->getWalls( wxRect( 500, -5, 10, 10));
+	BOOST_REQUIRE_EQUAL( walls.size(), 1U);
+	BOOST_CHECK( walls[0] == horizontal.get());
+
+	walls = world->getWalls( wxRect( 1995, 500, 10, 10));
+	BOOST_REQUIRE_EQUAL( walls.size(), 1U);
+	BOOST_CHECK( walls[0] == vertical.get());
+
+	BOOST_CHECK( world->getWalls( wxRect( 500, 500, 10, 10)).empty());
+	BOOST_CHECK_EQUAL( world->getWalls( wxRect( -10, -10, 3000, 3000)).size(), 2U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,182 @@
+#include "Config.hpp"
+
+#include "Goal.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Wall.hpp"
+#include "WayPoint.hpp"
+#include "WorldBuilder.hpp"
+#include "WorldFixture.hpp"
+#include "WorldTextFile.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	/**
+	 * Writes the text of a world to a temporary file and reads it back with WorldTextFile::read
+	 */
+	struct WorldTextFileFixture : public WorldFixture
+	{
+			WorldTextFileFixture() :
+								fileName( (std::filesystem::temp_directory_path() / "robotworld-test.txt").string())
+			{
+			}
+			~WorldTextFileFixture()
+			{
+				worldBuilder.clear();
+				std::filesystem::remove( fileName);
+			}
+			/**
+			 *
+			 */
+			void write( const std::string& aText) const
+			{
+				std::ofstream stream( fileName, std::ios::binary | std::ios::trunc);
+				stream << aText;
+			}
+			/**
+			 *
+			 */
+			void read(	const std::string& aText,
+						const Model::RobotPtr& aLocalRobot = nullptr)
+			{
+				write( aText);
+				int fileDescriptor = ::open( fileName.c_str(), O_RDONLY);
+				BOOST_REQUIRE( fileDescriptor >= 0);
+				try
+				{
+					Model::WorldTextFile::read( fileDescriptor, worldBuilder, aLocalRobot);
+				}
+				catch (...)
+				{
+					::close( fileDescriptor);
+					throw;
+				}
+				::close( fileDescriptor);
+			}
+			/**
+			 *
+			 * @return true if reading aText fails with a message that starts with aMessage
+			 */
+			bool readFails(	const std::string& aText,
+							const std::string& aMessage)
+			{
+				try
+				{
+					read( aText);
+				}
+				catch (std::runtime_error& e)
+				{
+					BOOST_TEST_MESSAGE( e.what());
+					return std::string( e.what()).compare( 0, aMessage.size(), aMessage) == 0;
+				}
+				return false;
+			}
+
+			std::string fileName;
+			Model::WorldBuilder worldBuilder;
+	};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE( WorldTextFileTest, WorldTextFileFixture)
+
+BOOST_AUTO_TEST_CASE( ReadAllObjects)
+{
+	read(	"# A comment\n"
+			"\n"
+			"robot 10 20 Robot 1\n"
+			"waypoint\t30\t40\tWayPoint  \r\n"
+			"goal -50 60 Goal\n"
+			"  wall 0 0 100 0\n"
+			"wall 100 0 100 100");
+
+	BOOST_REQUIRE_EQUAL( worldBuilder.getRobots().size(), 1U);
+	BOOST_CHECK_EQUAL( worldBuilder.getRobots()[0]->getName(), "Robot 1");
+	BOOST_CHECK( worldBuilder.getRobots()[0]->getPosition() == wxPoint( 10, 20));
+	BOOST_REQUIRE_EQUAL( worldBuilder.getWayPoints().size(), 1U);
+	BOOST_CHECK_EQUAL( worldBuilder.getWayPoints()[0]->getName(), "WayPoint");
+	BOOST_CHECK( worldBuilder.getWayPoints()[0]->getPosition() == wxPoint( 30, 40));
+	BOOST_REQUIRE_EQUAL( worldBuilder.getGoals().size(), 1U);
+	BOOST_CHECK( worldBuilder.getGoals()[0]->getPosition() == wxPoint( -50, 60));
+	BOOST_REQUIRE_EQUAL( worldBuilder.getWalls().size(), 2U);
+	BOOST_CHECK( worldBuilder.getWalls()[1]->getPoint1() == wxPoint( 100, 0));
+	BOOST_CHECK( worldBuilder.getWalls()[1]->getPoint2() == wxPoint( 100, 100));
+}
+
+BOOST_AUTO_TEST_CASE( ReadLocalRobot)
+{
+	Model::RobotPtr localRobot = robotWorld.getLocalRobot();
+	localRobot->setPosition( wxPoint( 1, 2), false);
+	read( "robot 70 80 " + localRobot->getName() + "\nrobot 10 20 Other\n", localRobot);
+
+	BOOST_REQUIRE_EQUAL( worldBuilder.getRobots().size(), 1U);
+	BOOST_CHECK_EQUAL( worldBuilder.getRobots()[0]->getName(), "Other");
+	// The local robot only moves at commit
+	BOOST_CHECK( localRobot->getPosition() == wxPoint( 1, 2));
+	worldBuilder.commit( false);
+	BOOST_CHECK( localRobot->getPosition() == wxPoint( 70, 80));
+}
+
+BOOST_AUTO_TEST_CASE( MalformedLines)
+{
+	BOOST_CHECK( readFails( "robot 1 2 Robot\nrobots 1 2 Robot\n", "Line 2: unknown object robots"));
+	BOOST_CHECK( readFails( "wall 1 2 3\n", "Line 1: a number was expected"));
+	BOOST_CHECK( readFails( "wall 1 2 x 4\n", "Line 1: a number was expected"));
+	BOOST_CHECK( readFails( "wall 1 2 3 4x\n", "Line 1: a number was expected"));
+	BOOST_CHECK( readFails( "wall 1 2 3 99999999999\n", "Line 1: a number was expected"));
+	BOOST_CHECK( readFails( "wall 1 2 3 4 5\n", "Line 1: unexpected text at the end of the line"));
+	BOOST_CHECK( readFails( "# comment\n\ngoal 1 2   \n", "Line 3: a name was expected"));
+	BOOST_CHECK( readFails( "waypoint 1\n", "Line 1: a number was expected"));
+}
+
+BOOST_AUTO_TEST_CASE( LineTooLong)
+{
+	BOOST_CHECK( readFails( "robot 1 2 Robot\nrobot 1 2 " + std::string( 64 * 1024, 'x') + "\n", "Line 2: the line is too long"));
+}
+
+BOOST_AUTO_TEST_CASE( RoundTrip)
+{
+	robotWorld.newRobot( "Robot", wxPoint( 10, 20), false);
+	robotWorld.newWayPoint( "WayPoint", wxPoint( 30, 40), false);
+	robotWorld.newGoal( "Goal", wxPoint( 50, 60), false);
+	robotWorld.newWall( wxPoint( 0, 0), wxPoint( 100, 0), false);
+	Model::WorldTextFile::save( fileName);
+
+	Model::WorldSnapshotPtr before = robotWorld.getSnapshot();
+	Model::WorldTextFile::load( fileName, false);
+
+	// The old world is replaced without an empty version in between
+	Model::WorldSnapshotPtr world = robotWorld.getSnapshot();
+	BOOST_CHECK_EQUAL( world->version, before->version + 1);
+	BOOST_CHECK( world->getRobot( "Robot") != before->getRobot( "Robot"));
+	BOOST_REQUIRE( world->getRobot( "Robot"));
+	BOOST_CHECK( world->getRobot( "Robot")->getPosition() == wxPoint( 10, 20));
+	BOOST_REQUIRE( world->getWayPoint( "WayPoint"));
+	BOOST_CHECK( world->getWayPoint( "WayPoint")->getPosition() == wxPoint( 30, 40));
+	BOOST_REQUIRE( world->getGoal( "Goal"));
+	BOOST_CHECK( world->getGoal( "Goal")->getPosition() == wxPoint( 50, 60));
+	BOOST_REQUIRE_EQUAL( world->walls->size(), 1U);
+	BOOST_CHECK( (*world->walls)[0]->getPoint2() == wxPoint( 100, 0));
+}
+
+BOOST_AUTO_TEST_CASE( InvalidFileKeepsWorld)
+{
+	robotWorld.newWall( wxPoint( 0, 0), wxPoint( 100, 0), false);
+
+	write( "wall 1 2 3 4\nwall 1 2\n");
+	BOOST_CHECK_THROW( Model::WorldTextFile::load( fileName, false), std::runtime_error);
+	BOOST_REQUIRE_EQUAL( robotWorld.getSnapshot()->walls->size(), 1U);
+	BOOST_CHECK( (*robotWorld.getSnapshot()->walls)[0]->getPoint2() == wxPoint( 100, 0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()